@@ -10,9 +10,27 @@
 #include "leptjsonWrapper.hpp"
 #include <cassert>  /* assert() */
 #include <cstdlib>  /* NULL, strtod() */
-#include <cerrno>   /* errno */
+#include <cstdint>  /* uint64_t, UINT64_C() */
+#include <cstring>  /* memcpy() */
+#include <cmath>    /* HUGE_VAL, fabs() */
+#include <clocale>  /* localeconv() */
 #include <string_view>
 #include <string>
+#include <array>
+
+#if !defined(LEPT_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LEPT_SSE2
+#include <emmintrin.h> /* _mm_loadu_si128(), _mm_cmpeq_epi8(), _mm_movemask_epi8() */
+#endif
+#if defined(__AVX2__)
+#define LEPT_AVX2
+#include <immintrin.h> /* _mm256_loadu_si256(), _mm256_cmpeq_epi8(), _mm256_movemask_epi8() */
+#endif
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>    /* _BitScanForward(), _BitScanReverse64(), _umul128() */
+#endif
 
 namespace leptjson
 {
@@ -20,14 +38,42 @@ namespace leptjson
 #define LEPT_PARSE_STACK_INIT_SIZE 256
 #endif
 
-#define EXPECT(c, ch)       do { assert(*c->json == (ch)); c->json++; } while(0)
-#define ISDIGIT(ch)         ((ch) >= '0' && (ch) <= '9')
-#define ISDIGIT1TO9(ch)     ((ch) >= '1' && (ch) <= '9')
+#define EXPECT(c, ch)       do { assert(c->json != c->end && *c->json == (ch)); c->json++; } while(0)
+#define PEEK(c)             ((c)->json != (c)->end ? *(c)->json : '\0')
+#define ISDIGIT(ch)         (lept_char_class[static_cast<unsigned char>(ch)] & LEPT_CHAR_DIGIT)
+#define ISDIGIT1TO9(ch)     ((ch) != '0' && ISDIGIT(ch))
+#define ISWHITESPACE(ch)    (lept_char_class[static_cast<unsigned char>(ch)] & LEPT_CHAR_WHITESPACE)
+#define ISSTRINGSTOP(ch)    (lept_char_class[static_cast<unsigned char>(ch)] & LEPT_CHAR_STRING_STOP)
+
+    /* The scanners classify a byte with one table lookup instead of a chain of comparisons. */
+    enum : unsigned char {
+        LEPT_CHAR_WHITESPACE  = 0x01, /* ' ', '\t', '\n', '\r' */
+        LEPT_CHAR_DIGIT       = 0x02, /* '0' to '9' */
+        LEPT_CHAR_STRING_STOP = 0x04  /* '\"', '\\' and control characters, which end a run of verbatim string bytes */
+    };
+
+    static constexpr std::array<unsigned char, 256> lept_make_char_class() {
+        std::array<unsigned char, 256> t{};
+        for (int ch = 0; ch < 0x20; ++ch)
+            t[ch] = LEPT_CHAR_STRING_STOP;
+        t['\"'] = t['\\'] = LEPT_CHAR_STRING_STOP;
+        t[' '] |= LEPT_CHAR_WHITESPACE;
+        t['\t'] |= LEPT_CHAR_WHITESPACE;
+        t['\n'] |= LEPT_CHAR_WHITESPACE;
+        t['\r'] |= LEPT_CHAR_WHITESPACE;
+        for (int ch = '0'; ch <= '9'; ++ch)
+            t[ch] = LEPT_CHAR_DIGIT;
+        return t;
+    }
+
+    static constexpr std::array<unsigned char, 256> lept_char_class = lept_make_char_class();
 
     struct lept_context
     {
         /* Current parsing position of json string. */
         const char* json;
+        /* One past the last character of json string. */
+        const char* end;
 
         /* Stack */
         char *stack;
@@ -75,66 +121,996 @@ namespace leptjson
         return c->stack + (c->top -= size);
     }
 
+#if defined(LEPT_AVX2)
+#define LEPT_SIMD_WIDTH 32
+#elif defined(LEPT_SSE2)
+#define LEPT_SIMD_WIDTH 16
+#endif
+
+#ifdef LEPT_SIMD_WIDTH
+
+    /**
+     * @brief Index of the lowest set bit in |m|.
+     * @note Note that |m| should be non-zero.
+     */
+    static unsigned lept_ctz(unsigned m) {
+#if defined(_MSC_VER)
+        unsigned long i;
+        _BitScanForward(&i, m);
+        return static_cast<unsigned>(i);
+#else
+        return static_cast<unsigned>(__builtin_ctz(m));
+#endif
+    }
+
+    /**
+     * @brief Skip whitespace in blocks of LEPT_SIMD_WIDTH bytes.
+     * @note Note that whole blocks are classified while they fit before |end|,
+     * the tail is done byte by byte.
+     * @param[in] p current parsing position
+     * @param[in] end one past the last character of json string
+     * @return Return pointer to the first non-whitespace character, or |end|.
+     */
+    static const char* lept_skip_whitespace_simd(const char* p, const char* end) {
+        /* Most calls see zero or one whitespace, do not pay for the setup. */
+        if (p == end || !ISWHITESPACE(*p))
+            return p;
+        ++p;
+#if defined(LEPT_AVX2)
+        const __m256i sp = _mm256_set1_epi8(' ');
+        const __m256i nl = _mm256_set1_epi8('\n');
+        const __m256i cr = _mm256_set1_epi8('\r');
+        const __m256i ht = _mm256_set1_epi8('\t');
+        for (; end - p >= 32; p += 32) {
+            const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            __m256i x = _mm256_cmpeq_epi8(s, sp);
+            x = _mm256_or_si256(x, _mm256_cmpeq_epi8(s, nl));
+            x = _mm256_or_si256(x, _mm256_cmpeq_epi8(s, cr));
+            x = _mm256_or_si256(x, _mm256_cmpeq_epi8(s, ht));
+            unsigned r = ~static_cast<unsigned>(_mm256_movemask_epi8(x));
+            if (r != 0)
+                return p + lept_ctz(r);
+        }
+#else
+        const __m128i sp = _mm_set1_epi8(' ');
+        const __m128i nl = _mm_set1_epi8('\n');
+        const __m128i cr = _mm_set1_epi8('\r');
+        const __m128i ht = _mm_set1_epi8('\t');
+        for (; end - p >= 16; p += 16) {
+            const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            __m128i x = _mm_cmpeq_epi8(s, sp);
+            x = _mm_or_si128(x, _mm_cmpeq_epi8(s, nl));
+            x = _mm_or_si128(x, _mm_cmpeq_epi8(s, cr));
+            x = _mm_or_si128(x, _mm_cmpeq_epi8(s, ht));
+            unsigned r = ~static_cast<unsigned>(_mm_movemask_epi8(x)) & 0xFFFF;
+            if (r != 0)
+                return p + lept_ctz(r);
+        }
+#endif
+        while (p != end && ISWHITESPACE(*p))
+            ++p;
+        return p;
+    }
+#endif
+
     static void lept_parse_whitespace(lept_context* c) {
+#ifdef LEPT_SIMD_WIDTH
+        c->json = lept_skip_whitespace_simd(c->json, c->end);
+#else
         const char *p = c->json;
-        while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')
+        while (p != c->end && ISWHITESPACE(*p))
             p++;
         c->json = p;
+#endif
     }
 
 
+    /**
+     * @brief Parse the literal at |c|, whose first character the dispatch has matched.
+     * @note Note that the last four characters ("true", "null", "alse") are one
+     * 32-bit compare, the load of the constant literal folds into an immediate.
+     */
     static ELEPT_PARSE_ECODE lept_parse_literal(lept_context* c, Lept_value* v, std::string_view literal, ELeptType type) {
-        assert(*c->json == literal[0]);
-        for (const auto& lit : literal)
-        {
-            if (*(c->json)++ != lit)
-                return ELEPT_PARSE_ECODE::LEPT_PARSE_INVALID_VALUE;
-        }
+        uint32_t a, b;
+        assert(literal.size() == 4 || literal.size() == 5);
+        assert(c->json != c->end && *c->json == literal[0]);
+        if (static_cast<size_t>(c->end - c->json) < literal.size())
+            return ELEPT_PARSE_ECODE::LEPT_PARSE_INVALID_VALUE;
+        memcpy(&a, c->json + literal.size() - 4, sizeof(a));
+        memcpy(&b, literal.data() + literal.size() - 4, sizeof(b));
+        if (a != b)
+            return ELEPT_PARSE_ECODE::LEPT_PARSE_INVALID_VALUE;
+        c->json += literal.size();
         v->type = type;
         return ELEPT_PARSE_ECODE::LEPT_PARSE_OK;
     }
 
+    /*
+     * Numbers are converted while their grammar is validated: digits are folded into
+     * a 64-bit significand (8 at a time when possible) and the result is rounded with
+     * the Eisel-Lemire algorithm. Only the rare inputs it cannot decide are handed to
+     * strtod(), with the decimal point adjusted to the C locale.
+     */
+    static constexpr long LEPT_POW5_MIN_EXP = -342;
+    static constexpr long LEPT_POW5_MAX_EXP = 308;
+
+    /* 128-bit approximations of 5^q for q in [LEPT_POW5_MIN_EXP, LEPT_POW5_MAX_EXP], normalized to the top bit. */
+    static const uint64_t lept_pow5_128[] = {
+        UINT64_C(0xEEF453D6923BD65A), UINT64_C(0x113FAA2906A13B3F), /* 5^-342 */
+        UINT64_C(0x9558B4661B6565F8), UINT64_C(0x4AC7CA59A424C507), /* 5^-341 */
+        UINT64_C(0xBAAEE17FA23EBF76), UINT64_C(0x5D79BCF00D2DF649), /* 5^-340 */
+        UINT64_C(0xE95A99DF8ACE6F53), UINT64_C(0xF4D82C2C107973DC), /* 5^-339 */
+        UINT64_C(0x91D8A02BB6C10594), UINT64_C(0x79071B9B8A4BE869), /* 5^-338 */
+        UINT64_C(0xB64EC836A47146F9), UINT64_C(0x9748E2826CDEE284), /* 5^-337 */
+        UINT64_C(0xE3E27A444D8D98B7), UINT64_C(0xFD1B1B2308169B25), /* 5^-336 */
+        UINT64_C(0x8E6D8C6AB0787F72), UINT64_C(0xFE30F0F5E50E20F7), /* 5^-335 */
+        UINT64_C(0xB208EF855C969F4F), UINT64_C(0xBDBD2D335E51A935), /* 5^-334 */
+        UINT64_C(0xDE8B2B66B3BC4723), UINT64_C(0xAD2C788035E61382), /* 5^-333 */
+        UINT64_C(0x8B16FB203055AC76), UINT64_C(0x4C3BCB5021AFCC31), /* 5^-332 */
+        UINT64_C(0xADDCB9E83C6B1793), UINT64_C(0xDF4ABE242A1BBF3D), /* 5^-331 */
+        UINT64_C(0xD953E8624B85DD78), UINT64_C(0xD71D6DAD34A2AF0D), /* 5^-330 */
+        UINT64_C(0x87D4713D6F33AA6B), UINT64_C(0x8672648C40E5AD68), /* 5^-329 */
+        UINT64_C(0xA9C98D8CCB009506), UINT64_C(0x680EFDAF511F18C2), /* 5^-328 */
+        UINT64_C(0xD43BF0EFFDC0BA48), UINT64_C(0x0212BD1B2566DEF2), /* 5^-327 */
+        UINT64_C(0x84A57695FE98746D), UINT64_C(0x014BB630F7604B57), /* 5^-326 */
+        UINT64_C(0xA5CED43B7E3E9188), UINT64_C(0x419EA3BD35385E2D), /* 5^-325 */
+        UINT64_C(0xCF42894A5DCE35EA), UINT64_C(0x52064CAC828675B9), /* 5^-324 */
+        UINT64_C(0x818995CE7AA0E1B2), UINT64_C(0x7343EFEBD1940993), /* 5^-323 */
+        UINT64_C(0xA1EBFB4219491A1F), UINT64_C(0x1014EBE6C5F90BF8), /* 5^-322 */
+        UINT64_C(0xCA66FA129F9B60A6), UINT64_C(0xD41A26E077774EF6), /* 5^-321 */
+        UINT64_C(0xFD00B897478238D0), UINT64_C(0x8920B098955522B4), /* 5^-320 */
+        UINT64_C(0x9E20735E8CB16382), UINT64_C(0x55B46E5F5D5535B0), /* 5^-319 */
+        UINT64_C(0xC5A890362FDDBC62), UINT64_C(0xEB2189F734AA831D), /* 5^-318 */
+        UINT64_C(0xF712B443BBD52B7B), UINT64_C(0xA5E9EC7501D523E4), /* 5^-317 */
+        UINT64_C(0x9A6BB0AA55653B2D), UINT64_C(0x47B233C92125366E), /* 5^-316 */
+        UINT64_C(0xC1069CD4EABE89F8), UINT64_C(0x999EC0BB696E840A), /* 5^-315 */
+        UINT64_C(0xF148440A256E2C76), UINT64_C(0xC00670EA43CA250D), /* 5^-314 */
+        UINT64_C(0x96CD2A865764DBCA), UINT64_C(0x380406926A5E5728), /* 5^-313 */
+        UINT64_C(0xBC807527ED3E12BC), UINT64_C(0xC605083704F5ECF2), /* 5^-312 */
+        UINT64_C(0xEBA09271E88D976B), UINT64_C(0xF7864A44C633682E), /* 5^-311 */
+        UINT64_C(0x93445B8731587EA3), UINT64_C(0x7AB3EE6AFBE0211D), /* 5^-310 */
+        UINT64_C(0xB8157268FDAE9E4C), UINT64_C(0x5960EA05BAD82964), /* 5^-309 */
+        UINT64_C(0xE61ACF033D1A45DF), UINT64_C(0x6FB92487298E33BD), /* 5^-308 */
+        UINT64_C(0x8FD0C16206306BAB), UINT64_C(0xA5D3B6D479F8E056), /* 5^-307 */
+        UINT64_C(0xB3C4F1BA87BC8696), UINT64_C(0x8F48A4899877186C), /* 5^-306 */
+        UINT64_C(0xE0B62E2929ABA83C), UINT64_C(0x331ACDABFE94DE87), /* 5^-305 */
+        UINT64_C(0x8C71DCD9BA0B4925), UINT64_C(0x9FF0C08B7F1D0B14), /* 5^-304 */
+        UINT64_C(0xAF8E5410288E1B6F), UINT64_C(0x07ECF0AE5EE44DD9), /* 5^-303 */
+        UINT64_C(0xDB71E91432B1A24A), UINT64_C(0xC9E82CD9F69D6150), /* 5^-302 */
+        UINT64_C(0x892731AC9FAF056E), UINT64_C(0xBE311C083A225CD2), /* 5^-301 */
+        UINT64_C(0xAB70FE17C79AC6CA), UINT64_C(0x6DBD630A48AAF406), /* 5^-300 */
+        UINT64_C(0xD64D3D9DB981787D), UINT64_C(0x092CBBCCDAD5B108), /* 5^-299 */
+        UINT64_C(0x85F0468293F0EB4E), UINT64_C(0x25BBF56008C58EA5), /* 5^-298 */
+        UINT64_C(0xA76C582338ED2621), UINT64_C(0xAF2AF2B80AF6F24E), /* 5^-297 */
+        UINT64_C(0xD1476E2C07286FAA), UINT64_C(0x1AF5AF660DB4AEE1), /* 5^-296 */
+        UINT64_C(0x82CCA4DB847945CA), UINT64_C(0x50D98D9FC890ED4D), /* 5^-295 */
+        UINT64_C(0xA37FCE126597973C), UINT64_C(0xE50FF107BAB528A0), /* 5^-294 */
+        UINT64_C(0xCC5FC196FEFD7D0C), UINT64_C(0x1E53ED49A96272C8), /* 5^-293 */
+        UINT64_C(0xFF77B1FCBEBCDC4F), UINT64_C(0x25E8E89C13BB0F7A), /* 5^-292 */
+        UINT64_C(0x9FAACF3DF73609B1), UINT64_C(0x77B191618C54E9AC), /* 5^-291 */
+        UINT64_C(0xC795830D75038C1D), UINT64_C(0xD59DF5B9EF6A2417), /* 5^-290 */
+        UINT64_C(0xF97AE3D0D2446F25), UINT64_C(0x4B0573286B44AD1D), /* 5^-289 */
+        UINT64_C(0x9BECCE62836AC577), UINT64_C(0x4EE367F9430AEC32), /* 5^-288 */
+        UINT64_C(0xC2E801FB244576D5), UINT64_C(0x229C41F793CDA73F), /* 5^-287 */
+        UINT64_C(0xF3A20279ED56D48A), UINT64_C(0x6B43527578C1110F), /* 5^-286 */
+        UINT64_C(0x9845418C345644D6), UINT64_C(0x830A13896B78AAA9), /* 5^-285 */
+        UINT64_C(0xBE5691EF416BD60C), UINT64_C(0x23CC986BC656D553), /* 5^-284 */
+        UINT64_C(0xEDEC366B11C6CB8F), UINT64_C(0x2CBFBE86B7EC8AA8), /* 5^-283 */
+        UINT64_C(0x94B3A202EB1C3F39), UINT64_C(0x7BF7D71432F3D6A9), /* 5^-282 */
+        UINT64_C(0xB9E08A83A5E34F07), UINT64_C(0xDAF5CCD93FB0CC53), /* 5^-281 */
+        UINT64_C(0xE858AD248F5C22C9), UINT64_C(0xD1B3400F8F9CFF68), /* 5^-280 */
+        UINT64_C(0x91376C36D99995BE), UINT64_C(0x23100809B9C21FA1), /* 5^-279 */
+        UINT64_C(0xB58547448FFFFB2D), UINT64_C(0xABD40A0C2832A78A), /* 5^-278 */
+        UINT64_C(0xE2E69915B3FFF9F9), UINT64_C(0x16C90C8F323F516C), /* 5^-277 */
+        UINT64_C(0x8DD01FAD907FFC3B), UINT64_C(0xAE3DA7D97F6792E3), /* 5^-276 */
+        UINT64_C(0xB1442798F49FFB4A), UINT64_C(0x99CD11CFDF41779C), /* 5^-275 */
+        UINT64_C(0xDD95317F31C7FA1D), UINT64_C(0x40405643D711D583), /* 5^-274 */
+        UINT64_C(0x8A7D3EEF7F1CFC52), UINT64_C(0x482835EA666B2572), /* 5^-273 */
+        UINT64_C(0xAD1C8EAB5EE43B66), UINT64_C(0xDA3243650005EECF), /* 5^-272 */
+        UINT64_C(0xD863B256369D4A40), UINT64_C(0x90BED43E40076A82), /* 5^-271 */
+        UINT64_C(0x873E4F75E2224E68), UINT64_C(0x5A7744A6E804A291), /* 5^-270 */
+        UINT64_C(0xA90DE3535AAAE202), UINT64_C(0x711515D0A205CB36), /* 5^-269 */
+        UINT64_C(0xD3515C2831559A83), UINT64_C(0x0D5A5B44CA873E03), /* 5^-268 */
+        UINT64_C(0x8412D9991ED58091), UINT64_C(0xE858790AFE9486C2), /* 5^-267 */
+        UINT64_C(0xA5178FFF668AE0B6), UINT64_C(0x626E974DBE39A872), /* 5^-266 */
+        UINT64_C(0xCE5D73FF402D98E3), UINT64_C(0xFB0A3D212DC8128F), /* 5^-265 */
+        UINT64_C(0x80FA687F881C7F8E), UINT64_C(0x7CE66634BC9D0B99), /* 5^-264 */
+        UINT64_C(0xA139029F6A239F72), UINT64_C(0x1C1FFFC1EBC44E80), /* 5^-263 */
+        UINT64_C(0xC987434744AC874E), UINT64_C(0xA327FFB266B56220), /* 5^-262 */
+        UINT64_C(0xFBE9141915D7A922), UINT64_C(0x4BF1FF9F0062BAA8), /* 5^-261 */
+        UINT64_C(0x9D71AC8FADA6C9B5), UINT64_C(0x6F773FC3603DB4A9), /* 5^-260 */
+        UINT64_C(0xC4CE17B399107C22), UINT64_C(0xCB550FB4384D21D3), /* 5^-259 */
+        UINT64_C(0xF6019DA07F549B2B), UINT64_C(0x7E2A53A146606A48), /* 5^-258 */
+        UINT64_C(0x99C102844F94E0FB), UINT64_C(0x2EDA7444CBFC426D), /* 5^-257 */
+        UINT64_C(0xC0314325637A1939), UINT64_C(0xFA911155FEFB5308), /* 5^-256 */
+        UINT64_C(0xF03D93EEBC589F88), UINT64_C(0x793555AB7EBA27CA), /* 5^-255 */
+        UINT64_C(0x96267C7535B763B5), UINT64_C(0x4BC1558B2F3458DE), /* 5^-254 */
+        UINT64_C(0xBBB01B9283253CA2), UINT64_C(0x9EB1AAEDFB016F16), /* 5^-253 */
+        UINT64_C(0xEA9C227723EE8BCB), UINT64_C(0x465E15A979C1CADC), /* 5^-252 */
+        UINT64_C(0x92A1958A7675175F), UINT64_C(0x0BFACD89EC191EC9), /* 5^-251 */
+        UINT64_C(0xB749FAED14125D36), UINT64_C(0xCEF980EC671F667B), /* 5^-250 */
+        UINT64_C(0xE51C79A85916F484), UINT64_C(0x82B7E12780E7401A), /* 5^-249 */
+        UINT64_C(0x8F31CC0937AE58D2), UINT64_C(0xD1B2ECB8B0908810), /* 5^-248 */
+        UINT64_C(0xB2FE3F0B8599EF07), UINT64_C(0x861FA7E6DCB4AA15), /* 5^-247 */
+        UINT64_C(0xDFBDCECE67006AC9), UINT64_C(0x67A791E093E1D49A), /* 5^-246 */
+        UINT64_C(0x8BD6A141006042BD), UINT64_C(0xE0C8BB2C5C6D24E0), /* 5^-245 */
+        UINT64_C(0xAECC49914078536D), UINT64_C(0x58FAE9F773886E18), /* 5^-244 */
+        UINT64_C(0xDA7F5BF590966848), UINT64_C(0xAF39A475506A899E), /* 5^-243 */
+        UINT64_C(0x888F99797A5E012D), UINT64_C(0x6D8406C952429603), /* 5^-242 */
+        UINT64_C(0xAAB37FD7D8F58178), UINT64_C(0xC8E5087BA6D33B83), /* 5^-241 */
+        UINT64_C(0xD5605FCDCF32E1D6), UINT64_C(0xFB1E4A9A90880A64), /* 5^-240 */
+        UINT64_C(0x855C3BE0A17FCD26), UINT64_C(0x5CF2EEA09A55067F), /* 5^-239 */
+        UINT64_C(0xA6B34AD8C9DFC06F), UINT64_C(0xF42FAA48C0EA481E), /* 5^-238 */
+        UINT64_C(0xD0601D8EFC57B08B), UINT64_C(0xF13B94DAF124DA26), /* 5^-237 */
+        UINT64_C(0x823C12795DB6CE57), UINT64_C(0x76C53D08D6B70858), /* 5^-236 */
+        UINT64_C(0xA2CB1717B52481ED), UINT64_C(0x54768C4B0C64CA6E), /* 5^-235 */
+        UINT64_C(0xCB7DDCDDA26DA268), UINT64_C(0xA9942F5DCF7DFD09), /* 5^-234 */
+        UINT64_C(0xFE5D54150B090B02), UINT64_C(0xD3F93B35435D7C4C), /* 5^-233 */
+        UINT64_C(0x9EFA548D26E5A6E1), UINT64_C(0xC47BC5014A1A6DAF), /* 5^-232 */
+        UINT64_C(0xC6B8E9B0709F109A), UINT64_C(0x359AB6419CA1091B), /* 5^-231 */
+        UINT64_C(0xF867241C8CC6D4C0), UINT64_C(0xC30163D203C94B62), /* 5^-230 */
+        UINT64_C(0x9B407691D7FC44F8), UINT64_C(0x79E0DE63425DCF1D), /* 5^-229 */
+        UINT64_C(0xC21094364DFB5636), UINT64_C(0x985915FC12F542E4), /* 5^-228 */
+        UINT64_C(0xF294B943E17A2BC4), UINT64_C(0x3E6F5B7B17B2939D), /* 5^-227 */
+        UINT64_C(0x979CF3CA6CEC5B5A), UINT64_C(0xA705992CEECF9C42), /* 5^-226 */
+        UINT64_C(0xBD8430BD08277231), UINT64_C(0x50C6FF782A838353), /* 5^-225 */
+        UINT64_C(0xECE53CEC4A314EBD), UINT64_C(0xA4F8BF5635246428), /* 5^-224 */
+        UINT64_C(0x940F4613AE5ED136), UINT64_C(0x871B7795E136BE99), /* 5^-223 */
+        UINT64_C(0xB913179899F68584), UINT64_C(0x28E2557B59846E3F), /* 5^-222 */
+        UINT64_C(0xE757DD7EC07426E5), UINT64_C(0x331AEADA2FE589CF), /* 5^-221 */
+        UINT64_C(0x9096EA6F3848984F), UINT64_C(0x3FF0D2C85DEF7621), /* 5^-220 */
+        UINT64_C(0xB4BCA50B065ABE63), UINT64_C(0x0FED077A756B53A9), /* 5^-219 */
+        UINT64_C(0xE1EBCE4DC7F16DFB), UINT64_C(0xD3E8495912C62894), /* 5^-218 */
+        UINT64_C(0x8D3360F09CF6E4BD), UINT64_C(0x64712DD7ABBBD95C), /* 5^-217 */
+        UINT64_C(0xB080392CC4349DEC), UINT64_C(0xBD8D794D96AACFB3), /* 5^-216 */
+        UINT64_C(0xDCA04777F541C567), UINT64_C(0xECF0D7A0FC5583A0), /* 5^-215 */
+        UINT64_C(0x89E42CAAF9491B60), UINT64_C(0xF41686C49DB57244), /* 5^-214 */
+        UINT64_C(0xAC5D37D5B79B6239), UINT64_C(0x311C2875C522CED5), /* 5^-213 */
+        UINT64_C(0xD77485CB25823AC7), UINT64_C(0x7D633293366B828B), /* 5^-212 */
+        UINT64_C(0x86A8D39EF77164BC), UINT64_C(0xAE5DFF9C02033197), /* 5^-211 */
+        UINT64_C(0xA8530886B54DBDEB), UINT64_C(0xD9F57F830283FDFC), /* 5^-210 */
+        UINT64_C(0xD267CAA862A12D66), UINT64_C(0xD072DF63C324FD7B), /* 5^-209 */
+        UINT64_C(0x8380DEA93DA4BC60), UINT64_C(0x4247CB9E59F71E6D), /* 5^-208 */
+        UINT64_C(0xA46116538D0DEB78), UINT64_C(0x52D9BE85F074E608), /* 5^-207 */
+        UINT64_C(0xCD795BE870516656), UINT64_C(0x67902E276C921F8B), /* 5^-206 */
+        UINT64_C(0x806BD9714632DFF6), UINT64_C(0x00BA1CD8A3DB53B6), /* 5^-205 */
+        UINT64_C(0xA086CFCD97BF97F3), UINT64_C(0x80E8A40ECCD228A4), /* 5^-204 */
+        UINT64_C(0xC8A883C0FDAF7DF0), UINT64_C(0x6122CD128006B2CD), /* 5^-203 */
+        UINT64_C(0xFAD2A4B13D1B5D6C), UINT64_C(0x796B805720085F81), /* 5^-202 */
+        UINT64_C(0x9CC3A6EEC6311A63), UINT64_C(0xCBE3303674053BB0), /* 5^-201 */
+        UINT64_C(0xC3F490AA77BD60FC), UINT64_C(0xBEDBFC4411068A9C), /* 5^-200 */
+        UINT64_C(0xF4F1B4D515ACB93B), UINT64_C(0xEE92FB5515482D44), /* 5^-199 */
+        UINT64_C(0x991711052D8BF3C5), UINT64_C(0x751BDD152D4D1C4A), /* 5^-198 */
+        UINT64_C(0xBF5CD54678EEF0B6), UINT64_C(0xD262D45A78A0635D), /* 5^-197 */
+        UINT64_C(0xEF340A98172AACE4), UINT64_C(0x86FB897116C87C34), /* 5^-196 */
+        UINT64_C(0x9580869F0E7AAC0E), UINT64_C(0xD45D35E6AE3D4DA0), /* 5^-195 */
+        UINT64_C(0xBAE0A846D2195712), UINT64_C(0x8974836059CCA109), /* 5^-194 */
+        UINT64_C(0xE998D258869FACD7), UINT64_C(0x2BD1A438703FC94B), /* 5^-193 */
+        UINT64_C(0x91FF83775423CC06), UINT64_C(0x7B6306A34627DDCF), /* 5^-192 */
+        UINT64_C(0xB67F6455292CBF08), UINT64_C(0x1A3BC84C17B1D542), /* 5^-191 */
+        UINT64_C(0xE41F3D6A7377EECA), UINT64_C(0x20CABA5F1D9E4A93), /* 5^-190 */
+        UINT64_C(0x8E938662882AF53E), UINT64_C(0x547EB47B7282EE9C), /* 5^-189 */
+        UINT64_C(0xB23867FB2A35B28D), UINT64_C(0xE99E619A4F23AA43), /* 5^-188 */
+        UINT64_C(0xDEC681F9F4C31F31), UINT64_C(0x6405FA00E2EC94D4), /* 5^-187 */
+        UINT64_C(0x8B3C113C38F9F37E), UINT64_C(0xDE83BC408DD3DD04), /* 5^-186 */
+        UINT64_C(0xAE0B158B4738705E), UINT64_C(0x9624AB50B148D445), /* 5^-185 */
+        UINT64_C(0xD98DDAEE19068C76), UINT64_C(0x3BADD624DD9B0957), /* 5^-184 */
+        UINT64_C(0x87F8A8D4CFA417C9), UINT64_C(0xE54CA5D70A80E5D6), /* 5^-183 */
+        UINT64_C(0xA9F6D30A038D1DBC), UINT64_C(0x5E9FCF4CCD211F4C), /* 5^-182 */
+        UINT64_C(0xD47487CC8470652B), UINT64_C(0x7647C3200069671F), /* 5^-181 */
+        UINT64_C(0x84C8D4DFD2C63F3B), UINT64_C(0x29ECD9F40041E073), /* 5^-180 */
+        UINT64_C(0xA5FB0A17C777CF09), UINT64_C(0xF468107100525890), /* 5^-179 */
+        UINT64_C(0xCF79CC9DB955C2CC), UINT64_C(0x7182148D4066EEB4), /* 5^-178 */
+        UINT64_C(0x81AC1FE293D599BF), UINT64_C(0xC6F14CD848405530), /* 5^-177 */
+        UINT64_C(0xA21727DB38CB002F), UINT64_C(0xB8ADA00E5A506A7C), /* 5^-176 */
+        UINT64_C(0xCA9CF1D206FDC03B), UINT64_C(0xA6D90811F0E4851C), /* 5^-175 */
+        UINT64_C(0xFD442E4688BD304A), UINT64_C(0x908F4A166D1DA663), /* 5^-174 */
+        UINT64_C(0x9E4A9CEC15763E2E), UINT64_C(0x9A598E4E043287FE), /* 5^-173 */
+        UINT64_C(0xC5DD44271AD3CDBA), UINT64_C(0x40EFF1E1853F29FD), /* 5^-172 */
+        UINT64_C(0xF7549530E188C128), UINT64_C(0xD12BEE59E68EF47C), /* 5^-171 */
+        UINT64_C(0x9A94DD3E8CF578B9), UINT64_C(0x82BB74F8301958CE), /* 5^-170 */
+        UINT64_C(0xC13A148E3032D6E7), UINT64_C(0xE36A52363C1FAF01), /* 5^-169 */
+        UINT64_C(0xF18899B1BC3F8CA1), UINT64_C(0xDC44E6C3CB279AC1), /* 5^-168 */
+        UINT64_C(0x96F5600F15A7B7E5), UINT64_C(0x29AB103A5EF8C0B9), /* 5^-167 */
+        UINT64_C(0xBCB2B812DB11A5DE), UINT64_C(0x7415D448F6B6F0E7), /* 5^-166 */
+        UINT64_C(0xEBDF661791D60F56), UINT64_C(0x111B495B3464AD21), /* 5^-165 */
+        UINT64_C(0x936B9FCEBB25C995), UINT64_C(0xCAB10DD900BEEC34), /* 5^-164 */
+        UINT64_C(0xB84687C269EF3BFB), UINT64_C(0x3D5D514F40EEA742), /* 5^-163 */
+        UINT64_C(0xE65829B3046B0AFA), UINT64_C(0x0CB4A5A3112A5112), /* 5^-162 */
+        UINT64_C(0x8FF71A0FE2C2E6DC), UINT64_C(0x47F0E785EABA72AB), /* 5^-161 */
+        UINT64_C(0xB3F4E093DB73A093), UINT64_C(0x59ED216765690F56), /* 5^-160 */
+        UINT64_C(0xE0F218B8D25088B8), UINT64_C(0x306869C13EC3532C), /* 5^-159 */
+        UINT64_C(0x8C974F7383725573), UINT64_C(0x1E414218C73A13FB), /* 5^-158 */
+        UINT64_C(0xAFBD2350644EEACF), UINT64_C(0xE5D1929EF90898FA), /* 5^-157 */
+        UINT64_C(0xDBAC6C247D62A583), UINT64_C(0xDF45F746B74ABF39), /* 5^-156 */
+        UINT64_C(0x894BC396CE5DA772), UINT64_C(0x6B8BBA8C328EB783), /* 5^-155 */
+        UINT64_C(0xAB9EB47C81F5114F), UINT64_C(0x066EA92F3F326564), /* 5^-154 */
+        UINT64_C(0xD686619BA27255A2), UINT64_C(0xC80A537B0EFEFEBD), /* 5^-153 */
+        UINT64_C(0x8613FD0145877585), UINT64_C(0xBD06742CE95F5F36), /* 5^-152 */
+        UINT64_C(0xA798FC4196E952E7), UINT64_C(0x2C48113823B73704), /* 5^-151 */
+        UINT64_C(0xD17F3B51FCA3A7A0), UINT64_C(0xF75A15862CA504C5), /* 5^-150 */
+        UINT64_C(0x82EF85133DE648C4), UINT64_C(0x9A984D73DBE722FB), /* 5^-149 */
+        UINT64_C(0xA3AB66580D5FDAF5), UINT64_C(0xC13E60D0D2E0EBBA), /* 5^-148 */
+        UINT64_C(0xCC963FEE10B7D1B3), UINT64_C(0x318DF905079926A8), /* 5^-147 */
+        UINT64_C(0xFFBBCFE994E5C61F), UINT64_C(0xFDF17746497F7052), /* 5^-146 */
+        UINT64_C(0x9FD561F1FD0F9BD3), UINT64_C(0xFEB6EA8BEDEFA633), /* 5^-145 */
+        UINT64_C(0xC7CABA6E7C5382C8), UINT64_C(0xFE64A52EE96B8FC0), /* 5^-144 */
+        UINT64_C(0xF9BD690A1B68637B), UINT64_C(0x3DFDCE7AA3C673B0), /* 5^-143 */
+        UINT64_C(0x9C1661A651213E2D), UINT64_C(0x06BEA10CA65C084E), /* 5^-142 */
+        UINT64_C(0xC31BFA0FE5698DB8), UINT64_C(0x486E494FCFF30A62), /* 5^-141 */
+        UINT64_C(0xF3E2F893DEC3F126), UINT64_C(0x5A89DBA3C3EFCCFA), /* 5^-140 */
+        UINT64_C(0x986DDB5C6B3A76B7), UINT64_C(0xF89629465A75E01C), /* 5^-139 */
+        UINT64_C(0xBE89523386091465), UINT64_C(0xF6BBB397F1135823), /* 5^-138 */
+        UINT64_C(0xEE2BA6C0678B597F), UINT64_C(0x746AA07DED582E2C), /* 5^-137 */
+        UINT64_C(0x94DB483840B717EF), UINT64_C(0xA8C2A44EB4571CDC), /* 5^-136 */
+        UINT64_C(0xBA121A4650E4DDEB), UINT64_C(0x92F34D62616CE413), /* 5^-135 */
+        UINT64_C(0xE896A0D7E51E1566), UINT64_C(0x77B020BAF9C81D17), /* 5^-134 */
+        UINT64_C(0x915E2486EF32CD60), UINT64_C(0x0ACE1474DC1D122E), /* 5^-133 */
+        UINT64_C(0xB5B5ADA8AAFF80B8), UINT64_C(0x0D819992132456BA), /* 5^-132 */
+        UINT64_C(0xE3231912D5BF60E6), UINT64_C(0x10E1FFF697ED6C69), /* 5^-131 */
+        UINT64_C(0x8DF5EFABC5979C8F), UINT64_C(0xCA8D3FFA1EF463C1), /* 5^-130 */
+        UINT64_C(0xB1736B96B6FD83B3), UINT64_C(0xBD308FF8A6B17CB2), /* 5^-129 */
+        UINT64_C(0xDDD0467C64BCE4A0), UINT64_C(0xAC7CB3F6D05DDBDE), /* 5^-128 */
+        UINT64_C(0x8AA22C0DBEF60EE4), UINT64_C(0x6BCDF07A423AA96B), /* 5^-127 */
+        UINT64_C(0xAD4AB7112EB3929D), UINT64_C(0x86C16C98D2C953C6), /* 5^-126 */
+        UINT64_C(0xD89D64D57A607744), UINT64_C(0xE871C7BF077BA8B7), /* 5^-125 */
+        UINT64_C(0x87625F056C7C4A8B), UINT64_C(0x11471CD764AD4972), /* 5^-124 */
+        UINT64_C(0xA93AF6C6C79B5D2D), UINT64_C(0xD598E40D3DD89BCF), /* 5^-123 */
+        UINT64_C(0xD389B47879823479), UINT64_C(0x4AFF1D108D4EC2C3), /* 5^-122 */
+        UINT64_C(0x843610CB4BF160CB), UINT64_C(0xCEDF722A585139BA), /* 5^-121 */
+        UINT64_C(0xA54394FE1EEDB8FE), UINT64_C(0xC2974EB4EE658828), /* 5^-120 */
+        UINT64_C(0xCE947A3DA6A9273E), UINT64_C(0x733D226229FEEA32), /* 5^-119 */
+        UINT64_C(0x811CCC668829B887), UINT64_C(0x0806357D5A3F525F), /* 5^-118 */
+        UINT64_C(0xA163FF802A3426A8), UINT64_C(0xCA07C2DCB0CF26F7), /* 5^-117 */
+        UINT64_C(0xC9BCFF6034C13052), UINT64_C(0xFC89B393DD02F0B5), /* 5^-116 */
+        UINT64_C(0xFC2C3F3841F17C67), UINT64_C(0xBBAC2078D443ACE2), /* 5^-115 */
+        UINT64_C(0x9D9BA7832936EDC0), UINT64_C(0xD54B944B84AA4C0D), /* 5^-114 */
+        UINT64_C(0xC5029163F384A931), UINT64_C(0x0A9E795E65D4DF11), /* 5^-113 */
+        UINT64_C(0xF64335BCF065D37D), UINT64_C(0x4D4617B5FF4A16D5), /* 5^-112 */
+        UINT64_C(0x99EA0196163FA42E), UINT64_C(0x504BCED1BF8E4E45), /* 5^-111 */
+        UINT64_C(0xC06481FB9BCF8D39), UINT64_C(0xE45EC2862F71E1D6), /* 5^-110 */
+        UINT64_C(0xF07DA27A82C37088), UINT64_C(0x5D767327BB4E5A4C), /* 5^-109 */
+        UINT64_C(0x964E858C91BA2655), UINT64_C(0x3A6A07F8D510F86F), /* 5^-108 */
+        UINT64_C(0xBBE226EFB628AFEA), UINT64_C(0x890489F70A55368B), /* 5^-107 */
+        UINT64_C(0xEADAB0ABA3B2DBE5), UINT64_C(0x2B45AC74CCEA842E), /* 5^-106 */
+        UINT64_C(0x92C8AE6B464FC96F), UINT64_C(0x3B0B8BC90012929D), /* 5^-105 */
+        UINT64_C(0xB77ADA0617E3BBCB), UINT64_C(0x09CE6EBB40173744), /* 5^-104 */
+        UINT64_C(0xE55990879DDCAABD), UINT64_C(0xCC420A6A101D0515), /* 5^-103 */
+        UINT64_C(0x8F57FA54C2A9EAB6), UINT64_C(0x9FA946824A12232D), /* 5^-102 */
+        UINT64_C(0xB32DF8E9F3546564), UINT64_C(0x47939822DC96ABF9), /* 5^-101 */
+        UINT64_C(0xDFF9772470297EBD), UINT64_C(0x59787E2B93BC56F7), /* 5^-100 */
+        UINT64_C(0x8BFBEA76C619EF36), UINT64_C(0x57EB4EDB3C55B65A), /* 5^-99 */
+        UINT64_C(0xAEFAE51477A06B03), UINT64_C(0xEDE622920B6B23F1), /* 5^-98 */
+        UINT64_C(0xDAB99E59958885C4), UINT64_C(0xE95FAB368E45ECED), /* 5^-97 */
+        UINT64_C(0x88B402F7FD75539B), UINT64_C(0x11DBCB0218EBB414), /* 5^-96 */
+        UINT64_C(0xAAE103B5FCD2A881), UINT64_C(0xD652BDC29F26A119), /* 5^-95 */
+        UINT64_C(0xD59944A37C0752A2), UINT64_C(0x4BE76D3346F0495F), /* 5^-94 */
+        UINT64_C(0x857FCAE62D8493A5), UINT64_C(0x6F70A4400C562DDB), /* 5^-93 */
+        UINT64_C(0xA6DFBD9FB8E5B88E), UINT64_C(0xCB4CCD500F6BB952), /* 5^-92 */
+        UINT64_C(0xD097AD07A71F26B2), UINT64_C(0x7E2000A41346A7A7), /* 5^-91 */
+        UINT64_C(0x825ECC24C873782F), UINT64_C(0x8ED400668C0C28C8), /* 5^-90 */
+        UINT64_C(0xA2F67F2DFA90563B), UINT64_C(0x728900802F0F32FA), /* 5^-89 */
+        UINT64_C(0xCBB41EF979346BCA), UINT64_C(0x4F2B40A03AD2FFB9), /* 5^-88 */
+        UINT64_C(0xFEA126B7D78186BC), UINT64_C(0xE2F610C84987BFA8), /* 5^-87 */
+        UINT64_C(0x9F24B832E6B0F436), UINT64_C(0x0DD9CA7D2DF4D7C9), /* 5^-86 */
+        UINT64_C(0xC6EDE63FA05D3143), UINT64_C(0x91503D1C79720DBB), /* 5^-85 */
+        UINT64_C(0xF8A95FCF88747D94), UINT64_C(0x75A44C6397CE912A), /* 5^-84 */
+        UINT64_C(0x9B69DBE1B548CE7C), UINT64_C(0xC986AFBE3EE11ABA), /* 5^-83 */
+        UINT64_C(0xC24452DA229B021B), UINT64_C(0xFBE85BADCE996168), /* 5^-82 */
+        UINT64_C(0xF2D56790AB41C2A2), UINT64_C(0xFAE27299423FB9C3), /* 5^-81 */
+        UINT64_C(0x97C560BA6B0919A5), UINT64_C(0xDCCD879FC967D41A), /* 5^-80 */
+        UINT64_C(0xBDB6B8E905CB600F), UINT64_C(0x5400E987BBC1C920), /* 5^-79 */
+        UINT64_C(0xED246723473E3813), UINT64_C(0x290123E9AAB23B68), /* 5^-78 */
+        UINT64_C(0x9436C0760C86E30B), UINT64_C(0xF9A0B6720AAF6521), /* 5^-77 */
+        UINT64_C(0xB94470938FA89BCE), UINT64_C(0xF808E40E8D5B3E69), /* 5^-76 */
+        UINT64_C(0xE7958CB87392C2C2), UINT64_C(0xB60B1D1230B20E04), /* 5^-75 */
+        UINT64_C(0x90BD77F3483BB9B9), UINT64_C(0xB1C6F22B5E6F48C2), /* 5^-74 */
+        UINT64_C(0xB4ECD5F01A4AA828), UINT64_C(0x1E38AEB6360B1AF3), /* 5^-73 */
+        UINT64_C(0xE2280B6C20DD5232), UINT64_C(0x25C6DA63C38DE1B0), /* 5^-72 */
+        UINT64_C(0x8D590723948A535F), UINT64_C(0x579C487E5A38AD0E), /* 5^-71 */
+        UINT64_C(0xB0AF48EC79ACE837), UINT64_C(0x2D835A9DF0C6D851), /* 5^-70 */
+        UINT64_C(0xDCDB1B2798182244), UINT64_C(0xF8E431456CF88E65), /* 5^-69 */
+        UINT64_C(0x8A08F0F8BF0F156B), UINT64_C(0x1B8E9ECB641B58FF), /* 5^-68 */
+        UINT64_C(0xAC8B2D36EED2DAC5), UINT64_C(0xE272467E3D222F3F), /* 5^-67 */
+        UINT64_C(0xD7ADF884AA879177), UINT64_C(0x5B0ED81DCC6ABB0F), /* 5^-66 */
+        UINT64_C(0x86CCBB52EA94BAEA), UINT64_C(0x98E947129FC2B4E9), /* 5^-65 */
+        UINT64_C(0xA87FEA27A539E9A5), UINT64_C(0x3F2398D747B36224), /* 5^-64 */
+        UINT64_C(0xD29FE4B18E88640E), UINT64_C(0x8EEC7F0D19A03AAD), /* 5^-63 */
+        UINT64_C(0x83A3EEEEF9153E89), UINT64_C(0x1953CF68300424AC), /* 5^-62 */
+        UINT64_C(0xA48CEAAAB75A8E2B), UINT64_C(0x5FA8C3423C052DD7), /* 5^-61 */
+        UINT64_C(0xCDB02555653131B6), UINT64_C(0x3792F412CB06794D), /* 5^-60 */
+        UINT64_C(0x808E17555F3EBF11), UINT64_C(0xE2BBD88BBEE40BD0), /* 5^-59 */
+        UINT64_C(0xA0B19D2AB70E6ED6), UINT64_C(0x5B6ACEAEAE9D0EC4), /* 5^-58 */
+        UINT64_C(0xC8DE047564D20A8B), UINT64_C(0xF245825A5A445275), /* 5^-57 */
+        UINT64_C(0xFB158592BE068D2E), UINT64_C(0xEED6E2F0F0D56712), /* 5^-56 */
+        UINT64_C(0x9CED737BB6C4183D), UINT64_C(0x55464DD69685606B), /* 5^-55 */
+        UINT64_C(0xC428D05AA4751E4C), UINT64_C(0xAA97E14C3C26B886), /* 5^-54 */
+        UINT64_C(0xF53304714D9265DF), UINT64_C(0xD53DD99F4B3066A8), /* 5^-53 */
+        UINT64_C(0x993FE2C6D07B7FAB), UINT64_C(0xE546A8038EFE4029), /* 5^-52 */
+        UINT64_C(0xBF8FDB78849A5F96), UINT64_C(0xDE98520472BDD033), /* 5^-51 */
+        UINT64_C(0xEF73D256A5C0F77C), UINT64_C(0x963E66858F6D4440), /* 5^-50 */
+        UINT64_C(0x95A8637627989AAD), UINT64_C(0xDDE7001379A44AA8), /* 5^-49 */
+        UINT64_C(0xBB127C53B17EC159), UINT64_C(0x5560C018580D5D52), /* 5^-48 */
+        UINT64_C(0xE9D71B689DDE71AF), UINT64_C(0xAAB8F01E6E10B4A6), /* 5^-47 */
+        UINT64_C(0x9226712162AB070D), UINT64_C(0xCAB3961304CA70E8), /* 5^-46 */
+        UINT64_C(0xB6B00D69BB55C8D1), UINT64_C(0x3D607B97C5FD0D22), /* 5^-45 */
+        UINT64_C(0xE45C10C42A2B3B05), UINT64_C(0x8CB89A7DB77C506A), /* 5^-44 */
+        UINT64_C(0x8EB98A7A9A5B04E3), UINT64_C(0x77F3608E92ADB242), /* 5^-43 */
+        UINT64_C(0xB267ED1940F1C61C), UINT64_C(0x55F038B237591ED3), /* 5^-42 */
+        UINT64_C(0xDF01E85F912E37A3), UINT64_C(0x6B6C46DEC52F6688), /* 5^-41 */
+        UINT64_C(0x8B61313BBABCE2C6), UINT64_C(0x2323AC4B3B3DA015), /* 5^-40 */
+        UINT64_C(0xAE397D8AA96C1B77), UINT64_C(0xABEC975E0A0D081A), /* 5^-39 */
+        UINT64_C(0xD9C7DCED53C72255), UINT64_C(0x96E7BD358C904A21), /* 5^-38 */
+        UINT64_C(0x881CEA14545C7575), UINT64_C(0x7E50D64177DA2E54), /* 5^-37 */
+        UINT64_C(0xAA242499697392D2), UINT64_C(0xDDE50BD1D5D0B9E9), /* 5^-36 */
+        UINT64_C(0xD4AD2DBFC3D07787), UINT64_C(0x955E4EC64B44E864), /* 5^-35 */
+        UINT64_C(0x84EC3C97DA624AB4), UINT64_C(0xBD5AF13BEF0B113E), /* 5^-34 */
+        UINT64_C(0xA6274BBDD0FADD61), UINT64_C(0xECB1AD8AEACDD58E), /* 5^-33 */
+        UINT64_C(0xCFB11EAD453994BA), UINT64_C(0x67DE18EDA5814AF2), /* 5^-32 */
+        UINT64_C(0x81CEB32C4B43FCF4), UINT64_C(0x80EACF948770CED7), /* 5^-31 */
+        UINT64_C(0xA2425FF75E14FC31), UINT64_C(0xA1258379A94D028D), /* 5^-30 */
+        UINT64_C(0xCAD2F7F5359A3B3E), UINT64_C(0x096EE45813A04330), /* 5^-29 */
+        UINT64_C(0xFD87B5F28300CA0D), UINT64_C(0x8BCA9D6E188853FC), /* 5^-28 */
+        UINT64_C(0x9E74D1B791E07E48), UINT64_C(0x775EA264CF55347E), /* 5^-27 */
+        UINT64_C(0xC612062576589DDA), UINT64_C(0x95364AFE032A819E), /* 5^-26 */
+        UINT64_C(0xF79687AED3EEC551), UINT64_C(0x3A83DDBD83F52205), /* 5^-25 */
+        UINT64_C(0x9ABE14CD44753B52), UINT64_C(0xC4926A9672793543), /* 5^-24 */
+        UINT64_C(0xC16D9A0095928A27), UINT64_C(0x75B7053C0F178294), /* 5^-23 */
+        UINT64_C(0xF1C90080BAF72CB1), UINT64_C(0x5324C68B12DD6339), /* 5^-22 */
+        UINT64_C(0x971DA05074DA7BEE), UINT64_C(0xD3F6FC16EBCA5E04), /* 5^-21 */
+        UINT64_C(0xBCE5086492111AEA), UINT64_C(0x88F4BB1CA6BCF585), /* 5^-20 */
+        UINT64_C(0xEC1E4A7DB69561A5), UINT64_C(0x2B31E9E3D06C32E6), /* 5^-19 */
+        UINT64_C(0x9392EE8E921D5D07), UINT64_C(0x3AFF322E62439FD0), /* 5^-18 */
+        UINT64_C(0xB877AA3236A4B449), UINT64_C(0x09BEFEB9FAD487C3), /* 5^-17 */
+        UINT64_C(0xE69594BEC44DE15B), UINT64_C(0x4C2EBE687989A9B4), /* 5^-16 */
+        UINT64_C(0x901D7CF73AB0ACD9), UINT64_C(0x0F9D37014BF60A11), /* 5^-15 */
+        UINT64_C(0xB424DC35095CD80F), UINT64_C(0x538484C19EF38C95), /* 5^-14 */
+        UINT64_C(0xE12E13424BB40E13), UINT64_C(0x2865A5F206B06FBA), /* 5^-13 */
+        UINT64_C(0x8CBCCC096F5088CB), UINT64_C(0xF93F87B7442E45D4), /* 5^-12 */
+        UINT64_C(0xAFEBFF0BCB24AAFE), UINT64_C(0xF78F69A51539D749), /* 5^-11 */
+        UINT64_C(0xDBE6FECEBDEDD5BE), UINT64_C(0xB573440E5A884D1C), /* 5^-10 */
+        UINT64_C(0x89705F4136B4A597), UINT64_C(0x31680A88F8953031), /* 5^-9 */
+        UINT64_C(0xABCC77118461CEFC), UINT64_C(0xFDC20D2B36BA7C3E), /* 5^-8 */
+        UINT64_C(0xD6BF94D5E57A42BC), UINT64_C(0x3D32907604691B4D), /* 5^-7 */
+        UINT64_C(0x8637BD05AF6C69B5), UINT64_C(0xA63F9A49C2C1B110), /* 5^-6 */
+        UINT64_C(0xA7C5AC471B478423), UINT64_C(0x0FCF80DC33721D54), /* 5^-5 */
+        UINT64_C(0xD1B71758E219652B), UINT64_C(0xD3C36113404EA4A9), /* 5^-4 */
+        UINT64_C(0x83126E978D4FDF3B), UINT64_C(0x645A1CAC083126EA), /* 5^-3 */
+        UINT64_C(0xA3D70A3D70A3D70A), UINT64_C(0x3D70A3D70A3D70A4), /* 5^-2 */
+        UINT64_C(0xCCCCCCCCCCCCCCCC), UINT64_C(0xCCCCCCCCCCCCCCCD), /* 5^-1 */
+        UINT64_C(0x8000000000000000), UINT64_C(0x0000000000000000), /* 5^0 */
+        UINT64_C(0xA000000000000000), UINT64_C(0x0000000000000000), /* 5^1 */
+        UINT64_C(0xC800000000000000), UINT64_C(0x0000000000000000), /* 5^2 */
+        UINT64_C(0xFA00000000000000), UINT64_C(0x0000000000000000), /* 5^3 */
+        UINT64_C(0x9C40000000000000), UINT64_C(0x0000000000000000), /* 5^4 */
+        UINT64_C(0xC350000000000000), UINT64_C(0x0000000000000000), /* 5^5 */
+        UINT64_C(0xF424000000000000), UINT64_C(0x0000000000000000), /* 5^6 */
+        UINT64_C(0x9896800000000000), UINT64_C(0x0000000000000000), /* 5^7 */
+        UINT64_C(0xBEBC200000000000), UINT64_C(0x0000000000000000), /* 5^8 */
+        UINT64_C(0xEE6B280000000000), UINT64_C(0x0000000000000000), /* 5^9 */
+        UINT64_C(0x9502F90000000000), UINT64_C(0x0000000000000000), /* 5^10 */
+        UINT64_C(0xBA43B74000000000), UINT64_C(0x0000000000000000), /* 5^11 */
+        UINT64_C(0xE8D4A51000000000), UINT64_C(0x0000000000000000), /* 5^12 */
+        UINT64_C(0x9184E72A00000000), UINT64_C(0x0000000000000000), /* 5^13 */
+        UINT64_C(0xB5E620F480000000), UINT64_C(0x0000000000000000), /* 5^14 */
+        UINT64_C(0xE35FA931A0000000), UINT64_C(0x0000000000000000), /* 5^15 */
+        UINT64_C(0x8E1BC9BF04000000), UINT64_C(0x0000000000000000), /* 5^16 */
+        UINT64_C(0xB1A2BC2EC5000000), UINT64_C(0x0000000000000000), /* 5^17 */
+        UINT64_C(0xDE0B6B3A76400000), UINT64_C(0x0000000000000000), /* 5^18 */
+        UINT64_C(0x8AC7230489E80000), UINT64_C(0x0000000000000000), /* 5^19 */
+        UINT64_C(0xAD78EBC5AC620000), UINT64_C(0x0000000000000000), /* 5^20 */
+        UINT64_C(0xD8D726B7177A8000), UINT64_C(0x0000000000000000), /* 5^21 */
+        UINT64_C(0x878678326EAC9000), UINT64_C(0x0000000000000000), /* 5^22 */
+        UINT64_C(0xA968163F0A57B400), UINT64_C(0x0000000000000000), /* 5^23 */
+        UINT64_C(0xD3C21BCECCEDA100), UINT64_C(0x0000000000000000), /* 5^24 */
+        UINT64_C(0x84595161401484A0), UINT64_C(0x0000000000000000), /* 5^25 */
+        UINT64_C(0xA56FA5B99019A5C8), UINT64_C(0x0000000000000000), /* 5^26 */
+        UINT64_C(0xCECB8F27F4200F3A), UINT64_C(0x0000000000000000), /* 5^27 */
+        UINT64_C(0x813F3978F8940984), UINT64_C(0x4000000000000000), /* 5^28 */
+        UINT64_C(0xA18F07D736B90BE5), UINT64_C(0x5000000000000000), /* 5^29 */
+        UINT64_C(0xC9F2C9CD04674EDE), UINT64_C(0xA400000000000000), /* 5^30 */
+        UINT64_C(0xFC6F7C4045812296), UINT64_C(0x4D00000000000000), /* 5^31 */
+        UINT64_C(0x9DC5ADA82B70B59D), UINT64_C(0xF020000000000000), /* 5^32 */
+        UINT64_C(0xC5371912364CE305), UINT64_C(0x6C28000000000000), /* 5^33 */
+        UINT64_C(0xF684DF56C3E01BC6), UINT64_C(0xC732000000000000), /* 5^34 */
+        UINT64_C(0x9A130B963A6C115C), UINT64_C(0x3C7F400000000000), /* 5^35 */
+        UINT64_C(0xC097CE7BC90715B3), UINT64_C(0x4B9F100000000000), /* 5^36 */
+        UINT64_C(0xF0BDC21ABB48DB20), UINT64_C(0x1E86D40000000000), /* 5^37 */
+        UINT64_C(0x96769950B50D88F4), UINT64_C(0x1314448000000000), /* 5^38 */
+        UINT64_C(0xBC143FA4E250EB31), UINT64_C(0x17D955A000000000), /* 5^39 */
+        UINT64_C(0xEB194F8E1AE525FD), UINT64_C(0x5DCFAB0800000000), /* 5^40 */
+        UINT64_C(0x92EFD1B8D0CF37BE), UINT64_C(0x5AA1CAE500000000), /* 5^41 */
+        UINT64_C(0xB7ABC627050305AD), UINT64_C(0xF14A3D9E40000000), /* 5^42 */
+        UINT64_C(0xE596B7B0C643C719), UINT64_C(0x6D9CCD05D0000000), /* 5^43 */
+        UINT64_C(0x8F7E32CE7BEA5C6F), UINT64_C(0xE4820023A2000000), /* 5^44 */
+        UINT64_C(0xB35DBF821AE4F38B), UINT64_C(0xDDA2802C8A800000), /* 5^45 */
+        UINT64_C(0xE0352F62A19E306E), UINT64_C(0xD50B2037AD200000), /* 5^46 */
+        UINT64_C(0x8C213D9DA502DE45), UINT64_C(0x4526F422CC340000), /* 5^47 */
+        UINT64_C(0xAF298D050E4395D6), UINT64_C(0x9670B12B7F410000), /* 5^48 */
+        UINT64_C(0xDAF3F04651D47B4C), UINT64_C(0x3C0CDD765F114000), /* 5^49 */
+        UINT64_C(0x88D8762BF324CD0F), UINT64_C(0xA5880A69FB6AC800), /* 5^50 */
+        UINT64_C(0xAB0E93B6EFEE0053), UINT64_C(0x8EEA0D047A457A00), /* 5^51 */
+        UINT64_C(0xD5D238A4ABE98068), UINT64_C(0x72A4904598D6D880), /* 5^52 */
+        UINT64_C(0x85A36366EB71F041), UINT64_C(0x47A6DA2B7F864750), /* 5^53 */
+        UINT64_C(0xA70C3C40A64E6C51), UINT64_C(0x999090B65F67D924), /* 5^54 */
+        UINT64_C(0xD0CF4B50CFE20765), UINT64_C(0xFFF4B4E3F741CF6D), /* 5^55 */
+        UINT64_C(0x82818F1281ED449F), UINT64_C(0xBFF8F10E7A8921A4), /* 5^56 */
+        UINT64_C(0xA321F2D7226895C7), UINT64_C(0xAFF72D52192B6A0D), /* 5^57 */
+        UINT64_C(0xCBEA6F8CEB02BB39), UINT64_C(0x9BF4F8A69F764490), /* 5^58 */
+        UINT64_C(0xFEE50B7025C36A08), UINT64_C(0x02F236D04753D5B4), /* 5^59 */
+        UINT64_C(0x9F4F2726179A2245), UINT64_C(0x01D762422C946590), /* 5^60 */
+        UINT64_C(0xC722F0EF9D80AAD6), UINT64_C(0x424D3AD2B7B97EF5), /* 5^61 */
+        UINT64_C(0xF8EBAD2B84E0D58B), UINT64_C(0xD2E0898765A7DEB2), /* 5^62 */
+        UINT64_C(0x9B934C3B330C8577), UINT64_C(0x63CC55F49F88EB2F), /* 5^63 */
+        UINT64_C(0xC2781F49FFCFA6D5), UINT64_C(0x3CBF6B71C76B25FB), /* 5^64 */
+        UINT64_C(0xF316271C7FC3908A), UINT64_C(0x8BEF464E3945EF7A), /* 5^65 */
+        UINT64_C(0x97EDD871CFDA3A56), UINT64_C(0x97758BF0E3CBB5AC), /* 5^66 */
+        UINT64_C(0xBDE94E8E43D0C8EC), UINT64_C(0x3D52EEED1CBEA317), /* 5^67 */
+        UINT64_C(0xED63A231D4C4FB27), UINT64_C(0x4CA7AAA863EE4BDD), /* 5^68 */
+        UINT64_C(0x945E455F24FB1CF8), UINT64_C(0x8FE8CAA93E74EF6A), /* 5^69 */
+        UINT64_C(0xB975D6B6EE39E436), UINT64_C(0xB3E2FD538E122B44), /* 5^70 */
+        UINT64_C(0xE7D34C64A9C85D44), UINT64_C(0x60DBBCA87196B616), /* 5^71 */
+        UINT64_C(0x90E40FBEEA1D3A4A), UINT64_C(0xBC8955E946FE31CD), /* 5^72 */
+        UINT64_C(0xB51D13AEA4A488DD), UINT64_C(0x6BABAB6398BDBE41), /* 5^73 */
+        UINT64_C(0xE264589A4DCDAB14), UINT64_C(0xC696963C7EED2DD1), /* 5^74 */
+        UINT64_C(0x8D7EB76070A08AEC), UINT64_C(0xFC1E1DE5CF543CA2), /* 5^75 */
+        UINT64_C(0xB0DE65388CC8ADA8), UINT64_C(0x3B25A55F43294BCB), /* 5^76 */
+        UINT64_C(0xDD15FE86AFFAD912), UINT64_C(0x49EF0EB713F39EBE), /* 5^77 */
+        UINT64_C(0x8A2DBF142DFCC7AB), UINT64_C(0x6E3569326C784337), /* 5^78 */
+        UINT64_C(0xACB92ED9397BF996), UINT64_C(0x49C2C37F07965404), /* 5^79 */
+        UINT64_C(0xD7E77A8F87DAF7FB), UINT64_C(0xDC33745EC97BE906), /* 5^80 */
+        UINT64_C(0x86F0AC99B4E8DAFD), UINT64_C(0x69A028BB3DED71A3), /* 5^81 */
+        UINT64_C(0xA8ACD7C0222311BC), UINT64_C(0xC40832EA0D68CE0C), /* 5^82 */
+        UINT64_C(0xD2D80DB02AABD62B), UINT64_C(0xF50A3FA490C30190), /* 5^83 */
+        UINT64_C(0x83C7088E1AAB65DB), UINT64_C(0x792667C6DA79E0FA), /* 5^84 */
+        UINT64_C(0xA4B8CAB1A1563F52), UINT64_C(0x577001B891185938), /* 5^85 */
+        UINT64_C(0xCDE6FD5E09ABCF26), UINT64_C(0xED4C0226B55E6F86), /* 5^86 */
+        UINT64_C(0x80B05E5AC60B6178), UINT64_C(0x544F8158315B05B4), /* 5^87 */
+        UINT64_C(0xA0DC75F1778E39D6), UINT64_C(0x696361AE3DB1C721), /* 5^88 */
+        UINT64_C(0xC913936DD571C84C), UINT64_C(0x03BC3A19CD1E38E9), /* 5^89 */
+        UINT64_C(0xFB5878494ACE3A5F), UINT64_C(0x04AB48A04065C723), /* 5^90 */
+        UINT64_C(0x9D174B2DCEC0E47B), UINT64_C(0x62EB0D64283F9C76), /* 5^91 */
+        UINT64_C(0xC45D1DF942711D9A), UINT64_C(0x3BA5D0BD324F8394), /* 5^92 */
+        UINT64_C(0xF5746577930D6500), UINT64_C(0xCA8F44EC7EE36479), /* 5^93 */
+        UINT64_C(0x9968BF6ABBE85F20), UINT64_C(0x7E998B13CF4E1ECB), /* 5^94 */
+        UINT64_C(0xBFC2EF456AE276E8), UINT64_C(0x9E3FEDD8C321A67E), /* 5^95 */
+        UINT64_C(0xEFB3AB16C59B14A2), UINT64_C(0xC5CFE94EF3EA101E), /* 5^96 */
+        UINT64_C(0x95D04AEE3B80ECE5), UINT64_C(0xBBA1F1D158724A12), /* 5^97 */
+        UINT64_C(0xBB445DA9CA61281F), UINT64_C(0x2A8A6E45AE8EDC97), /* 5^98 */
+        UINT64_C(0xEA1575143CF97226), UINT64_C(0xF52D09D71A3293BD), /* 5^99 */
+        UINT64_C(0x924D692CA61BE758), UINT64_C(0x593C2626705F9C56), /* 5^100 */
+        UINT64_C(0xB6E0C377CFA2E12E), UINT64_C(0x6F8B2FB00C77836C), /* 5^101 */
+        UINT64_C(0xE498F455C38B997A), UINT64_C(0x0B6DFB9C0F956447), /* 5^102 */
+        UINT64_C(0x8EDF98B59A373FEC), UINT64_C(0x4724BD4189BD5EAC), /* 5^103 */
+        UINT64_C(0xB2977EE300C50FE7), UINT64_C(0x58EDEC91EC2CB657), /* 5^104 */
+        UINT64_C(0xDF3D5E9BC0F653E1), UINT64_C(0x2F2967B66737E3ED), /* 5^105 */
+        UINT64_C(0x8B865B215899F46C), UINT64_C(0xBD79E0D20082EE74), /* 5^106 */
+        UINT64_C(0xAE67F1E9AEC07187), UINT64_C(0xECD8590680A3AA11), /* 5^107 */
+        UINT64_C(0xDA01EE641A708DE9), UINT64_C(0xE80E6F4820CC9495), /* 5^108 */
+        UINT64_C(0x884134FE908658B2), UINT64_C(0x3109058D147FDCDD), /* 5^109 */
+        UINT64_C(0xAA51823E34A7EEDE), UINT64_C(0xBD4B46F0599FD415), /* 5^110 */
+        UINT64_C(0xD4E5E2CDC1D1EA96), UINT64_C(0x6C9E18AC7007C91A), /* 5^111 */
+        UINT64_C(0x850FADC09923329E), UINT64_C(0x03E2CF6BC604DDB0), /* 5^112 */
+        UINT64_C(0xA6539930BF6BFF45), UINT64_C(0x84DB8346B786151C), /* 5^113 */
+        UINT64_C(0xCFE87F7CEF46FF16), UINT64_C(0xE612641865679A63), /* 5^114 */
+        UINT64_C(0x81F14FAE158C5F6E), UINT64_C(0x4FCB7E8F3F60C07E), /* 5^115 */
+        UINT64_C(0xA26DA3999AEF7749), UINT64_C(0xE3BE5E330F38F09D), /* 5^116 */
+        UINT64_C(0xCB090C8001AB551C), UINT64_C(0x5CADF5BFD3072CC5), /* 5^117 */
+        UINT64_C(0xFDCB4FA002162A63), UINT64_C(0x73D9732FC7C8F7F6), /* 5^118 */
+        UINT64_C(0x9E9F11C4014DDA7E), UINT64_C(0x2867E7FDDCDD9AFA), /* 5^119 */
+        UINT64_C(0xC646D63501A1511D), UINT64_C(0xB281E1FD541501B8), /* 5^120 */
+        UINT64_C(0xF7D88BC24209A565), UINT64_C(0x1F225A7CA91A4226), /* 5^121 */
+        UINT64_C(0x9AE757596946075F), UINT64_C(0x3375788DE9B06958), /* 5^122 */
+        UINT64_C(0xC1A12D2FC3978937), UINT64_C(0x0052D6B1641C83AE), /* 5^123 */
+        UINT64_C(0xF209787BB47D6B84), UINT64_C(0xC0678C5DBD23A49A), /* 5^124 */
+        UINT64_C(0x9745EB4D50CE6332), UINT64_C(0xF840B7BA963646E0), /* 5^125 */
+        UINT64_C(0xBD176620A501FBFF), UINT64_C(0xB650E5A93BC3D898), /* 5^126 */
+        UINT64_C(0xEC5D3FA8CE427AFF), UINT64_C(0xA3E51F138AB4CEBE), /* 5^127 */
+        UINT64_C(0x93BA47C980E98CDF), UINT64_C(0xC66F336C36B10137), /* 5^128 */
+        UINT64_C(0xB8A8D9BBE123F017), UINT64_C(0xB80B0047445D4184), /* 5^129 */
+        UINT64_C(0xE6D3102AD96CEC1D), UINT64_C(0xA60DC059157491E5), /* 5^130 */
+        UINT64_C(0x9043EA1AC7E41392), UINT64_C(0x87C89837AD68DB2F), /* 5^131 */
+        UINT64_C(0xB454E4A179DD1877), UINT64_C(0x29BABE4598C311FB), /* 5^132 */
+        UINT64_C(0xE16A1DC9D8545E94), UINT64_C(0xF4296DD6FEF3D67A), /* 5^133 */
+        UINT64_C(0x8CE2529E2734BB1D), UINT64_C(0x1899E4A65F58660C), /* 5^134 */
+        UINT64_C(0xB01AE745B101E9E4), UINT64_C(0x5EC05DCFF72E7F8F), /* 5^135 */
+        UINT64_C(0xDC21A1171D42645D), UINT64_C(0x76707543F4FA1F73), /* 5^136 */
+        UINT64_C(0x899504AE72497EBA), UINT64_C(0x6A06494A791C53A8), /* 5^137 */
+        UINT64_C(0xABFA45DA0EDBDE69), UINT64_C(0x0487DB9D17636892), /* 5^138 */
+        UINT64_C(0xD6F8D7509292D603), UINT64_C(0x45A9D2845D3C42B6), /* 5^139 */
+        UINT64_C(0x865B86925B9BC5C2), UINT64_C(0x0B8A2392BA45A9B2), /* 5^140 */
+        UINT64_C(0xA7F26836F282B732), UINT64_C(0x8E6CAC7768D7141E), /* 5^141 */
+        UINT64_C(0xD1EF0244AF2364FF), UINT64_C(0x3207D795430CD926), /* 5^142 */
+        UINT64_C(0x8335616AED761F1F), UINT64_C(0x7F44E6BD49E807B8), /* 5^143 */
+        UINT64_C(0xA402B9C5A8D3A6E7), UINT64_C(0x5F16206C9C6209A6), /* 5^144 */
+        UINT64_C(0xCD036837130890A1), UINT64_C(0x36DBA887C37A8C0F), /* 5^145 */
+        UINT64_C(0x802221226BE55A64), UINT64_C(0xC2494954DA2C9789), /* 5^146 */
+        UINT64_C(0xA02AA96B06DEB0FD), UINT64_C(0xF2DB9BAA10B7BD6C), /* 5^147 */
+        UINT64_C(0xC83553C5C8965D3D), UINT64_C(0x6F92829494E5ACC7), /* 5^148 */
+        UINT64_C(0xFA42A8B73ABBF48C), UINT64_C(0xCB772339BA1F17F9), /* 5^149 */
+        UINT64_C(0x9C69A97284B578D7), UINT64_C(0xFF2A760414536EFB), /* 5^150 */
+        UINT64_C(0xC38413CF25E2D70D), UINT64_C(0xFEF5138519684ABA), /* 5^151 */
+        UINT64_C(0xF46518C2EF5B8CD1), UINT64_C(0x7EB258665FC25D69), /* 5^152 */
+        UINT64_C(0x98BF2F79D5993802), UINT64_C(0xEF2F773FFBD97A61), /* 5^153 */
+        UINT64_C(0xBEEEFB584AFF8603), UINT64_C(0xAAFB550FFACFD8FA), /* 5^154 */
+        UINT64_C(0xEEAABA2E5DBF6784), UINT64_C(0x95BA2A53F983CF38), /* 5^155 */
+        UINT64_C(0x952AB45CFA97A0B2), UINT64_C(0xDD945A747BF26183), /* 5^156 */
+        UINT64_C(0xBA756174393D88DF), UINT64_C(0x94F971119AEEF9E4), /* 5^157 */
+        UINT64_C(0xE912B9D1478CEB17), UINT64_C(0x7A37CD5601AAB85D), /* 5^158 */
+        UINT64_C(0x91ABB422CCB812EE), UINT64_C(0xAC62E055C10AB33A), /* 5^159 */
+        UINT64_C(0xB616A12B7FE617AA), UINT64_C(0x577B986B314D6009), /* 5^160 */
+        UINT64_C(0xE39C49765FDF9D94), UINT64_C(0xED5A7E85FDA0B80B), /* 5^161 */
+        UINT64_C(0x8E41ADE9FBEBC27D), UINT64_C(0x14588F13BE847307), /* 5^162 */
+        UINT64_C(0xB1D219647AE6B31C), UINT64_C(0x596EB2D8AE258FC8), /* 5^163 */
+        UINT64_C(0xDE469FBD99A05FE3), UINT64_C(0x6FCA5F8ED9AEF3BB), /* 5^164 */
+        UINT64_C(0x8AEC23D680043BEE), UINT64_C(0x25DE7BB9480D5854), /* 5^165 */
+        UINT64_C(0xADA72CCC20054AE9), UINT64_C(0xAF561AA79A10AE6A), /* 5^166 */
+        UINT64_C(0xD910F7FF28069DA4), UINT64_C(0x1B2BA1518094DA04), /* 5^167 */
+        UINT64_C(0x87AA9AFF79042286), UINT64_C(0x90FB44D2F05D0842), /* 5^168 */
+        UINT64_C(0xA99541BF57452B28), UINT64_C(0x353A1607AC744A53), /* 5^169 */
+        UINT64_C(0xD3FA922F2D1675F2), UINT64_C(0x42889B8997915CE8), /* 5^170 */
+        UINT64_C(0x847C9B5D7C2E09B7), UINT64_C(0x69956135FEBADA11), /* 5^171 */
+        UINT64_C(0xA59BC234DB398C25), UINT64_C(0x43FAB9837E699095), /* 5^172 */
+        UINT64_C(0xCF02B2C21207EF2E), UINT64_C(0x94F967E45E03F4BB), /* 5^173 */
+        UINT64_C(0x8161AFB94B44F57D), UINT64_C(0x1D1BE0EEBAC278F5), /* 5^174 */
+        UINT64_C(0xA1BA1BA79E1632DC), UINT64_C(0x6462D92A69731732), /* 5^175 */
+        UINT64_C(0xCA28A291859BBF93), UINT64_C(0x7D7B8F7503CFDCFE), /* 5^176 */
+        UINT64_C(0xFCB2CB35E702AF78), UINT64_C(0x5CDA735244C3D43E), /* 5^177 */
+        UINT64_C(0x9DEFBF01B061ADAB), UINT64_C(0x3A0888136AFA64A7), /* 5^178 */
+        UINT64_C(0xC56BAEC21C7A1916), UINT64_C(0x088AAA1845B8FDD0), /* 5^179 */
+        UINT64_C(0xF6C69A72A3989F5B), UINT64_C(0x8AAD549E57273D45), /* 5^180 */
+        UINT64_C(0x9A3C2087A63F6399), UINT64_C(0x36AC54E2F678864B), /* 5^181 */
+        UINT64_C(0xC0CB28A98FCF3C7F), UINT64_C(0x84576A1BB416A7DD), /* 5^182 */
+        UINT64_C(0xF0FDF2D3F3C30B9F), UINT64_C(0x656D44A2A11C51D5), /* 5^183 */
+        UINT64_C(0x969EB7C47859E743), UINT64_C(0x9F644AE5A4B1B325), /* 5^184 */
+        UINT64_C(0xBC4665B596706114), UINT64_C(0x873D5D9F0DDE1FEE), /* 5^185 */
+        UINT64_C(0xEB57FF22FC0C7959), UINT64_C(0xA90CB506D155A7EA), /* 5^186 */
+        UINT64_C(0x9316FF75DD87CBD8), UINT64_C(0x09A7F12442D588F2), /* 5^187 */
+        UINT64_C(0xB7DCBF5354E9BECE), UINT64_C(0x0C11ED6D538AEB2F), /* 5^188 */
+        UINT64_C(0xE5D3EF282A242E81), UINT64_C(0x8F1668C8A86DA5FA), /* 5^189 */
+        UINT64_C(0x8FA475791A569D10), UINT64_C(0xF96E017D694487BC), /* 5^190 */
+        UINT64_C(0xB38D92D760EC4455), UINT64_C(0x37C981DCC395A9AC), /* 5^191 */
+        UINT64_C(0xE070F78D3927556A), UINT64_C(0x85BBE253F47B1417), /* 5^192 */
+        UINT64_C(0x8C469AB843B89562), UINT64_C(0x93956D7478CCEC8E), /* 5^193 */
+        UINT64_C(0xAF58416654A6BABB), UINT64_C(0x387AC8D1970027B2), /* 5^194 */
+        UINT64_C(0xDB2E51BFE9D0696A), UINT64_C(0x06997B05FCC0319E), /* 5^195 */
+        UINT64_C(0x88FCF317F22241E2), UINT64_C(0x441FECE3BDF81F03), /* 5^196 */
+        UINT64_C(0xAB3C2FDDEEAAD25A), UINT64_C(0xD527E81CAD7626C3), /* 5^197 */
+        UINT64_C(0xD60B3BD56A5586F1), UINT64_C(0x8A71E223D8D3B074), /* 5^198 */
+        UINT64_C(0x85C7056562757456), UINT64_C(0xF6872D5667844E49), /* 5^199 */
+        UINT64_C(0xA738C6BEBB12D16C), UINT64_C(0xB428F8AC016561DB), /* 5^200 */
+        UINT64_C(0xD106F86E69D785C7), UINT64_C(0xE13336D701BEBA52), /* 5^201 */
+        UINT64_C(0x82A45B450226B39C), UINT64_C(0xECC0024661173473), /* 5^202 */
+        UINT64_C(0xA34D721642B06084), UINT64_C(0x27F002D7F95D0190), /* 5^203 */
+        UINT64_C(0xCC20CE9BD35C78A5), UINT64_C(0x31EC038DF7B441F4), /* 5^204 */
+        UINT64_C(0xFF290242C83396CE), UINT64_C(0x7E67047175A15271), /* 5^205 */
+        UINT64_C(0x9F79A169BD203E41), UINT64_C(0x0F0062C6E984D386), /* 5^206 */
+        UINT64_C(0xC75809C42C684DD1), UINT64_C(0x52C07B78A3E60868), /* 5^207 */
+        UINT64_C(0xF92E0C3537826145), UINT64_C(0xA7709A56CCDF8A82), /* 5^208 */
+        UINT64_C(0x9BBCC7A142B17CCB), UINT64_C(0x88A66076400BB691), /* 5^209 */
+        UINT64_C(0xC2ABF989935DDBFE), UINT64_C(0x6ACFF893D00EA435), /* 5^210 */
+        UINT64_C(0xF356F7EBF83552FE), UINT64_C(0x0583F6B8C4124D43), /* 5^211 */
+        UINT64_C(0x98165AF37B2153DE), UINT64_C(0xC3727A337A8B704A), /* 5^212 */
+        UINT64_C(0xBE1BF1B059E9A8D6), UINT64_C(0x744F18C0592E4C5C), /* 5^213 */
+        UINT64_C(0xEDA2EE1C7064130C), UINT64_C(0x1162DEF06F79DF73), /* 5^214 */
+        UINT64_C(0x9485D4D1C63E8BE7), UINT64_C(0x8ADDCB5645AC2BA8), /* 5^215 */
+        UINT64_C(0xB9A74A0637CE2EE1), UINT64_C(0x6D953E2BD7173692), /* 5^216 */
+        UINT64_C(0xE8111C87C5C1BA99), UINT64_C(0xC8FA8DB6CCDD0437), /* 5^217 */
+        UINT64_C(0x910AB1D4DB9914A0), UINT64_C(0x1D9C9892400A22A2), /* 5^218 */
+        UINT64_C(0xB54D5E4A127F59C8), UINT64_C(0x2503BEB6D00CAB4B), /* 5^219 */
+        UINT64_C(0xE2A0B5DC971F303A), UINT64_C(0x2E44AE64840FD61D), /* 5^220 */
+        UINT64_C(0x8DA471A9DE737E24), UINT64_C(0x5CEAECFED289E5D2), /* 5^221 */
+        UINT64_C(0xB10D8E1456105DAD), UINT64_C(0x7425A83E872C5F47), /* 5^222 */
+        UINT64_C(0xDD50F1996B947518), UINT64_C(0xD12F124E28F77719), /* 5^223 */
+        UINT64_C(0x8A5296FFE33CC92F), UINT64_C(0x82BD6B70D99AAA6F), /* 5^224 */
+        UINT64_C(0xACE73CBFDC0BFB7B), UINT64_C(0x636CC64D1001550B), /* 5^225 */
+        UINT64_C(0xD8210BEFD30EFA5A), UINT64_C(0x3C47F7E05401AA4E), /* 5^226 */
+        UINT64_C(0x8714A775E3E95C78), UINT64_C(0x65ACFAEC34810A71), /* 5^227 */
+        UINT64_C(0xA8D9D1535CE3B396), UINT64_C(0x7F1839A741A14D0D), /* 5^228 */
+        UINT64_C(0xD31045A8341CA07C), UINT64_C(0x1EDE48111209A050), /* 5^229 */
+        UINT64_C(0x83EA2B892091E44D), UINT64_C(0x934AED0AAB460432), /* 5^230 */
+        UINT64_C(0xA4E4B66B68B65D60), UINT64_C(0xF81DA84D5617853F), /* 5^231 */
+        UINT64_C(0xCE1DE40642E3F4B9), UINT64_C(0x36251260AB9D668E), /* 5^232 */
+        UINT64_C(0x80D2AE83E9CE78F3), UINT64_C(0xC1D72B7C6B426019), /* 5^233 */
+        UINT64_C(0xA1075A24E4421730), UINT64_C(0xB24CF65B8612F81F), /* 5^234 */
+        UINT64_C(0xC94930AE1D529CFC), UINT64_C(0xDEE033F26797B627), /* 5^235 */
+        UINT64_C(0xFB9B7CD9A4A7443C), UINT64_C(0x169840EF017DA3B1), /* 5^236 */
+        UINT64_C(0x9D412E0806E88AA5), UINT64_C(0x8E1F289560EE864E), /* 5^237 */
+        UINT64_C(0xC491798A08A2AD4E), UINT64_C(0xF1A6F2BAB92A27E2), /* 5^238 */
+        UINT64_C(0xF5B5D7EC8ACB58A2), UINT64_C(0xAE10AF696774B1DB), /* 5^239 */
+        UINT64_C(0x9991A6F3D6BF1765), UINT64_C(0xACCA6DA1E0A8EF29), /* 5^240 */
+        UINT64_C(0xBFF610B0CC6EDD3F), UINT64_C(0x17FD090A58D32AF3), /* 5^241 */
+        UINT64_C(0xEFF394DCFF8A948E), UINT64_C(0xDDFC4B4CEF07F5B0), /* 5^242 */
+        UINT64_C(0x95F83D0A1FB69CD9), UINT64_C(0x4ABDAF101564F98E), /* 5^243 */
+        UINT64_C(0xBB764C4CA7A4440F), UINT64_C(0x9D6D1AD41ABE37F1), /* 5^244 */
+        UINT64_C(0xEA53DF5FD18D5513), UINT64_C(0x84C86189216DC5ED), /* 5^245 */
+        UINT64_C(0x92746B9BE2F8552C), UINT64_C(0x32FD3CF5B4E49BB4), /* 5^246 */
+        UINT64_C(0xB7118682DBB66A77), UINT64_C(0x3FBC8C33221DC2A1), /* 5^247 */
+        UINT64_C(0xE4D5E82392A40515), UINT64_C(0x0FABAF3FEAA5334A), /* 5^248 */
+        UINT64_C(0x8F05B1163BA6832D), UINT64_C(0x29CB4D87F2A7400E), /* 5^249 */
+        UINT64_C(0xB2C71D5BCA9023F8), UINT64_C(0x743E20E9EF511012), /* 5^250 */
+        UINT64_C(0xDF78E4B2BD342CF6), UINT64_C(0x914DA9246B255416), /* 5^251 */
+        UINT64_C(0x8BAB8EEFB6409C1A), UINT64_C(0x1AD089B6C2F7548E), /* 5^252 */
+        UINT64_C(0xAE9672ABA3D0C320), UINT64_C(0xA184AC2473B529B1), /* 5^253 */
+        UINT64_C(0xDA3C0F568CC4F3E8), UINT64_C(0xC9E5D72D90A2741E), /* 5^254 */
+        UINT64_C(0x8865899617FB1871), UINT64_C(0x7E2FA67C7A658892), /* 5^255 */
+        UINT64_C(0xAA7EEBFB9DF9DE8D), UINT64_C(0xDDBB901B98FEEAB7), /* 5^256 */
+        UINT64_C(0xD51EA6FA85785631), UINT64_C(0x552A74227F3EA565), /* 5^257 */
+        UINT64_C(0x8533285C936B35DE), UINT64_C(0xD53A88958F87275F), /* 5^258 */
+        UINT64_C(0xA67FF273B8460356), UINT64_C(0x8A892ABAF368F137), /* 5^259 */
+        UINT64_C(0xD01FEF10A657842C), UINT64_C(0x2D2B7569B0432D85), /* 5^260 */
+        UINT64_C(0x8213F56A67F6B29B), UINT64_C(0x9C3B29620E29FC73), /* 5^261 */
+        UINT64_C(0xA298F2C501F45F42), UINT64_C(0x8349F3BA91B47B8F), /* 5^262 */
+        UINT64_C(0xCB3F2F7642717713), UINT64_C(0x241C70A936219A73), /* 5^263 */
+        UINT64_C(0xFE0EFB53D30DD4D7), UINT64_C(0xED238CD383AA0110), /* 5^264 */
+        UINT64_C(0x9EC95D1463E8A506), UINT64_C(0xF4363804324A40AA), /* 5^265 */
+        UINT64_C(0xC67BB4597CE2CE48), UINT64_C(0xB143C6053EDCD0D5), /* 5^266 */
+        UINT64_C(0xF81AA16FDC1B81DA), UINT64_C(0xDD94B7868E94050A), /* 5^267 */
+        UINT64_C(0x9B10A4E5E9913128), UINT64_C(0xCA7CF2B4191C8326), /* 5^268 */
+        UINT64_C(0xC1D4CE1F63F57D72), UINT64_C(0xFD1C2F611F63A3F0), /* 5^269 */
+        UINT64_C(0xF24A01A73CF2DCCF), UINT64_C(0xBC633B39673C8CEC), /* 5^270 */
+        UINT64_C(0x976E41088617CA01), UINT64_C(0xD5BE0503E085D813), /* 5^271 */
+        UINT64_C(0xBD49D14AA79DBC82), UINT64_C(0x4B2D8644D8A74E18), /* 5^272 */
+        UINT64_C(0xEC9C459D51852BA2), UINT64_C(0xDDF8E7D60ED1219E), /* 5^273 */
+        UINT64_C(0x93E1AB8252F33B45), UINT64_C(0xCABB90E5C942B503), /* 5^274 */
+        UINT64_C(0xB8DA1662E7B00A17), UINT64_C(0x3D6A751F3B936243), /* 5^275 */
+        UINT64_C(0xE7109BFBA19C0C9D), UINT64_C(0x0CC512670A783AD4), /* 5^276 */
+        UINT64_C(0x906A617D450187E2), UINT64_C(0x27FB2B80668B24C5), /* 5^277 */
+        UINT64_C(0xB484F9DC9641E9DA), UINT64_C(0xB1F9F660802DEDF6), /* 5^278 */
+        UINT64_C(0xE1A63853BBD26451), UINT64_C(0x5E7873F8A0396973), /* 5^279 */
+        UINT64_C(0x8D07E33455637EB2), UINT64_C(0xDB0B487B6423E1E8), /* 5^280 */
+        UINT64_C(0xB049DC016ABC5E5F), UINT64_C(0x91CE1A9A3D2CDA62), /* 5^281 */
+        UINT64_C(0xDC5C5301C56B75F7), UINT64_C(0x7641A140CC7810FB), /* 5^282 */
+        UINT64_C(0x89B9B3E11B6329BA), UINT64_C(0xA9E904C87FCB0A9D), /* 5^283 */
+        UINT64_C(0xAC2820D9623BF429), UINT64_C(0x546345FA9FBDCD44), /* 5^284 */
+        UINT64_C(0xD732290FBACAF133), UINT64_C(0xA97C177947AD4095), /* 5^285 */
+        UINT64_C(0x867F59A9D4BED6C0), UINT64_C(0x49ED8EABCCCC485D), /* 5^286 */
+        UINT64_C(0xA81F301449EE8C70), UINT64_C(0x5C68F256BFFF5A74), /* 5^287 */
+        UINT64_C(0xD226FC195C6A2F8C), UINT64_C(0x73832EEC6FFF3111), /* 5^288 */
+        UINT64_C(0x83585D8FD9C25DB7), UINT64_C(0xC831FD53C5FF7EAB), /* 5^289 */
+        UINT64_C(0xA42E74F3D032F525), UINT64_C(0xBA3E7CA8B77F5E55), /* 5^290 */
+        UINT64_C(0xCD3A1230C43FB26F), UINT64_C(0x28CE1BD2E55F35EB), /* 5^291 */
+        UINT64_C(0x80444B5E7AA7CF85), UINT64_C(0x7980D163CF5B81B3), /* 5^292 */
+        UINT64_C(0xA0555E361951C366), UINT64_C(0xD7E105BCC332621F), /* 5^293 */
+        UINT64_C(0xC86AB5C39FA63440), UINT64_C(0x8DD9472BF3FEFAA7), /* 5^294 */
+        UINT64_C(0xFA856334878FC150), UINT64_C(0xB14F98F6F0FEB951), /* 5^295 */
+        UINT64_C(0x9C935E00D4B9D8D2), UINT64_C(0x6ED1BF9A569F33D3), /* 5^296 */
+        UINT64_C(0xC3B8358109E84F07), UINT64_C(0x0A862F80EC4700C8), /* 5^297 */
+        UINT64_C(0xF4A642E14C6262C8), UINT64_C(0xCD27BB612758C0FA), /* 5^298 */
+        UINT64_C(0x98E7E9CCCFBD7DBD), UINT64_C(0x8038D51CB897789C), /* 5^299 */
+        UINT64_C(0xBF21E44003ACDD2C), UINT64_C(0xE0470A63E6BD56C3), /* 5^300 */
+        UINT64_C(0xEEEA5D5004981478), UINT64_C(0x1858CCFCE06CAC74), /* 5^301 */
+        UINT64_C(0x95527A5202DF0CCB), UINT64_C(0x0F37801E0C43EBC8), /* 5^302 */
+        UINT64_C(0xBAA718E68396CFFD), UINT64_C(0xD30560258F54E6BA), /* 5^303 */
+        UINT64_C(0xE950DF20247C83FD), UINT64_C(0x47C6B82EF32A2069), /* 5^304 */
+        UINT64_C(0x91D28B7416CDD27E), UINT64_C(0x4CDC331D57FA5441), /* 5^305 */
+        UINT64_C(0xB6472E511C81471D), UINT64_C(0xE0133FE4ADF8E952), /* 5^306 */
+        UINT64_C(0xE3D8F9E563A198E5), UINT64_C(0x58180FDDD97723A6), /* 5^307 */
+        UINT64_C(0x8E679C2F5E44FF8F), UINT64_C(0x570F09EAA7EA7648), /* 5^308 */
+
+    };
+
+    static int lept_clz64(uint64_t x) {
+        assert(x != 0);
+#if defined(__GNUC__)
+        return __builtin_clzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        unsigned long i;
+        _BitScanReverse64(&i, x);
+        return 63 - static_cast<int>(i);
+#else
+        int n = 0;
+        for (; !(x & (UINT64_C(1) << 63)); x <<= 1)
+            n++;
+        return n;
+#endif
+    }
+
+    /**
+     * @brief Full 64x64 -> 128 bit multiplication.
+     * @param[out] hi high 64 bits of a * b
+     * @param[out] lo low 64 bits of a * b
+     */
+    static void lept_mul128(uint64_t a, uint64_t b, uint64_t* hi, uint64_t* lo) {
+#if defined(__SIZEOF_INT128__)
+        __extension__ typedef unsigned __int128 lept_uint128;
+        lept_uint128 r = static_cast<lept_uint128>(a) * b;
+        *hi = static_cast<uint64_t>(r >> 64);
+        *lo = static_cast<uint64_t>(r);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        *lo = _umul128(a, b, hi);
+#else
+        uint64_t a0 = a & 0xFFFFFFFF, a1 = a >> 32, b0 = b & 0xFFFFFFFF, b1 = b >> 32;
+        uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0;
+        uint64_t mid = (p00 >> 32) + (p01 & 0xFFFFFFFF) + (p10 & 0xFFFFFFFF);
+        *hi = a1 * b1 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+        *lo = (mid << 32) | (p00 & 0xFFFFFFFF);
+#endif
+    }
+
+    /**
+     * @brief Correctly rounded w * 10^q.
+     * @note Note that |w| should be non-zero.
+     * @param[out] d result
+     * @return Return false when the result cannot be decided without more digits.
+     */
+    static bool lept_eisel_lemire(uint64_t w, long q, double* d) {
+        assert(w != 0);
+        if (q < LEPT_POW5_MIN_EXP) {
+            *d = 0.0;
+            return true;
+        }
+        if (q > LEPT_POW5_MAX_EXP) {
+            *d = HUGE_VAL;
+            return true;
+        }
+        int lz = lept_clz64(w);
+        w <<= lz;
+        uint64_t hi, lo;
+        lept_mul128(w, lept_pow5_128[2 * (q - LEPT_POW5_MIN_EXP)], &hi, &lo);
+        if ((hi & 0x1FF) == 0x1FF) { /* the truncated product may be off in the bits that matter */
+            uint64_t hi2, lo2;
+            lept_mul128(w, lept_pow5_128[2 * (q - LEPT_POW5_MIN_EXP) + 1], &hi2, &lo2);
+            lo += hi2;
+            if (hi2 > lo)
+                hi++;
+            if (lo == UINT64_C(0xFFFFFFFFFFFFFFFF) && (q < -27 || q > 55))
+                return false;
+        }
+        int upperbit = static_cast<int>(hi >> 63);
+        uint64_t mantissa = hi >> (upperbit + 9);
+        long power2 = ((217706 * q) >> 16) + 63 + upperbit - lz + 1023; /* floor(q * log2(10)) + 63, biased */
+        if (power2 <= 0) { /* subnormal */
+            if (-power2 + 1 >= 64) {
+                *d = 0.0;
+                return true;
+            }
+            mantissa >>= -power2 + 1;
+            mantissa += mantissa & 1;
+            mantissa >>= 1;
+            power2 = mantissa < (UINT64_C(1) << 52) ? 0 : 1;
+        }
+        else {
+            /* exactly halfway between two doubles: round to even */
+            if (lo <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 && (mantissa << (upperbit + 9)) == hi)
+                mantissa &= ~UINT64_C(1);
+            mantissa += mantissa & 1;
+            mantissa >>= 1;
+            if (mantissa >= (UINT64_C(2) << 52)) {
+                mantissa = UINT64_C(1) << 52;
+                power2++;
+            }
+            mantissa &= ~(UINT64_C(1) << 52);
+            if (power2 >= 0x7FF) {
+                *d = HUGE_VAL;
+                return true;
+            }
+        }
+        uint64_t bits = mantissa | static_cast<uint64_t>(power2) << 52;
+        memcpy(d, &bits, sizeof(double));
+        return true;
+    }
+
+    static uint64_t lept_load8(const char* p) {
+        uint64_t x;
+        memcpy(&x, p, sizeof(x));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        x = __builtin_bswap64(x);
+#endif
+        return x;
+    }
+
+    static bool lept_is_eight_digits(uint64_t x) {
+        return (((x + UINT64_C(0x4646464646464646)) | (x - UINT64_C(0x3030303030303030))) & UINT64_C(0x8080808080808080)) == 0;
+    }
+
+    static uint64_t lept_parse_eight_digits(uint64_t x) {
+        x -= UINT64_C(0x3030303030303030);
+        x = x * 10 + (x >> 8);
+        return (((x & UINT64_C(0x000000FF000000FF)) * UINT64_C(0x000F424000000064)) +
+            (((x >> 16) & UINT64_C(0x000000FF000000FF)) * UINT64_C(0x0000271000000001))) >> 32;
+    }
+
+    /**
+     * @brief Fold a run of digits into the significand |m|, keeping at most 19
+     * significant digits in |nd|. Fraction digits scale |exp10| down when kept,
+     * integer digits scale it up when dropped.
+     * @return Return pointer past the run of digits, at most |end|.
+     */
+    static const char* lept_parse_digits(const char* p, const char* end, bool frac, uint64_t& m, int& nd, long& exp10, bool& truncated) {
+        for (;;) {
+            uint64_t x;
+            if (m != 0 && nd <= 11 && end - p >= 8 && lept_is_eight_digits(x = lept_load8(p))) {
+                m = m * 100000000 + lept_parse_eight_digits(x);
+                nd += 8;
+                if (frac)
+                    exp10 -= 8;
+                p += 8;
+                continue;
+            }
+            if (p == end || !ISDIGIT(*p))
+                return p;
+            if (nd < 19) {
+                m = m * 10 + static_cast<unsigned>(*p - '0');
+                if (m != 0)
+                    ++nd;
+                if (frac)
+                    --exp10;
+            }
+            else {
+                if (!frac)
+                    ++exp10;
+                if (*p != '0')
+                    truncated = true;
+            }
+            ++p;
+        }
+    }
+
+    /**
+     * @brief Locale-independent strtod() for the slow path.
+     */
+    static double lept_strtod(const char* s, size_t len) {
+        const char point = localeconv()->decimal_point[0];
+        std::string buf(s, len);
+        if (point != '.')
+            for (auto& ch : buf)
+                if (ch == '.')
+                    ch = point;
+        return strtod(buf.c_str(), nullptr);
+    }
+
     static ELEPT_PARSE_ECODE lept_parse_number(lept_context* c, Lept_value* v) {
-        /* validate number */
+        /* validate number and accumulate its significand and decimal exponent */
         const char *p = c->json;
-        if (*p == '-')
-            ++p;
-        if (*p == '0')
-            ++p;
-        else if (ISDIGIT1TO9(*p))
+        const char *end = c->end;
+        uint64_t m = 0;
+        long exp10 = 0;
+        int nd = 0;
+        bool truncated = false;
+        bool neg = false;
+        if (p != end && *p == '-')
         {
-            ++p; /* could be ignored */
-            while (ISDIGIT(*p))
-                ++p;
+            neg = true;
+            ++p;
         }
+        if (p != end && *p == '0')
+            ++p;
+        else if (p != end && ISDIGIT1TO9(*p))
+            p = lept_parse_digits(p, end, false, m, nd, exp10, truncated);
         else
             return ELEPT_PARSE_ECODE::LEPT_PARSE_INVALID_VALUE;
 
-        if (*p == '.')
+        if (p != end && *p == '.')
         {
             ++p;
-            if (!ISDIGIT(*p))
+            if (p == end || !ISDIGIT(*p))
                 return ELEPT_PARSE_ECODE::LEPT_PARSE_INVALID_VALUE;
-            /* ++p; could be ignored, same as above (and below) */
-            while (ISDIGIT(*p))
-                ++p;
+            p = lept_parse_digits(p, end, true, m, nd, exp10, truncated);
         }
 
-        if (*p == 'e' || *p == 'E')
+        if (p != end && (*p == 'e' || *p == 'E'))
         {
             ++p;
-            if (*p == '+' || *p == '-')
-                ++p;
-            if (!ISDIGIT(*p))
+            bool eneg = false;
+            if (p != end && (*p == '+' || *p == '-'))
+                eneg = *p++ == '-';
+            if (p == end || !ISDIGIT(*p))
                 return ELEPT_PARSE_ECODE::LEPT_PARSE_INVALID_VALUE;
-            while (ISDIGIT(*p))
-                ++p;
+            long e = 0;
+            for (; p != end && ISDIGIT(*p); ++p)
+                if (e < 100000) /* far beyond any double, saturate */
+                    e = e * 10 + (*p - '0');
+            exp10 += eneg ? -e : e;
         }
 
-        errno = 0;
-        v->value = strtod(c->json, nullptr);
-        if (errno == ERANGE && (std::get<double>(v->value) == HUGE_VAL || std::get<double>(v->value) == -HUGE_VAL))
+        double d = 0.0, d2;
+        if (m != 0 && (!lept_eisel_lemire(m, exp10, &d) ||
+            (truncated && (!lept_eisel_lemire(m + 1, exp10, &d2) || d != d2))))
+            d = fabs(lept_strtod(c->json, static_cast<size_t>(p - c->json)));
+        if (d == HUGE_VAL)
             return ELEPT_PARSE_ECODE::LEPT_PARSE_NUMBER_TOO_BIG;
+        v->value = neg ? -d : d;
         c->json = p;
         v->type = ELeptType::LEPT_NUMBER;
         return ELEPT_PARSE_ECODE::LEPT_PARSE_OK;
@@ -155,6 +1131,18 @@ namespace leptjson
         EXPECT(c, '\"');
         p = c->json;
         for (;;) {
+            /* copy the run of bytes that need no decoding at once */
+            const char* q = p;
+            while (q != c->end && !ISSTRINGSTOP(*q))
+                ++q;
+            if (q != p) {
+                memcpy(lept_context_push(c, static_cast<size_t>(q - p)), p, static_cast<size_t>(q - p));
+                p = q;
+            }
+            if (p == c->end) {
+                c->top = head;
+                return ELEPT_PARSE_ECODE::LEPT_PARSE_MISS_QUOTATION_MARK;
+            }
             char ch = *p++;
             switch (ch) {
             case '\"':
@@ -163,6 +1151,10 @@ namespace leptjson
                 c->json = p;
                 return ELEPT_PARSE_ECODE::LEPT_PARSE_OK;
             case '\\':
+                if (p == c->end) {
+                    c->top = head;
+                    return ELEPT_PARSE_ECODE::LEPT_PARSE_MISS_QUOTATION_MARK;
+                }
                 switch (*p++) {
                 case '\"': PUTC(c, '\"'); break;
                 case '\\': PUTC(c, '\\'); break;
@@ -177,15 +1169,9 @@ namespace leptjson
                     return ELEPT_PARSE_ECODE::LEPT_PARSE_INVALID_STRING_ESCAPE;
                 }
                 break;
-            case '\0':
+            default: /* the run above only stops at control characters otherwise */
                 c->top = head;
-                return ELEPT_PARSE_ECODE::LEPT_PARSE_MISS_QUOTATION_MARK;
-            default:
-                if (static_cast<unsigned char>(ch) < 0x20) {
-                    c->top = head;
-                    return ELEPT_PARSE_ECODE::LEPT_PARSE_INVALID_STRING_CHAR;
-                }
-                PUTC(c, ch);
+                return ELEPT_PARSE_ECODE::LEPT_PARSE_INVALID_STRING_CHAR;
             }
         }
     }
@@ -208,7 +1194,7 @@ namespace leptjson
 
         lept_parse_whitespace(c);
 
-        if (*c->json == ']') {
+        if (PEEK(c) == ']') {
             c->json++;
 
             v->type = ELeptType::LEPT_ARRAY;
@@ -233,12 +1219,12 @@ namespace leptjson
 
             size++;
             lept_parse_whitespace(c);
-            if (*c->json == ',')
+            if (PEEK(c) == ',')
             {
                 c->json++;
                 lept_parse_whitespace(c);
             }
-            else if (*c->json == ']') {
+            else if (PEEK(c) == ']') {
                 c->json++;
                 v->type = ELeptType::LEPT_ARRAY;
 
@@ -276,7 +1262,7 @@ namespace leptjson
         ELEPT_PARSE_ECODE ret;
         EXPECT(c, '{');
         lept_parse_whitespace(c);
-        if (*c->json == '}') {
+        if (PEEK(c) == '}') {
             c->json++;
             v->type = ELeptType::LEPT_OBJECT;
 
@@ -293,7 +1279,7 @@ namespace leptjson
             char* str;
             lept_init(&m.v);
             /* parse key */
-            if (*c->json != '"')
+            if (PEEK(c) != '"')
             {
                 ret = ELEPT_PARSE_ECODE::LEPT_PARSE_MISS_KEY;
                 break;
@@ -305,7 +1291,7 @@ namespace leptjson
             m.k[m.klen] = '\0';
             /* parse ws colon ws */
             lept_parse_whitespace(c);
-            if (*c->json != ':')
+            if (PEEK(c) != ':')
             {
                 ret = ELEPT_PARSE_ECODE::LEPT_PARSE_MISS_COLON;
                 break;
@@ -321,12 +1307,12 @@ namespace leptjson
             m.k = nullptr; /* ownership is transferred to member on stack */
             /* parse ws [comma | right-curly-brace] ws */
             lept_parse_whitespace(c);
-            if (*c->json == ',')
+            if (PEEK(c) == ',')
             {
                 c->json++;
                 lept_parse_whitespace(c);
             }
-            else if (*c->json == '}')
+            else if (PEEK(c) == '}')
             {
                 c->json++;
                 v->type = ELeptType::LEPT_OBJECT;
@@ -364,6 +1350,8 @@ namespace leptjson
     }
 
     static ELEPT_PARSE_ECODE lept_parse_value(lept_context* c, Lept_value* v) {
+        if (c->json == c->end)
+            return ELEPT_PARSE_ECODE::LEPT_PARSE_EXPECT_VALUE;
         switch (*c->json) {
         case 't':  return lept_parse_literal(c, v, "true", ELeptType::LEPT_TRUE);
         case 'f':  return lept_parse_literal(c, v, "false", ELeptType::LEPT_FALSE);
@@ -372,14 +1360,19 @@ namespace leptjson
         case '"':  return lept_parse_string(c, v);
         case '[':  return lept_parse_array(c, v);
         case '{':  return lept_parse_object(c, v);
-        case '\0': return ELEPT_PARSE_ECODE::LEPT_PARSE_EXPECT_VALUE;
         }
     }
 
     ELEPT_PARSE_ECODE lept_parse(Lept_value* v, const char* json) {
+        assert(json != nullptr);
+        return lept_parse_n(v, json, strlen(json));
+    }
+
+    ELEPT_PARSE_ECODE lept_parse_n(Lept_value* v, const char* json, size_t len) {
         lept_context c;
-        assert(v != nullptr);
+        assert(v != nullptr && json != nullptr);
         c.json = json;
+        c.end = json + len;
         c.stack = nullptr;
         c.size = c.top = 0;
         lept_init(v);
@@ -394,9 +1387,9 @@ namespace leptjson
             return parseErrorCode;
 
         lept_parse_whitespace(&c);
-        if (*c.json != '\0')
+        if (c.json != c.end)
         {
-            v->type = ELeptType::LEPT_NULL;
+            lept_free(v);
             return ELEPT_PARSE_ECODE::LEPT_PARSE_ROOT_NOT_SINGULAR;
         }
         else
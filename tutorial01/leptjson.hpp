@@ -75,6 +75,16 @@ namespace leptjson
      */
     ELEPT_PARSE_ECODE lept_parse(Lept_value* v, const char* json);
 
+    /**
+     * @brief Parse exactly |len| bytes of |json| and write to |v|.
+     * @note Note that |json| needs no null terminator, an embedded '\0' is an error.
+     * @param[in]  json the json string to be parsed
+     * @param[in]  len  length of |json| in bytes
+     * @param[out] v    value
+     * @return Return error code for parsing.
+     */
+    ELEPT_PARSE_ECODE lept_parse_n(Lept_value* v, const char* json, size_t len);
+
     /**
      * @brief Deallocate space allocated for string storage in |v|
      * if it owns a string. Set |v| type to LEPT_NULL as well.
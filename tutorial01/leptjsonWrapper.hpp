@@ -109,9 +109,9 @@ namespace leptjson
         LeptjsonParser(const LeptjsonParser&) = delete;
         LeptjsonParser& operator=(const LeptjsonParser&) = delete;
 
-        ELEPT_PARSE_ECODE Parse(const std::string& jsonString)
+        ELEPT_PARSE_ECODE Parse(std::string_view jsonString)
         {
-            return lept_parse(&this->m_value, jsonString.c_str());
+            return lept_parse_n(&this->m_value, jsonString.data(), jsonString.size());
         }
 
         ELeptType LeptValueType() const
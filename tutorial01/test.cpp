@@ -10,6 +10,7 @@
 #include <cstdlib>
 #include <string>
 #include <array>
+#include <string_view>
 #include "leptjson.hpp"
 #include "leptjsonWrapper.hpp"
 
@@ -68,6 +69,86 @@ static void test_parse_false() {
     lept_free(&v);
 }
 
+static void test_parse_whitespace() {
+    static const char ws[] = " \t\n\r";
+    std::array<char, 256> buf;
+    /* whitespace runs of every length at every alignment, so that SIMD blocks and scalar tails are both hit */
+    for (size_t offset = 0; offset < 32; offset++)
+        for (size_t n = 0; n < 72; n++) {
+            Lept_value v;
+            char* p = buf.data() + offset;
+            for (size_t i = 0; i < n; i++)
+                p[i] = ws[i % 4];
+            memcpy(p + n, "null", 4);
+            for (size_t i = 0; i < n; i++)
+                p[n + 4 + i] = ws[(i + 1) % 4];
+            p[n * 2 + 4] = '\0';
+            lept_init(&v);
+            EXPECT_EQ_INT(ELEPT_PARSE_ECODE::LEPT_PARSE_OK, lept_parse(&v, p));
+            EXPECT_EQ_INT(ELeptType::LEPT_NULL, lept_get_type(&v));
+            p[n * 2 + 4] = 'x';
+            p[n * 2 + 5] = '\0';
+            EXPECT_EQ_INT(ELEPT_PARSE_ECODE::LEPT_PARSE_ROOT_NOT_SINGULAR, lept_parse(&v, p));
+            p[n] = '\0';
+            EXPECT_EQ_INT(ELEPT_PARSE_ECODE::LEPT_PARSE_EXPECT_VALUE, lept_parse(&v, p));
+            lept_free(&v);
+        }
+}
+
+#define TEST_PARSE_N(error, json, len)\
+    do {\
+        Lept_value v;\
+        lept_init(&v);\
+        EXPECT_EQ_INT(error, lept_parse_n(&v, json, len));\
+        lept_free(&v);\
+    } while(0)
+
+static void test_parse_length() {
+    static const std::array<std::string_view, 2> docs = {
+        "[ null , false , true , 123 , 4.5e-6 , \"abc\\n\" ]",
+        "{ \"a\" : [ 1234567890123456 , { } ] , \"b\" : \"                  \" }"
+    };
+    Lept_value v;
+
+    /* only the first len bytes count */
+    lept_init(&v);
+    EXPECT_EQ_INT(ELEPT_PARSE_ECODE::LEPT_PARSE_OK, lept_parse_n(&v, "[1,2]xyz", 5));
+    EXPECT_EQ_SIZE_T(2, lept_get_array_size(&v));
+    lept_free(&v);
+    EXPECT_EQ_INT(ELEPT_PARSE_ECODE::LEPT_PARSE_OK, lept_parse_n(&v, "123456789", 3));
+    EXPECT_EQ_DOUBLE(123.0, lept_get_number(&v));
+    EXPECT_EQ_INT(ELEPT_PARSE_ECODE::LEPT_PARSE_OK, lept_parse_n(&v, "\"abc\"def\"", 5));
+    EXPECT_EQ_STRING("abc", lept_get_string(&v), lept_get_string_length(&v));
+    lept_free(&v);
+    TEST_PARSE_N(ELEPT_PARSE_ECODE::LEPT_PARSE_OK, "truex", 4);
+    TEST_PARSE_N(ELEPT_PARSE_ECODE::LEPT_PARSE_INVALID_VALUE, "true", 3);
+    TEST_PARSE_N(ELEPT_PARSE_ECODE::LEPT_PARSE_INVALID_VALUE, "1.5", 2);
+    TEST_PARSE_N(ELEPT_PARSE_ECODE::LEPT_PARSE_INVALID_VALUE, "1e5", 2);
+    TEST_PARSE_N(ELEPT_PARSE_ECODE::LEPT_PARSE_MISS_QUOTATION_MARK, "\"abc\"", 4);
+    TEST_PARSE_N(ELEPT_PARSE_ECODE::LEPT_PARSE_MISS_QUOTATION_MARK, "\"\\n\"", 2);
+    TEST_PARSE_N(ELEPT_PARSE_ECODE::LEPT_PARSE_EXPECT_VALUE, " x", 1);
+
+    /* embedded '\0' */
+    TEST_PARSE_N(ELEPT_PARSE_ECODE::LEPT_PARSE_ROOT_NOT_SINGULAR, "null\0", 5);
+    TEST_PARSE_N(ELEPT_PARSE_ECODE::LEPT_PARSE_INVALID_VALUE, "\0", 1);
+    TEST_PARSE_N(ELEPT_PARSE_ECODE::LEPT_PARSE_INVALID_STRING_CHAR, "\"a\0b\"", 5);
+
+    /* every proper prefix of a container is an error, and is read from an exact-size buffer */
+    for (const auto& doc : docs)
+        for (size_t k = 0; k <= doc.size(); k++) {
+            std::string buf(doc.substr(0, k));
+            lept_init(&v);
+            ELEPT_PARSE_ECODE ret = lept_parse_n(&v, buf.data(), k);
+            if (k == doc.size())
+                EXPECT_EQ_INT(ELEPT_PARSE_ECODE::LEPT_PARSE_OK, ret);
+            else if (k == 0)
+                EXPECT_EQ_INT(ELEPT_PARSE_ECODE::LEPT_PARSE_EXPECT_VALUE, ret);
+            else
+                EXPECT_TRUE(ret != ELEPT_PARSE_ECODE::LEPT_PARSE_OK);
+            lept_free(&v);
+        }
+}
+
 #define TEST_NUMBER(expect, json)\
     do {\
         Lept_value v;\
@@ -108,6 +189,16 @@ static void test_parse_number() {
     TEST_NUMBER(-2.2250738585072014e-308, "-2.2250738585072014e-308");
     TEST_NUMBER(1.7976931348623157e+308, "1.7976931348623157e+308");  /* Max double */
     TEST_NUMBER(-1.7976931348623157e+308, "-1.7976931348623157e+308");
+
+    TEST_NUMBER(9007199254740992.0, "9007199254740993"); /* halfway between two doubles, round to even */
+    TEST_NUMBER(9007199254740996.0, "9007199254740995");
+    TEST_NUMBER(1e23, "1e23");
+    TEST_NUMBER(12345678.87654321, "12345678.87654321");  /* 8-digit blocks */
+    TEST_NUMBER(1.2345678901234568e+29, "123456789012345678901234567890"); /* more than 19 digits */
+    TEST_NUMBER(1.2345678901234567, "1.23456789012345678901234567890");
+    TEST_NUMBER(1e-7, "0.0000001000000000000000000000000000");
+    TEST_NUMBER(0.0, "0.000000000000000000000000000000000000");
+    TEST_NUMBER(1.0, "0.1e1");
 }
 
 #define TEST_STRING(expect, json)\
@@ -276,6 +367,11 @@ static void test_parse_expect_value() {
 static void test_parse_invalid_value() {
     TEST_ERROR(ELEPT_PARSE_ECODE::LEPT_PARSE_INVALID_VALUE, "nul");
     TEST_ERROR(ELEPT_PARSE_ECODE::LEPT_PARSE_INVALID_VALUE, "?");
+    TEST_ERROR(ELEPT_PARSE_ECODE::LEPT_PARSE_INVALID_VALUE, "tru");
+    TEST_ERROR(ELEPT_PARSE_ECODE::LEPT_PARSE_INVALID_VALUE, "trUe");
+    TEST_ERROR(ELEPT_PARSE_ECODE::LEPT_PARSE_INVALID_VALUE, "fals");
+    TEST_ERROR(ELEPT_PARSE_ECODE::LEPT_PARSE_INVALID_VALUE, "falsE");
+    TEST_ERROR(ELEPT_PARSE_ECODE::LEPT_PARSE_INVALID_VALUE, "nulL");
 
     /* invalid number */
     TEST_ERROR(ELEPT_PARSE_ECODE::LEPT_PARSE_INVALID_VALUE, "+0");
@@ -402,6 +498,8 @@ static void test_parse() {
     test_parse_null();
     test_parse_true();
     test_parse_false();
+    test_parse_whitespace();
+    test_parse_length();
     test_parse_number();
     test_parse_string();
     test_parse_array();
@@ -0,0 +1,145 @@
+/*
+ * Throughput benchmark: bench [file] [max_threads]
+ * Parses file, or generated records, as NDJSON with 1, 2, 4, ... max_threads threads (default 8), then the same
+ * records as one array with lept_parse_parallel(), and checks that array with lept_validate().
+ */
+#if defined(_WIN32)
+#include <windows.h>   /* QueryPerformanceCounter() */
+#else
+#define _POSIX_C_SOURCE 199309L
+#include <time.h>      /* clock_gettime() */
+#endif
+#include "leptjson.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+static double now(void) {
+#if defined(_WIN32)
+    LARGE_INTEGER t, f;
+    QueryPerformanceCounter(&t);
+    QueryPerformanceFrequency(&f);
+    return (double)t.QuadPart / (double)f.QuadPart;
+#else
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + t.tv_nsec * 1e-9;
+#endif
+}
+
+static char* generate(size_t* len) {
+    size_t n = 200000, i;
+    char* json = (char*)malloc(n * 256), * p = json;
+    for (i = 0; i < n; i++)
+        p += sprintf(p, "{\"id\":%lu,\"user\":{\"name\":\"user%lu\",\"score\":%.3f,\"tags\":[\"a\",\"b\\u00e9\",\"c\"]},"
+            "\"active\":%s,\"ts\":\"2024-01-01T00:00:%02luZ\",\"values\":[1,2.5,-3e10,null]}\n",
+            (unsigned long)i, (unsigned long)(i % 1000), i * 0.37, i & 1 ? "true" : "false", (unsigned long)(i % 60));
+    *len = (size_t)(p - json);
+    return json;
+}
+
+static char* load(const char* path, size_t* len) {
+    FILE* fp = fopen(path, "rb");
+    char* json;
+    long size;
+    if (fp == NULL)
+        return NULL;
+    fseek(fp, 0, SEEK_END);
+    size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    json = (char*)malloc((size_t)size + 1);
+    *len = fread(json, 1, (size_t)size, fp);
+    fclose(fp);
+    return json;
+}
+
+/* Join the lines into one array, with commas in place of the newlines */
+static char* to_array(const char* json, size_t* len) {
+    char* a = (char*)malloc(*len + 2);
+    size_t i, n = *len;
+    while (n > 0 && json[n - 1] == '\n')
+        n--;
+    a[0] = '[';
+    for (i = 0; i < n; i++)
+        a[i + 1] = json[i] == '\n' ? ',' : json[i];
+    a[n + 1] = ']';
+    *len = n + 2;
+    return a;
+}
+
+static int count(void* user, size_t line, int ret, lept_value* v) {
+    (void)line;
+    (void)v;
+    if (ret == LEPT_PARSE_OK)
+        ++*(size_t*)user;
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    size_t len, alen, records;
+    unsigned threads, max_threads = argc > 2 ? (unsigned)atoi(argv[2]) : 8;
+    char* json = argc > 1 ? load(argv[1], &len) : generate(&len), * array;
+    lept_value v;
+    lept_document d;
+    double t, best;
+    int i;
+    if (json == NULL) {
+        fprintf(stderr, "cannot read %s\n", argv[1]);
+        return 1;
+    }
+    for (threads = 1; threads <= max_threads; threads *= 2) {
+        best = 1e30;
+        for (i = 0; i < 3; i++) {
+            records = 0;
+            t = now();
+            lept_parse_ndjson(json, len, threads, count, &records);
+            if ((t = now() - t) < best)
+                best = t;
+        }
+        printf("ndjson   threads %2u: %8.1f MB/s, %lu records\n", threads, len / best / 1e6, (unsigned long)records);
+    }
+    alen = len;
+    array = to_array(json, &alen);
+    for (threads = 1; threads <= max_threads; threads *= 2) {
+        best = 1e30;
+        for (i = 0; i < 3; i++) {
+            lept_init(&v);
+            t = now();
+            lept_parse_parallel(&v, array, alen, threads);
+            if ((t = now() - t) < best)
+                best = t;
+            records = lept_get_type(&v) == LEPT_ARRAY ? lept_get_array_size(&v) : 0;
+            lept_free(&v);
+        }
+        printf("parallel threads %2u: %8.1f MB/s, %lu elements\n", threads, alen / best / 1e6, (unsigned long)records);
+    }
+    best = 1e30;
+    for (i = 0; i < 3; i++) {
+        t = now();
+        lept_validate(array, alen);
+        if ((t = now() - t) < best)
+            best = t;
+    }
+    printf("validate          : %8.1f MB/s\n", alen / best / 1e6);
+    best = 1e30;
+    for (i = 0; i < 3; i++) {
+        t = now();
+        lept_parse_n(&v, array, alen);
+        lept_free(&v);
+        if ((t = now() - t) < best)
+            best = t;
+    }
+    printf("parse, lept_free  : %8.1f MB/s\n", alen / best / 1e6);
+    best = 1e30;
+    for (i = 0; i < 3; i++) {
+        t = now();
+        lept_document_init(&d);
+        lept_document_parse(&d, array, alen, LEPT_PARSE_DEFAULT_FLAG);
+        lept_document_free(&d);
+        if ((t = now() - t) < best)
+            best = t;
+    }
+    printf("parse, document   : %8.1f MB/s\n", alen / best / 1e6);
+    free(array);
+    free(json);
+    return 0;
+}
@@ -2,13 +2,74 @@
 #define _CRTDBG_MAP_ALLOC
 #include <crtdbg.h>
 #endif
+#if !defined(_WIN32) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE /* mmap(), madvise() in strict ANSI mode */
+#endif
 #include "leptjson.h"
 #include <assert.h>  /* assert() */
-#include <errno.h>   /* errno, ERANGE */
+#include <locale.h>  /* localeconv() */
 #include <math.h>    /* HUGE_VAL */
+#include <stdint.h>  /* uint64_t, UINT64_C() */
 #include <stdio.h>   /* sprintf() */
 #include <stdlib.h>  /* NULL, malloc(), realloc(), free(), strtod() */
-#include <string.h>  /* memcpy() */
+#include <string.h>  /* memcpy(), memset() */
+
+#if !defined(LEPT_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LEPT_SSE2
+#include <emmintrin.h> /* _mm_load_si128(), _mm_cmpeq_epi8(), _mm_movemask_epi8() */
+#endif
+#if defined(__AVX2__)
+#define LEPT_AVX2
+#include <immintrin.h> /* _mm256_load_si256(), _mm256_cmpeq_epi8(), _mm256_movemask_epi8() */
+#endif
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>    /* _BitScanForward(), _BitScanReverse64(), _umul128() */
+#endif
+
+#if defined(_WIN32)
+#include <windows.h>   /* CreateFileA(), MapViewOfFile(), CRITICAL_SECTION, CONDITION_VARIABLE */
+#else
+#include <fcntl.h>     /* open() */
+#include <sys/mman.h>  /* mmap(), madvise() */
+#include <sys/stat.h>  /* fstat() */
+#include <unistd.h>    /* close() */
+#endif
+
+#if !defined(LEPT_NO_THREADS)
+#if defined(_WIN32)
+#include <process.h>   /* _beginthreadex() */
+typedef HANDLE lept_thread;
+typedef CRITICAL_SECTION lept_mutex;
+typedef CONDITION_VARIABLE lept_cond;
+#define lept_thread_create(t, f, arg)   ((*(t) = (HANDLE)_beginthreadex(NULL, 0, f, arg, 0, NULL)) != 0)
+#define lept_thread_join(t)             (WaitForSingleObject(t, INFINITE), CloseHandle(t))
+#define lept_mutex_init(m)              InitializeCriticalSection(m)
+#define lept_mutex_destroy(m)           DeleteCriticalSection(m)
+#define lept_mutex_lock(m)              EnterCriticalSection(m)
+#define lept_mutex_unlock(m)            LeaveCriticalSection(m)
+#define lept_cond_init(cv)              InitializeConditionVariable(cv)
+#define lept_cond_destroy(cv)           ((void)0)
+#define lept_cond_wait(cv, m)           SleepConditionVariableCS(cv, m, INFINITE)
+#define lept_cond_broadcast(cv)         WakeAllConditionVariable(cv)
+#else
+#include <pthread.h>   /* pthread_create(), pthread_mutex_lock(), pthread_cond_wait() */
+typedef pthread_t lept_thread;
+typedef pthread_mutex_t lept_mutex;
+typedef pthread_cond_t lept_cond;
+#define lept_thread_create(t, f, arg)   (pthread_create(t, NULL, f, arg) == 0)
+#define lept_thread_join(t)             pthread_join(t, NULL)
+#define lept_mutex_init(m)              pthread_mutex_init(m, NULL)
+#define lept_mutex_destroy(m)           pthread_mutex_destroy(m)
+#define lept_mutex_lock(m)              pthread_mutex_lock(m)
+#define lept_mutex_unlock(m)            pthread_mutex_unlock(m)
+#define lept_cond_init(cv)              pthread_cond_init(cv, NULL)
+#define lept_cond_destroy(cv)           pthread_cond_destroy(cv)
+#define lept_cond_wait(cv, m)           pthread_cond_wait(cv, m)
+#define lept_cond_broadcast(cv)         pthread_cond_broadcast(cv)
+#endif
+#endif
 
 #ifndef LEPT_PARSE_STACK_INIT_SIZE
 #define LEPT_PARSE_STACK_INIT_SIZE 256
@@ -18,18 +79,317 @@
 #define LEPT_PARSE_STRINGIFY_INIT_SIZE 256
 #endif
 
-#define EXPECT(c, ch)       do { assert(*c->json == (ch)); c->json++; } while(0)
-#define ISDIGIT(ch)         ((ch) >= '0' && (ch) <= '9')
-#define ISDIGIT1TO9(ch)     ((ch) >= '1' && (ch) <= '9')
+#ifndef LEPT_NDJSON_BATCH_SIZE
+#define LEPT_NDJSON_BATCH_SIZE (1 << 14) /* bytes of input per batch, cut at the next newline */
+#endif
+
+#ifndef LEPT_PARALLEL_SEGMENT_MIN
+#define LEPT_PARALLEL_SEGMENT_MIN (1 << 16) /* bytes of input per thread in lept_parse_parallel() at least */
+#endif
+
+#define EXPECT(c, ch)       do { assert(c->json != c->end && *c->json == (ch)); c->json++; } while(0)
+#define PEEK(c)             ((c)->json != (c)->end ? *(c)->json : '\0')
+#define ISDIGIT(ch)         (lept_char_class[(unsigned char)(ch)] & LEPT_CHAR_DIGIT)
+#define ISDIGIT1TO9(ch)     ((ch) != '0' && ISDIGIT(ch))
+#define ISWHITESPACE(ch)    (lept_char_class[(unsigned char)(ch)] & LEPT_CHAR_WHITESPACE)
+#define ISSTRINGSTOP(ch)    (lept_char_class[(unsigned char)(ch)] & LEPT_CHAR_STRING_STOP)
 #define PUTC(c, ch)         do { *(char*)lept_context_push(c, sizeof(char)) = (ch); } while(0)
 #define PUTS(c, s, len)     memcpy(lept_context_push(c, len), s, len)
 
+/* The scanners classify a byte with one table lookup instead of a chain of comparisons */
+#define LEPT_CHAR_WHITESPACE  0x01 /* ' ', '\t', '\n', '\r' */
+#define LEPT_CHAR_DIGIT       0x02 /* '0' to '9' */
+#define LEPT_CHAR_STRING_STOP 0x04 /* '\"', '\\' and control characters, which end a run of verbatim string bytes */
+#define LEPT_CHAR_NUMBER      0x08 /* digits, '+', '-', '.', 'e' and 'E' */
+#define LEPT_CHAR_DELIMITER   0x10 /* whitespace, ',', ']' and '}', which end a literal or number */
+
+static const unsigned char lept_char_class[256] = {
+    /* 0_ */  4,  4,  4,  4,  4,  4,  4,  4,  4, 21, 21,  4,  4, 21,  4,  4,
+    /* 1_ */  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,
+    /* 2_ */ 17,  0,  4,  0,  0,  0,  0,  0,  0,  0,  0,  8, 16,  8,  8,  0,
+    /* 3_ */ 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,  0,  0,  0,  0,  0,  0,
+    /* 4_ */  0,  0,  0,  0,  0,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    /* 5_ */  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  4, 16,  0,  0,
+    /* 6_ */  0,  0,  0,  0,  0,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    /* 7_ */  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 16,  0,  0,
+    /* 8_ */  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    /* 9_ */  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    /* A_ */  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    /* B_ */  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    /* C_ */  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    /* D_ */  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    /* E_ */  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    /* F_ */  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0
+};
+
+/* Value of a hex digit, -1 for other bytes */
+static const signed char lept_hex_digit[256] = {
+    /* 0_ */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 1_ */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 2_ */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 3_ */  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, -1, -1, -1, -1, -1, -1,
+    /* 4_ */ -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 5_ */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 6_ */ -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 7_ */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 8_ */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* 9_ */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* A_ */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* B_ */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* C_ */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* D_ */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* E_ */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    /* F_ */ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+};
+
+#define LEPT_VALUE_STRING_REF 0x01 /* u.s.s points into the parsed input or a lept_document and is not owned */
+#define LEPT_VALUE_UINT64     0x02 /* integer is stored in u.ui, only used above INT64_MAX */
+#define LEPT_VALUE_KEYS_REF   0x04 /* object member keys point into the parsed input or a lept_document, not owned */
+#define LEPT_VALUE_STRING_SHORT 0x08 /* string is stored in u.ss, see lept_set_string_short() */
+#define LEPT_VALUE_STORAGE_REF 0x10 /* elements or members are in a lept_document and are not owned */
+
+#ifdef LEPT_COMPACT
+#define LEPT_ARRAY_SIZE(v)    ((v)->size)
+#define LEPT_OBJECT_SIZE(v)   ((v)->size)
+#define LEPT_STRING_LENGTH(v) ((v)->size)
+#define LEPT_STRING_SHORT_MAX (sizeof(((lept_value*)0)->u.ss) - 1) /* room for '\0' */
+#else
+#define LEPT_ARRAY_SIZE(v)    ((v)->u.a.size)
+#define LEPT_OBJECT_SIZE(v)   ((v)->u.o.size)
+#define LEPT_STRING_LENGTH(v) ((v)->u.s.len)
+#define LEPT_STRING_SHORT_MAX (sizeof(((lept_value*)0)->u.ss) - 2) /* room for '\0' and the length */
+#endif
+
+/* Element or member storage for capacity items of size bytes, NULL for none */
+static void* lept_storage_resize(void* p, size_t capacity, size_t size) {
+#ifdef LEPT_COMPACT
+    size_t* h = p != NULL ? (size_t*)p - 1 : NULL; /* the capacity is kept in front */
+    if (capacity == 0) {
+        free(h);
+        return NULL;
+    }
+    h = (size_t*)realloc(h, sizeof(size_t) + capacity * size);
+    *h = capacity;
+    return h + 1;
+#else
+    if (capacity == 0) {
+        free(p);
+        return NULL;
+    }
+    return realloc(p, capacity * size);
+#endif
+}
+
+static void lept_storage_free(void* p) {
+#ifdef LEPT_COMPACT
+    if (p != NULL)
+        free((size_t*)p - 1);
+#else
+    free(p);
+#endif
+}
+
+#ifdef LEPT_COMPACT
+#define LEPT_ARRAY_CAPACITY(v)  ((v)->u.a.e != NULL ? ((size_t*)(v)->u.a.e)[-1] : 0)
+#define LEPT_SET_CAPACITY(c, n) ((void)0)
+#else
+#define LEPT_ARRAY_CAPACITY(v)  ((v)->u.a.capacity)
+#define LEPT_SET_CAPACITY(c, n) ((c).capacity = (n))
+#endif
+
+/* Blocks of a lept_document, each followed by its bytes */
+typedef struct lept_chunk {
+    struct lept_chunk* next;
+    size_t size;
+}lept_chunk;
+
+#ifndef LEPT_DOCUMENT_BLOCK
+#define LEPT_DOCUMENT_BLOCK 4096 /* first block of a document, each next one is twice as large */
+#endif
+
+/* size bytes from the blocks of d, 8-byte aligned. Large requests get a block of their own behind the newest. */
+static void* lept_document_alloc(lept_document* d, size_t size) {
+    lept_chunk* head = (lept_chunk*)d->blocks, * b;
+    size = (size + 7) & ~(size_t)7;
+    if ((size_t)(d->end - d->next) < size) {
+        size_t n = head != NULL ? 2 * head->size : LEPT_DOCUMENT_BLOCK;
+        if (size > n / 2 && head != NULL) {
+            b = (lept_chunk*)malloc(sizeof(lept_chunk) + size);
+            b->size = size;
+            b->next = head->next;
+            head->next = b;
+            return b + 1;
+        }
+        if (n < size)
+            n = size;
+        b = (lept_chunk*)malloc(sizeof(lept_chunk) + n);
+        b->size = n;
+        b->next = head;
+        d->blocks = b;
+        d->next = (char*)(b + 1);
+        d->end = d->next + n;
+    }
+    d->next += size;
+    return d->next - size;
+}
+
+static void lept_chunks_free(lept_chunk* b) {
+    while (b != NULL) {
+        lept_chunk* next = b->next;
+        free(b);
+        b = next;
+    }
+}
+
+/* Element or member storage from d, laid out as by lept_storage_resize() */
+static void* lept_document_storage(lept_document* d, size_t capacity, size_t size) {
+#ifdef LEPT_COMPACT
+    size_t* h;
+    if (capacity == 0)
+        return NULL;
+    h = (size_t*)lept_document_alloc(d, sizeof(size_t) + capacity * size);
+    *h = capacity;
+    return h + 1;
+#else
+    return capacity > 0 ? lept_document_alloc(d, capacity * size) : NULL;
+#endif
+}
+
+#define LEPT_PARSE_INSITU     0x80000000u /* c->flags: json is the caller's writable buffer, see lept_parse_insitu() */
+
+/*
+ * Owned object keys are shared: each is a lept_key header followed by the bytes and '\0', and member.k points
+ * past the header. A parse interns its keys in a lept_keys table, so the keys of one document that are equal
+ * share one buffer. The table holds a reference of its own until the parse ends, then only the members do.
+ * Keys of a lept_document are owned by it and not counted.
+ */
+typedef struct {
+    size_t refs;
+}lept_key;
+
+typedef struct lept_keys lept_keys;
+
+typedef struct {
+    size_t hash, len;
+    lept_key* key;      /* NULL when free */
+}lept_key_slot;
+
+struct lept_keys {
+    lept_key_slot* slot;    /* open addressing */
+    size_t size, capacity;
+    size_t misses;          /* keys not found once the table is full */
+    lept_document* document;    /* where the keys are allocated, which then owns them, or NULL */
+};
+
+#define LEPT_KEY(k) ((lept_key*)(k) - 1)
+
+#ifndef LEPT_KEYS_MAX
+#define LEPT_KEYS_MAX 1024  /* distinct keys a table takes, which keeps it in cache */
+#endif
+
+/* Hash of a key, a word at a time */
+static size_t lept_key_hash(const char* s, size_t len) {
+    uint64_t h = UINT64_C(0x9E3779B97F4A7C15) ^ len, w;
+    for (; len >= 8; s += 8, len -= 8) {
+        memcpy(&w, s, 8);
+        h = (h ^ w) * UINT64_C(0xBF58476D1CE4E5B9);
+        h ^= h >> 31;
+    }
+    if (len > 0) {
+        for (w = 0; len > 0; )
+            w = w << 8 | (unsigned char)s[--len];
+        h = (h ^ w) * UINT64_C(0xBF58476D1CE4E5B9);
+        h ^= h >> 31;
+    }
+    return (size_t)(h ^ h >> 29);
+}
+
+static char* lept_key_new(lept_keys* t, const char* s, size_t len, size_t refs) {
+    lept_key* key = (lept_key*)(t != NULL && t->document != NULL ?
+        lept_document_alloc(t->document, sizeof(lept_key) + len + 1) : malloc(sizeof(lept_key) + len + 1));
+    char* k = (char*)(key + 1);
+    key->refs = refs;
+    if (len > 0)
+        memcpy(k, s, len);
+    k[len] = '\0';
+    return k;
+}
+
+static void lept_key_release(char* k) {
+    if (--LEPT_KEY(k)->refs == 0)
+        free(LEPT_KEY(k));
+}
+
+static void lept_keys_init(lept_keys* t) {
+    t->slot = NULL;
+    t->size = t->capacity = t->misses = 0;
+    t->document = NULL;
+}
+
+static void lept_keys_free(lept_keys* t) {
+    size_t i;
+    for (i = 0; i < t->capacity && t->document == NULL; i++)
+        if (t->slot[i].key != NULL)
+            lept_key_release((char*)(t->slot[i].key + 1));
+    free(t->slot);
+    lept_keys_init(t);
+}
+
+/*
+ * A reference to the key s, shared with its equal keys in t, or a key of its own when t is NULL. A full table is
+ * no longer looked at once as many keys again have missed it, as in a large object keyed by ids.
+ */
+static char* lept_intern(lept_keys* t, const char* s, size_t len) {
+    size_t hash, i, mask;
+    lept_key_slot* slot;
+    char* k;
+    if (t == NULL || t->misses > LEPT_KEYS_MAX)
+        return lept_key_new(t, s, len, 1);
+    if (2 * (t->size + 1) > t->capacity && t->size < LEPT_KEYS_MAX) { /* keep it at most half full */
+        size_t capacity = t->capacity ? 2 * t->capacity : 64;
+        slot = (lept_key_slot*)calloc(capacity, sizeof(lept_key_slot));
+        for (i = 0; i < t->capacity; i++)
+            if (t->slot[i].key != NULL) {
+                size_t j = t->slot[i].hash & (capacity - 1);
+                while (slot[j].key != NULL)
+                    j = (j + 1) & (capacity - 1);
+                slot[j] = t->slot[i];
+            }
+        free(t->slot);
+        t->slot = slot;
+        t->capacity = capacity;
+    }
+    hash = lept_key_hash(s, len);
+    mask = t->capacity - 1;
+    for (i = hash & mask; (slot = &t->slot[i])->key != NULL; i = (i + 1) & mask)
+        if (slot->hash == hash && slot->len == len && memcmp(slot->key + 1, s, len) == 0) {
+            slot->key->refs++;
+            return (char*)(slot->key + 1);
+        }
+    if (t->size == LEPT_KEYS_MAX) {
+        t->misses++;
+        return lept_key_new(t, s, len, 1);
+    }
+    k = lept_key_new(t, s, len, 2);
+    slot->hash = hash;
+    slot->len = len;
+    slot->key = LEPT_KEY(k);
+    t->size++;
+    return k;
+}
+
 typedef struct {
     const char* json;
+    const char* end;
     char* stack;
     size_t size, top;
+    unsigned flags;
+    lept_keys* keys;    /* where the DOM being built interns its keys, see lept_intern() */
 }lept_context;
 
+/* The document that owns what the DOM being built allocates, or NULL */
+#define LEPT_CONTEXT_DOCUMENT(c) ((c)->keys != NULL ? (c)->keys->document : NULL)
+
 static void* lept_context_push(lept_context* c, size_t size) {
     void* ret;
     assert(size > 0);
@@ -50,104 +410,1318 @@ static void* lept_context_pop(lept_context* c, size_t size) {
     return c->stack + (c->top -= size);
 }
 
-static void lept_parse_whitespace(lept_context* c) {
-    const char *p = c->json;
-    while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')
+#if defined(LEPT_SSE2) || defined(LEPT_AVX2)
+/* Index of the lowest set bit, m must be non-zero */
+static unsigned lept_ctz(unsigned m) {
+#if defined(_MSC_VER)
+    unsigned long i;
+    _BitScanForward(&i, m);
+    return (unsigned)i;
+#else
+    return (unsigned)__builtin_ctz(m);
+#endif
+}
+#endif
+
+#if defined(LEPT_AVX2)
+#define LEPT_SIMD_WIDTH 32
+#elif defined(LEPT_SSE2)
+#define LEPT_SIMD_WIDTH 16
+#endif
+
+#ifdef LEPT_SIMD_WIDTH
+/* Whole blocks are classified while they fit before end, the tail is done byte by byte */
+static const char* lept_skip_whitespace_simd(const char* p, const char* end) {
+    unsigned r;
+    /* Most calls see zero or one whitespace, do not pay for the setup */
+    if (p == end || !ISWHITESPACE(*p))
+        return p;
+    p++;
+#if defined(LEPT_AVX2)
+    {
+        const __m256i sp = _mm256_set1_epi8(' ');
+        const __m256i nl = _mm256_set1_epi8('\n');
+        const __m256i cr = _mm256_set1_epi8('\r');
+        const __m256i ht = _mm256_set1_epi8('\t');
+        for (; end - p >= 32; p += 32) {
+            const __m256i s = _mm256_loadu_si256((const __m256i*)p);
+            __m256i x = _mm256_cmpeq_epi8(s, sp);
+            x = _mm256_or_si256(x, _mm256_cmpeq_epi8(s, nl));
+            x = _mm256_or_si256(x, _mm256_cmpeq_epi8(s, cr));
+            x = _mm256_or_si256(x, _mm256_cmpeq_epi8(s, ht));
+            if ((r = ~(unsigned)_mm256_movemask_epi8(x)) != 0)
+                return p + lept_ctz(r);
+        }
+    }
+#else
+    {
+        const __m128i sp = _mm_set1_epi8(' ');
+        const __m128i nl = _mm_set1_epi8('\n');
+        const __m128i cr = _mm_set1_epi8('\r');
+        const __m128i ht = _mm_set1_epi8('\t');
+        for (; end - p >= 16; p += 16) {
+            const __m128i s = _mm_loadu_si128((const __m128i*)p);
+            __m128i x = _mm_cmpeq_epi8(s, sp);
+            x = _mm_or_si128(x, _mm_cmpeq_epi8(s, nl));
+            x = _mm_or_si128(x, _mm_cmpeq_epi8(s, cr));
+            x = _mm_or_si128(x, _mm_cmpeq_epi8(s, ht));
+            if ((r = ~(unsigned)_mm_movemask_epi8(x) & 0xFFFF) != 0)
+                return p + lept_ctz(r);
+        }
+    }
+#endif
+    while (p != end && ISWHITESPACE(*p))
         p++;
-    c->json = p;
+    return p;
 }
 
-static int lept_parse_literal(lept_context* c, lept_value* v, const char* literal, lept_type type) {
-    size_t i;
-    EXPECT(c, literal[0]);
-    for (i = 0; literal[i + 1]; i++)
-        if (c->json[i] != literal[i + 1])
-            return LEPT_PARSE_INVALID_VALUE;
-    c->json += i;
+static const char* lept_scan_string_simd(const char* p, const char* end) {
+    unsigned r;
+#if defined(LEPT_AVX2)
+    {
+        const __m256i dq = _mm256_set1_epi8('\"');
+        const __m256i bs = _mm256_set1_epi8('\\');
+        const __m256i cc = _mm256_set1_epi8(0x1F);
+        for (; end - p >= 32; p += 32) {
+            const __m256i s = _mm256_loadu_si256((const __m256i*)p);
+            __m256i x = _mm256_cmpeq_epi8(s, dq);
+            x = _mm256_or_si256(x, _mm256_cmpeq_epi8(s, bs));
+            x = _mm256_or_si256(x, _mm256_cmpeq_epi8(_mm256_max_epu8(s, cc), cc)); /* s <= 0x1F */
+            if ((r = (unsigned)_mm256_movemask_epi8(x)) != 0)
+                return p + lept_ctz(r);
+        }
+    }
+#else
+    {
+        const __m128i dq = _mm_set1_epi8('\"');
+        const __m128i bs = _mm_set1_epi8('\\');
+        const __m128i cc = _mm_set1_epi8(0x1F);
+        for (; end - p >= 16; p += 16) {
+            const __m128i s = _mm_loadu_si128((const __m128i*)p);
+            __m128i x = _mm_cmpeq_epi8(s, dq);
+            x = _mm_or_si128(x, _mm_cmpeq_epi8(s, bs));
+            x = _mm_or_si128(x, _mm_cmpeq_epi8(_mm_max_epu8(s, cc), cc)); /* s <= 0x1F */
+            if ((r = (unsigned)_mm_movemask_epi8(x)) != 0)
+                return p + lept_ctz(r);
+        }
+    }
+#endif
+    while (p != end && !ISSTRINGSTOP(*p))
+        p++;
+    return p;
+}
+#endif
+
+/* Return the first '\"', '\\' or control character in [p, end), or end, i.e. the end of a run that can be copied verbatim */
+static const char* lept_scan_string(const char* p, const char* end) {
+#ifdef LEPT_SIMD_WIDTH
+    return lept_scan_string_simd(p, end);
+#else
+    while (p != end && !ISSTRINGSTOP(*p))
+        p++;
+    return p;
+#endif
+}
+
+static const char* lept_skip_whitespace(const char* p, const char* end) {
+#ifdef LEPT_SIMD_WIDTH
+    return lept_skip_whitespace_simd(p, end);
+#else
+    while (p != end && ISWHITESPACE(*p))
+        p++;
+    return p;
+#endif
+}
+
+/*
+ * UTF-8 check of the input, before it is parsed. With AVX2 every block that is not plain ASCII goes through the
+ * lookup method of Keiser and Lemire: three table lookups on the nibbles of each byte and of the byte before it flag
+ * bad pairs, and a byte two or three after a lead must be a continuation. Other builds skip whole ASCII blocks and
+ * decode the rest one sequence at a time.
+ */
+
+/* Return the byte after the non-ASCII sequence at p, p itself when end cuts it, or NULL when it is not UTF-8 */
+static const char* lept_utf8_sequence(const char* p, const char* end) {
+    const unsigned char* u = (const unsigned char*)p;
+    unsigned char lo = 0x80, hi = 0xBF;
+    size_t n, i;
+    if (u[0] < 0xC2 || u[0] > 0xF4)
+        return NULL; /* continuation, overlong two-byte lead or above U+10FFFF */
+    n = u[0] < 0xE0 ? 1 : u[0] < 0xF0 ? 2 : 3;
+    switch (u[0]) {
+        case 0xE0: lo = 0xA0; break; /* overlong */
+        case 0xED: hi = 0x9F; break; /* surrogate */
+        case 0xF0: lo = 0x90; break; /* overlong */
+        case 0xF4: hi = 0x8F; break; /* above U+10FFFF */
+    }
+    for (i = 1; i <= n; i++, lo = 0x80, hi = 0xBF) {
+        if (p + i == end)
+            return p;
+        if (u[i] < lo || u[i] > hi)
+            return NULL;
+    }
+    return p + i;
+}
+
+#if defined(LEPT_AVX2)
+#define LEPT_UTF8_TOO_SHORT  0x01 /* lead without a continuation */
+#define LEPT_UTF8_TOO_LONG   0x02 /* continuation after ASCII */
+#define LEPT_UTF8_OVERLONG_3 0x04
+#define LEPT_UTF8_TOO_LARGE  0x08 /* above U+10FFFF */
+#define LEPT_UTF8_SURROGATE  0x10
+#define LEPT_UTF8_OVERLONG_2 0x20
+#define LEPT_UTF8_OVERLONG_4 0x40 /* also F5..F7 followed by 1000____ */
+#define LEPT_UTF8_TWO_CONTS  0x80 /* continuation after a continuation, valid only as third or fourth byte */
+#define LEPT_UTF8_CARRY (LEPT_UTF8_TOO_SHORT | LEPT_UTF8_TOO_LONG | LEPT_UTF8_TWO_CONTS)
+
+/* Error bits by the high nibble of a byte */
+static const unsigned char lept_utf8_first_high[16] = {
+    LEPT_UTF8_TOO_LONG, LEPT_UTF8_TOO_LONG, LEPT_UTF8_TOO_LONG, LEPT_UTF8_TOO_LONG,
+    LEPT_UTF8_TOO_LONG, LEPT_UTF8_TOO_LONG, LEPT_UTF8_TOO_LONG, LEPT_UTF8_TOO_LONG,
+    LEPT_UTF8_TWO_CONTS, LEPT_UTF8_TWO_CONTS, LEPT_UTF8_TWO_CONTS, LEPT_UTF8_TWO_CONTS,
+    LEPT_UTF8_TOO_SHORT | LEPT_UTF8_OVERLONG_2,
+    LEPT_UTF8_TOO_SHORT,
+    LEPT_UTF8_TOO_SHORT | LEPT_UTF8_OVERLONG_3 | LEPT_UTF8_SURROGATE,
+    LEPT_UTF8_TOO_SHORT | LEPT_UTF8_TOO_LARGE | LEPT_UTF8_OVERLONG_4
+};
+
+/* by its low nibble */
+static const unsigned char lept_utf8_first_low[16] = {
+    LEPT_UTF8_CARRY | LEPT_UTF8_OVERLONG_2 | LEPT_UTF8_OVERLONG_3 | LEPT_UTF8_OVERLONG_4,
+    LEPT_UTF8_CARRY | LEPT_UTF8_OVERLONG_2,
+    LEPT_UTF8_CARRY,
+    LEPT_UTF8_CARRY,
+    LEPT_UTF8_CARRY | LEPT_UTF8_TOO_LARGE,
+    LEPT_UTF8_CARRY | LEPT_UTF8_TOO_LARGE | LEPT_UTF8_OVERLONG_4,
+    LEPT_UTF8_CARRY | LEPT_UTF8_TOO_LARGE | LEPT_UTF8_OVERLONG_4,
+    LEPT_UTF8_CARRY | LEPT_UTF8_TOO_LARGE | LEPT_UTF8_OVERLONG_4,
+    LEPT_UTF8_CARRY | LEPT_UTF8_TOO_LARGE | LEPT_UTF8_OVERLONG_4,
+    LEPT_UTF8_CARRY | LEPT_UTF8_TOO_LARGE | LEPT_UTF8_OVERLONG_4,
+    LEPT_UTF8_CARRY | LEPT_UTF8_TOO_LARGE | LEPT_UTF8_OVERLONG_4,
+    LEPT_UTF8_CARRY | LEPT_UTF8_TOO_LARGE | LEPT_UTF8_OVERLONG_4,
+    LEPT_UTF8_CARRY | LEPT_UTF8_TOO_LARGE | LEPT_UTF8_OVERLONG_4,
+    LEPT_UTF8_CARRY | LEPT_UTF8_TOO_LARGE | LEPT_UTF8_OVERLONG_4 | LEPT_UTF8_SURROGATE,
+    LEPT_UTF8_CARRY | LEPT_UTF8_TOO_LARGE | LEPT_UTF8_OVERLONG_4,
+    LEPT_UTF8_CARRY | LEPT_UTF8_TOO_LARGE | LEPT_UTF8_OVERLONG_4
+};
+
+/* and by the high nibble of the byte after it, a pair is bad when all three share a bit */
+static const unsigned char lept_utf8_second_high[16] = {
+    LEPT_UTF8_TOO_SHORT, LEPT_UTF8_TOO_SHORT, LEPT_UTF8_TOO_SHORT, LEPT_UTF8_TOO_SHORT,
+    LEPT_UTF8_TOO_SHORT, LEPT_UTF8_TOO_SHORT, LEPT_UTF8_TOO_SHORT, LEPT_UTF8_TOO_SHORT,
+    LEPT_UTF8_TOO_LONG | LEPT_UTF8_OVERLONG_2 | LEPT_UTF8_TWO_CONTS | LEPT_UTF8_OVERLONG_3 | LEPT_UTF8_OVERLONG_4,
+    LEPT_UTF8_TOO_LONG | LEPT_UTF8_OVERLONG_2 | LEPT_UTF8_TWO_CONTS | LEPT_UTF8_OVERLONG_3 | LEPT_UTF8_TOO_LARGE,
+    LEPT_UTF8_TOO_LONG | LEPT_UTF8_OVERLONG_2 | LEPT_UTF8_TWO_CONTS | LEPT_UTF8_SURROGATE | LEPT_UTF8_TOO_LARGE,
+    LEPT_UTF8_TOO_LONG | LEPT_UTF8_OVERLONG_2 | LEPT_UTF8_TWO_CONTS | LEPT_UTF8_SURROGATE | LEPT_UTF8_TOO_LARGE,
+    LEPT_UTF8_TOO_SHORT, LEPT_UTF8_TOO_SHORT, LEPT_UTF8_TOO_SHORT, LEPT_UTF8_TOO_SHORT
+};
+
+static __m256i lept_utf8_table(const unsigned char* t) {
+    return _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)t));
+}
+#endif
+
+/* Check [p, end) and return where a sequence cut by end starts, end when none is, or NULL when it is not UTF-8 */
+static const char* lept_utf8_check(const char* p, const char* end) {
+    const char* q, * r;
+#if defined(LEPT_AVX2)
+    {
+        const __m256i low = _mm256_set1_epi8(0x0F);
+        const __m256i first_high = lept_utf8_table(lept_utf8_first_high);
+        const __m256i first_low = lept_utf8_table(lept_utf8_first_low);
+        const __m256i second_high = lept_utf8_table(lept_utf8_second_high);
+        const __m256i third = _mm256_set1_epi8(0xE0 - 0x80), fourth = _mm256_set1_epi8(0xF0 - 0x80);
+        /* a lead in one of the last three bytes whose sequence goes on into the next block */
+        const __m256i cut_max = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, (char)0xEF, (char)0xDF, (char)0xBF);
+        __m256i prev = _mm256_setzero_si256(), error = prev, cut = prev;
+        for (; end - p >= 32; p += 32) {
+            const __m256i s = _mm256_loadu_si256((const __m256i*)p);
+            if (_mm256_movemask_epi8(s) == 0) {
+                error = _mm256_or_si256(error, cut);
+                cut = _mm256_setzero_si256();
+            }
+            else {
+                __m256i t = _mm256_permute2x128_si256(prev, s, 0x21), prev1 = _mm256_alignr_epi8(s, t, 15), e;
+                e = _mm256_shuffle_epi8(first_high, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low));
+                e = _mm256_and_si256(e, _mm256_shuffle_epi8(first_low, _mm256_and_si256(prev1, low)));
+                e = _mm256_and_si256(e, _mm256_shuffle_epi8(second_high, _mm256_and_si256(_mm256_srli_epi16(s, 4), low)));
+                /* the top bit is set where a lead two or three bytes back needs a continuation */
+                t = _mm256_or_si256(_mm256_subs_epu8(_mm256_alignr_epi8(s, t, 14), third),
+                    _mm256_subs_epu8(_mm256_alignr_epi8(s, t, 13), fourth));
+                e = _mm256_xor_si256(e, _mm256_and_si256(t, _mm256_set1_epi8((char)0x80)));
+                error = _mm256_or_si256(error, e);
+                cut = _mm256_subs_epu8(s, cut_max);
+            }
+            prev = s;
+        }
+        if (!_mm256_testz_si256(error, error))
+            return NULL;
+        if (!_mm256_testz_si256(cut, cut)) /* go back to that lead, the rest is done below */
+            while ((*--p & 0xC0) != 0xC0)
+                ;
+    }
+#endif
+    while (p != end) {
+#if defined(LEPT_SSE2)
+        while (end - p >= 16 && _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)p)) == 0)
+            p += 16;
+#else
+        {
+            uint64_t w;
+            while (end - p >= 8 && (memcpy(&w, p, 8), (w & UINT64_C(0x8080808080808080)) == 0))
+                p += 8;
+        }
+#endif
+        for (q = end - p > 16 ? p + 16 : end; p < q; )
+            if ((unsigned char)*p < 0x80)
+                p++;
+            else if ((r = lept_utf8_sequence(p, end)) == NULL || r == p)
+                return r;
+            else
+                p = r;
+    }
+    return p;
+}
+
+static void lept_parse_whitespace(lept_context* c) {
+    c->json = lept_skip_whitespace(c->json, c->end);
+}
+
+/*
+ * The dispatch has already matched the first character, so the last four are one 32-bit compare:
+ * "true", "null" and "alse". With a constant literal the compiler folds its load into an immediate.
+ */
+static int lept_match_literal(const char* p, const char* end, const char* literal, size_t len) {
+    uint32_t a, b;
+    assert(len == 4 || len == 5);
+    if ((size_t)(end - p) < len)
+        return 0;
+    memcpy(&a, p + len - 4, 4);
+    memcpy(&b, literal + len - 4, 4);
+    return a == b;
+}
+
+static int lept_parse_literal(lept_context* c, lept_value* v, const char* literal, size_t len, lept_type type) {
+    assert(c->json != c->end && *c->json == literal[0]);
+    if (!lept_match_literal(c->json, c->end, literal, len))
+        return LEPT_PARSE_INVALID_VALUE;
+    c->json += len;
     v->type = type;
     return LEPT_PARSE_OK;
 }
 
+/*
+ * Numbers are converted while their grammar is validated: digits are folded into a 64-bit significand
+ * (8 at a time when possible) and the result is rounded with the Eisel-Lemire algorithm. Only the rare
+ * inputs it cannot decide are handed to strtod(), with the decimal point adjusted to the C locale.
+ */
+#define LEPT_POW5_MIN_EXP (-342)
+#define LEPT_POW5_MAX_EXP 308
+
+/* 128-bit approximations of 5^q for q in [LEPT_POW5_MIN_EXP, LEPT_POW5_MAX_EXP], normalized to the top bit */
+static const uint64_t lept_pow5_128[] = {
+    UINT64_C(0xEEF453D6923BD65A), UINT64_C(0x113FAA2906A13B3F), /* 5^-342 */
+    UINT64_C(0x9558B4661B6565F8), UINT64_C(0x4AC7CA59A424C507), /* 5^-341 */
+    UINT64_C(0xBAAEE17FA23EBF76), UINT64_C(0x5D79BCF00D2DF649), /* 5^-340 */
+    UINT64_C(0xE95A99DF8ACE6F53), UINT64_C(0xF4D82C2C107973DC), /* 5^-339 */
+    UINT64_C(0x91D8A02BB6C10594), UINT64_C(0x79071B9B8A4BE869), /* 5^-338 */
+    UINT64_C(0xB64EC836A47146F9), UINT64_C(0x9748E2826CDEE284), /* 5^-337 */
+    UINT64_C(0xE3E27A444D8D98B7), UINT64_C(0xFD1B1B2308169B25), /* 5^-336 */
+    UINT64_C(0x8E6D8C6AB0787F72), UINT64_C(0xFE30F0F5E50E20F7), /* 5^-335 */
+    UINT64_C(0xB208EF855C969F4F), UINT64_C(0xBDBD2D335E51A935), /* 5^-334 */
+    UINT64_C(0xDE8B2B66B3BC4723), UINT64_C(0xAD2C788035E61382), /* 5^-333 */
+    UINT64_C(0x8B16FB203055AC76), UINT64_C(0x4C3BCB5021AFCC31), /* 5^-332 */
+    UINT64_C(0xADDCB9E83C6B1793), UINT64_C(0xDF4ABE242A1BBF3D), /* 5^-331 */
+    UINT64_C(0xD953E8624B85DD78), UINT64_C(0xD71D6DAD34A2AF0D), /* 5^-330 */
+    UINT64_C(0x87D4713D6F33AA6B), UINT64_C(0x8672648C40E5AD68), /* 5^-329 */
+    UINT64_C(0xA9C98D8CCB009506), UINT64_C(0x680EFDAF511F18C2), /* 5^-328 */
+    UINT64_C(0xD43BF0EFFDC0BA48), UINT64_C(0x0212BD1B2566DEF2), /* 5^-327 */
+    UINT64_C(0x84A57695FE98746D), UINT64_C(0x014BB630F7604B57), /* 5^-326 */
+    UINT64_C(0xA5CED43B7E3E9188), UINT64_C(0x419EA3BD35385E2D), /* 5^-325 */
+    UINT64_C(0xCF42894A5DCE35EA), UINT64_C(0x52064CAC828675B9), /* 5^-324 */
+    UINT64_C(0x818995CE7AA0E1B2), UINT64_C(0x7343EFEBD1940993), /* 5^-323 */
+    UINT64_C(0xA1EBFB4219491A1F), UINT64_C(0x1014EBE6C5F90BF8), /* 5^-322 */
+    UINT64_C(0xCA66FA129F9B60A6), UINT64_C(0xD41A26E077774EF6), /* 5^-321 */
+    UINT64_C(0xFD00B897478238D0), UINT64_C(0x8920B098955522B4), /* 5^-320 */
+    UINT64_C(0x9E20735E8CB16382), UINT64_C(0x55B46E5F5D5535B0), /* 5^-319 */
+    UINT64_C(0xC5A890362FDDBC62), UINT64_C(0xEB2189F734AA831D), /* 5^-318 */
+    UINT64_C(0xF712B443BBD52B7B), UINT64_C(0xA5E9EC7501D523E4), /* 5^-317 */
+    UINT64_C(0x9A6BB0AA55653B2D), UINT64_C(0x47B233C92125366E), /* 5^-316 */
+    UINT64_C(0xC1069CD4EABE89F8), UINT64_C(0x999EC0BB696E840A), /* 5^-315 */
+    UINT64_C(0xF148440A256E2C76), UINT64_C(0xC00670EA43CA250D), /* 5^-314 */
+    UINT64_C(0x96CD2A865764DBCA), UINT64_C(0x380406926A5E5728), /* 5^-313 */
+    UINT64_C(0xBC807527ED3E12BC), UINT64_C(0xC605083704F5ECF2), /* 5^-312 */
+    UINT64_C(0xEBA09271E88D976B), UINT64_C(0xF7864A44C633682E), /* 5^-311 */
+    UINT64_C(0x93445B8731587EA3), UINT64_C(0x7AB3EE6AFBE0211D), /* 5^-310 */
+    UINT64_C(0xB8157268FDAE9E4C), UINT64_C(0x5960EA05BAD82964), /* 5^-309 */
+    UINT64_C(0xE61ACF033D1A45DF), UINT64_C(0x6FB92487298E33BD), /* 5^-308 */
+    UINT64_C(0x8FD0C16206306BAB), UINT64_C(0xA5D3B6D479F8E056), /* 5^-307 */
+    UINT64_C(0xB3C4F1BA87BC8696), UINT64_C(0x8F48A4899877186C), /* 5^-306 */
+    UINT64_C(0xE0B62E2929ABA83C), UINT64_C(0x331ACDABFE94DE87), /* 5^-305 */
+    UINT64_C(0x8C71DCD9BA0B4925), UINT64_C(0x9FF0C08B7F1D0B14), /* 5^-304 */
+    UINT64_C(0xAF8E5410288E1B6F), UINT64_C(0x07ECF0AE5EE44DD9), /* 5^-303 */
+    UINT64_C(0xDB71E91432B1A24A), UINT64_C(0xC9E82CD9F69D6150), /* 5^-302 */
+    UINT64_C(0x892731AC9FAF056E), UINT64_C(0xBE311C083A225CD2), /* 5^-301 */
+    UINT64_C(0xAB70FE17C79AC6CA), UINT64_C(0x6DBD630A48AAF406), /* 5^-300 */
+    UINT64_C(0xD64D3D9DB981787D), UINT64_C(0x092CBBCCDAD5B108), /* 5^-299 */
+    UINT64_C(0x85F0468293F0EB4E), UINT64_C(0x25BBF56008C58EA5), /* 5^-298 */
+    UINT64_C(0xA76C582338ED2621), UINT64_C(0xAF2AF2B80AF6F24E), /* 5^-297 */
+    UINT64_C(0xD1476E2C07286FAA), UINT64_C(0x1AF5AF660DB4AEE1), /* 5^-296 */
+    UINT64_C(0x82CCA4DB847945CA), UINT64_C(0x50D98D9FC890ED4D), /* 5^-295 */
+    UINT64_C(0xA37FCE126597973C), UINT64_C(0xE50FF107BAB528A0), /* 5^-294 */
+    UINT64_C(0xCC5FC196FEFD7D0C), UINT64_C(0x1E53ED49A96272C8), /* 5^-293 */
+    UINT64_C(0xFF77B1FCBEBCDC4F), UINT64_C(0x25E8E89C13BB0F7A), /* 5^-292 */
+    UINT64_C(0x9FAACF3DF73609B1), UINT64_C(0x77B191618C54E9AC), /* 5^-291 */
+    UINT64_C(0xC795830D75038C1D), UINT64_C(0xD59DF5B9EF6A2417), /* 5^-290 */
+    UINT64_C(0xF97AE3D0D2446F25), UINT64_C(0x4B0573286B44AD1D), /* 5^-289 */
+    UINT64_C(0x9BECCE62836AC577), UINT64_C(0x4EE367F9430AEC32), /* 5^-288 */
+    UINT64_C(0xC2E801FB244576D5), UINT64_C(0x229C41F793CDA73F), /* 5^-287 */
+    UINT64_C(0xF3A20279ED56D48A), UINT64_C(0x6B43527578C1110F), /* 5^-286 */
+    UINT64_C(0x9845418C345644D6), UINT64_C(0x830A13896B78AAA9), /* 5^-285 */
+    UINT64_C(0xBE5691EF416BD60C), UINT64_C(0x23CC986BC656D553), /* 5^-284 */
+    UINT64_C(0xEDEC366B11C6CB8F), UINT64_C(0x2CBFBE86B7EC8AA8), /* 5^-283 */
+    UINT64_C(0x94B3A202EB1C3F39), UINT64_C(0x7BF7D71432F3D6A9), /* 5^-282 */
+    UINT64_C(0xB9E08A83A5E34F07), UINT64_C(0xDAF5CCD93FB0CC53), /* 5^-281 */
+    UINT64_C(0xE858AD248F5C22C9), UINT64_C(0xD1B3400F8F9CFF68), /* 5^-280 */
+    UINT64_C(0x91376C36D99995BE), UINT64_C(0x23100809B9C21FA1), /* 5^-279 */
+    UINT64_C(0xB58547448FFFFB2D), UINT64_C(0xABD40A0C2832A78A), /* 5^-278 */
+    UINT64_C(0xE2E69915B3FFF9F9), UINT64_C(0x16C90C8F323F516C), /* 5^-277 */
+    UINT64_C(0x8DD01FAD907FFC3B), UINT64_C(0xAE3DA7D97F6792E3), /* 5^-276 */
+    UINT64_C(0xB1442798F49FFB4A), UINT64_C(0x99CD11CFDF41779C), /* 5^-275 */
+    UINT64_C(0xDD95317F31C7FA1D), UINT64_C(0x40405643D711D583), /* 5^-274 */
+    UINT64_C(0x8A7D3EEF7F1CFC52), UINT64_C(0x482835EA666B2572), /* 5^-273 */
+    UINT64_C(0xAD1C8EAB5EE43B66), UINT64_C(0xDA3243650005EECF), /* 5^-272 */
+    UINT64_C(0xD863B256369D4A40), UINT64_C(0x90BED43E40076A82), /* 5^-271 */
+    UINT64_C(0x873E4F75E2224E68), UINT64_C(0x5A7744A6E804A291), /* 5^-270 */
+    UINT64_C(0xA90DE3535AAAE202), UINT64_C(0x711515D0A205CB36), /* 5^-269 */
+    UINT64_C(0xD3515C2831559A83), UINT64_C(0x0D5A5B44CA873E03), /* 5^-268 */
+    UINT64_C(0x8412D9991ED58091), UINT64_C(0xE858790AFE9486C2), /* 5^-267 */
+    UINT64_C(0xA5178FFF668AE0B6), UINT64_C(0x626E974DBE39A872), /* 5^-266 */
+    UINT64_C(0xCE5D73FF402D98E3), UINT64_C(0xFB0A3D212DC8128F), /* 5^-265 */
+    UINT64_C(0x80FA687F881C7F8E), UINT64_C(0x7CE66634BC9D0B99), /* 5^-264 */
+    UINT64_C(0xA139029F6A239F72), UINT64_C(0x1C1FFFC1EBC44E80), /* 5^-263 */
+    UINT64_C(0xC987434744AC874E), UINT64_C(0xA327FFB266B56220), /* 5^-262 */
+    UINT64_C(0xFBE9141915D7A922), UINT64_C(0x4BF1FF9F0062BAA8), /* 5^-261 */
+    UINT64_C(0x9D71AC8FADA6C9B5), UINT64_C(0x6F773FC3603DB4A9), /* 5^-260 */
+    UINT64_C(0xC4CE17B399107C22), UINT64_C(0xCB550FB4384D21D3), /* 5^-259 */
+    UINT64_C(0xF6019DA07F549B2B), UINT64_C(0x7E2A53A146606A48), /* 5^-258 */
+    UINT64_C(0x99C102844F94E0FB), UINT64_C(0x2EDA7444CBFC426D), /* 5^-257 */
+    UINT64_C(0xC0314325637A1939), UINT64_C(0xFA911155FEFB5308), /* 5^-256 */
+    UINT64_C(0xF03D93EEBC589F88), UINT64_C(0x793555AB7EBA27CA), /* 5^-255 */
+    UINT64_C(0x96267C7535B763B5), UINT64_C(0x4BC1558B2F3458DE), /* 5^-254 */
+    UINT64_C(0xBBB01B9283253CA2), UINT64_C(0x9EB1AAEDFB016F16), /* 5^-253 */
+    UINT64_C(0xEA9C227723EE8BCB), UINT64_C(0x465E15A979C1CADC), /* 5^-252 */
+    UINT64_C(0x92A1958A7675175F), UINT64_C(0x0BFACD89EC191EC9), /* 5^-251 */
+    UINT64_C(0xB749FAED14125D36), UINT64_C(0xCEF980EC671F667B), /* 5^-250 */
+    UINT64_C(0xE51C79A85916F484), UINT64_C(0x82B7E12780E7401A), /* 5^-249 */
+    UINT64_C(0x8F31CC0937AE58D2), UINT64_C(0xD1B2ECB8B0908810), /* 5^-248 */
+    UINT64_C(0xB2FE3F0B8599EF07), UINT64_C(0x861FA7E6DCB4AA15), /* 5^-247 */
+    UINT64_C(0xDFBDCECE67006AC9), UINT64_C(0x67A791E093E1D49A), /* 5^-246 */
+    UINT64_C(0x8BD6A141006042BD), UINT64_C(0xE0C8BB2C5C6D24E0), /* 5^-245 */
+    UINT64_C(0xAECC49914078536D), UINT64_C(0x58FAE9F773886E18), /* 5^-244 */
+    UINT64_C(0xDA7F5BF590966848), UINT64_C(0xAF39A475506A899E), /* 5^-243 */
+    UINT64_C(0x888F99797A5E012D), UINT64_C(0x6D8406C952429603), /* 5^-242 */
+    UINT64_C(0xAAB37FD7D8F58178), UINT64_C(0xC8E5087BA6D33B83), /* 5^-241 */
+    UINT64_C(0xD5605FCDCF32E1D6), UINT64_C(0xFB1E4A9A90880A64), /* 5^-240 */
+    UINT64_C(0x855C3BE0A17FCD26), UINT64_C(0x5CF2EEA09A55067F), /* 5^-239 */
+    UINT64_C(0xA6B34AD8C9DFC06F), UINT64_C(0xF42FAA48C0EA481E), /* 5^-238 */
+    UINT64_C(0xD0601D8EFC57B08B), UINT64_C(0xF13B94DAF124DA26), /* 5^-237 */
+    UINT64_C(0x823C12795DB6CE57), UINT64_C(0x76C53D08D6B70858), /* 5^-236 */
+    UINT64_C(0xA2CB1717B52481ED), UINT64_C(0x54768C4B0C64CA6E), /* 5^-235 */
+    UINT64_C(0xCB7DDCDDA26DA268), UINT64_C(0xA9942F5DCF7DFD09), /* 5^-234 */
+    UINT64_C(0xFE5D54150B090B02), UINT64_C(0xD3F93B35435D7C4C), /* 5^-233 */
+    UINT64_C(0x9EFA548D26E5A6E1), UINT64_C(0xC47BC5014A1A6DAF), /* 5^-232 */
+    UINT64_C(0xC6B8E9B0709F109A), UINT64_C(0x359AB6419CA1091B), /* 5^-231 */
+    UINT64_C(0xF867241C8CC6D4C0), UINT64_C(0xC30163D203C94B62), /* 5^-230 */
+    UINT64_C(0x9B407691D7FC44F8), UINT64_C(0x79E0DE63425DCF1D), /* 5^-229 */
+    UINT64_C(0xC21094364DFB5636), UINT64_C(0x985915FC12F542E4), /* 5^-228 */
+    UINT64_C(0xF294B943E17A2BC4), UINT64_C(0x3E6F5B7B17B2939D), /* 5^-227 */
+    UINT64_C(0x979CF3CA6CEC5B5A), UINT64_C(0xA705992CEECF9C42), /* 5^-226 */
+    UINT64_C(0xBD8430BD08277231), UINT64_C(0x50C6FF782A838353), /* 5^-225 */
+    UINT64_C(0xECE53CEC4A314EBD), UINT64_C(0xA4F8BF5635246428), /* 5^-224 */
+    UINT64_C(0x940F4613AE5ED136), UINT64_C(0x871B7795E136BE99), /* 5^-223 */
+    UINT64_C(0xB913179899F68584), UINT64_C(0x28E2557B59846E3F), /* 5^-222 */
+    UINT64_C(0xE757DD7EC07426E5), UINT64_C(0x331AEADA2FE589CF), /* 5^-221 */
+    UINT64_C(0x9096EA6F3848984F), UINT64_C(0x3FF0D2C85DEF7621), /* 5^-220 */
+    UINT64_C(0xB4BCA50B065ABE63), UINT64_C(0x0FED077A756B53A9), /* 5^-219 */
+    UINT64_C(0xE1EBCE4DC7F16DFB), UINT64_C(0xD3E8495912C62894), /* 5^-218 */
+    UINT64_C(0x8D3360F09CF6E4BD), UINT64_C(0x64712DD7ABBBD95C), /* 5^-217 */
+    UINT64_C(0xB080392CC4349DEC), UINT64_C(0xBD8D794D96AACFB3), /* 5^-216 */
+    UINT64_C(0xDCA04777F541C567), UINT64_C(0xECF0D7A0FC5583A0), /* 5^-215 */
+    UINT64_C(0x89E42CAAF9491B60), UINT64_C(0xF41686C49DB57244), /* 5^-214 */
+    UINT64_C(0xAC5D37D5B79B6239), UINT64_C(0x311C2875C522CED5), /* 5^-213 */
+    UINT64_C(0xD77485CB25823AC7), UINT64_C(0x7D633293366B828B), /* 5^-212 */
+    UINT64_C(0x86A8D39EF77164BC), UINT64_C(0xAE5DFF9C02033197), /* 5^-211 */
+    UINT64_C(0xA8530886B54DBDEB), UINT64_C(0xD9F57F830283FDFC), /* 5^-210 */
+    UINT64_C(0xD267CAA862A12D66), UINT64_C(0xD072DF63C324FD7B), /* 5^-209 */
+    UINT64_C(0x8380DEA93DA4BC60), UINT64_C(0x4247CB9E59F71E6D), /* 5^-208 */
+    UINT64_C(0xA46116538D0DEB78), UINT64_C(0x52D9BE85F074E608), /* 5^-207 */
+    UINT64_C(0xCD795BE870516656), UINT64_C(0x67902E276C921F8B), /* 5^-206 */
+    UINT64_C(0x806BD9714632DFF6), UINT64_C(0x00BA1CD8A3DB53B6), /* 5^-205 */
+    UINT64_C(0xA086CFCD97BF97F3), UINT64_C(0x80E8A40ECCD228A4), /* 5^-204 */
+    UINT64_C(0xC8A883C0FDAF7DF0), UINT64_C(0x6122CD128006B2CD), /* 5^-203 */
+    UINT64_C(0xFAD2A4B13D1B5D6C), UINT64_C(0x796B805720085F81), /* 5^-202 */
+    UINT64_C(0x9CC3A6EEC6311A63), UINT64_C(0xCBE3303674053BB0), /* 5^-201 */
+    UINT64_C(0xC3F490AA77BD60FC), UINT64_C(0xBEDBFC4411068A9C), /* 5^-200 */
+    UINT64_C(0xF4F1B4D515ACB93B), UINT64_C(0xEE92FB5515482D44), /* 5^-199 */
+    UINT64_C(0x991711052D8BF3C5), UINT64_C(0x751BDD152D4D1C4A), /* 5^-198 */
+    UINT64_C(0xBF5CD54678EEF0B6), UINT64_C(0xD262D45A78A0635D), /* 5^-197 */
+    UINT64_C(0xEF340A98172AACE4), UINT64_C(0x86FB897116C87C34), /* 5^-196 */
+    UINT64_C(0x9580869F0E7AAC0E), UINT64_C(0xD45D35E6AE3D4DA0), /* 5^-195 */
+    UINT64_C(0xBAE0A846D2195712), UINT64_C(0x8974836059CCA109), /* 5^-194 */
+    UINT64_C(0xE998D258869FACD7), UINT64_C(0x2BD1A438703FC94B), /* 5^-193 */
+    UINT64_C(0x91FF83775423CC06), UINT64_C(0x7B6306A34627DDCF), /* 5^-192 */
+    UINT64_C(0xB67F6455292CBF08), UINT64_C(0x1A3BC84C17B1D542), /* 5^-191 */
+    UINT64_C(0xE41F3D6A7377EECA), UINT64_C(0x20CABA5F1D9E4A93), /* 5^-190 */
+    UINT64_C(0x8E938662882AF53E), UINT64_C(0x547EB47B7282EE9C), /* 5^-189 */
+    UINT64_C(0xB23867FB2A35B28D), UINT64_C(0xE99E619A4F23AA43), /* 5^-188 */
+    UINT64_C(0xDEC681F9F4C31F31), UINT64_C(0x6405FA00E2EC94D4), /* 5^-187 */
+    UINT64_C(0x8B3C113C38F9F37E), UINT64_C(0xDE83BC408DD3DD04), /* 5^-186 */
+    UINT64_C(0xAE0B158B4738705E), UINT64_C(0x9624AB50B148D445), /* 5^-185 */
+    UINT64_C(0xD98DDAEE19068C76), UINT64_C(0x3BADD624DD9B0957), /* 5^-184 */
+    UINT64_C(0x87F8A8D4CFA417C9), UINT64_C(0xE54CA5D70A80E5D6), /* 5^-183 */
+    UINT64_C(0xA9F6D30A038D1DBC), UINT64_C(0x5E9FCF4CCD211F4C), /* 5^-182 */
+    UINT64_C(0xD47487CC8470652B), UINT64_C(0x7647C3200069671F), /* 5^-181 */
+    UINT64_C(0x84C8D4DFD2C63F3B), UINT64_C(0x29ECD9F40041E073), /* 5^-180 */
+    UINT64_C(0xA5FB0A17C777CF09), UINT64_C(0xF468107100525890), /* 5^-179 */
+    UINT64_C(0xCF79CC9DB955C2CC), UINT64_C(0x7182148D4066EEB4), /* 5^-178 */
+    UINT64_C(0x81AC1FE293D599BF), UINT64_C(0xC6F14CD848405530), /* 5^-177 */
+    UINT64_C(0xA21727DB38CB002F), UINT64_C(0xB8ADA00E5A506A7C), /* 5^-176 */
+    UINT64_C(0xCA9CF1D206FDC03B), UINT64_C(0xA6D90811F0E4851C), /* 5^-175 */
+    UINT64_C(0xFD442E4688BD304A), UINT64_C(0x908F4A166D1DA663), /* 5^-174 */
+    UINT64_C(0x9E4A9CEC15763E2E), UINT64_C(0x9A598E4E043287FE), /* 5^-173 */
+    UINT64_C(0xC5DD44271AD3CDBA), UINT64_C(0x40EFF1E1853F29FD), /* 5^-172 */
+    UINT64_C(0xF7549530E188C128), UINT64_C(0xD12BEE59E68EF47C), /* 5^-171 */
+    UINT64_C(0x9A94DD3E8CF578B9), UINT64_C(0x82BB74F8301958CE), /* 5^-170 */
+    UINT64_C(0xC13A148E3032D6E7), UINT64_C(0xE36A52363C1FAF01), /* 5^-169 */
+    UINT64_C(0xF18899B1BC3F8CA1), UINT64_C(0xDC44E6C3CB279AC1), /* 5^-168 */
+    UINT64_C(0x96F5600F15A7B7E5), UINT64_C(0x29AB103A5EF8C0B9), /* 5^-167 */
+    UINT64_C(0xBCB2B812DB11A5DE), UINT64_C(0x7415D448F6B6F0E7), /* 5^-166 */
+    UINT64_C(0xEBDF661791D60F56), UINT64_C(0x111B495B3464AD21), /* 5^-165 */
+    UINT64_C(0x936B9FCEBB25C995), UINT64_C(0xCAB10DD900BEEC34), /* 5^-164 */
+    UINT64_C(0xB84687C269EF3BFB), UINT64_C(0x3D5D514F40EEA742), /* 5^-163 */
+    UINT64_C(0xE65829B3046B0AFA), UINT64_C(0x0CB4A5A3112A5112), /* 5^-162 */
+    UINT64_C(0x8FF71A0FE2C2E6DC), UINT64_C(0x47F0E785EABA72AB), /* 5^-161 */
+    UINT64_C(0xB3F4E093DB73A093), UINT64_C(0x59ED216765690F56), /* 5^-160 */
+    UINT64_C(0xE0F218B8D25088B8), UINT64_C(0x306869C13EC3532C), /* 5^-159 */
+    UINT64_C(0x8C974F7383725573), UINT64_C(0x1E414218C73A13FB), /* 5^-158 */
+    UINT64_C(0xAFBD2350644EEACF), UINT64_C(0xE5D1929EF90898FA), /* 5^-157 */
+    UINT64_C(0xDBAC6C247D62A583), UINT64_C(0xDF45F746B74ABF39), /* 5^-156 */
+    UINT64_C(0x894BC396CE5DA772), UINT64_C(0x6B8BBA8C328EB783), /* 5^-155 */
+    UINT64_C(0xAB9EB47C81F5114F), UINT64_C(0x066EA92F3F326564), /* 5^-154 */
+    UINT64_C(0xD686619BA27255A2), UINT64_C(0xC80A537B0EFEFEBD), /* 5^-153 */
+    UINT64_C(0x8613FD0145877585), UINT64_C(0xBD06742CE95F5F36), /* 5^-152 */
+    UINT64_C(0xA798FC4196E952E7), UINT64_C(0x2C48113823B73704), /* 5^-151 */
+    UINT64_C(0xD17F3B51FCA3A7A0), UINT64_C(0xF75A15862CA504C5), /* 5^-150 */
+    UINT64_C(0x82EF85133DE648C4), UINT64_C(0x9A984D73DBE722FB), /* 5^-149 */
+    UINT64_C(0xA3AB66580D5FDAF5), UINT64_C(0xC13E60D0D2E0EBBA), /* 5^-148 */
+    UINT64_C(0xCC963FEE10B7D1B3), UINT64_C(0x318DF905079926A8), /* 5^-147 */
+    UINT64_C(0xFFBBCFE994E5C61F), UINT64_C(0xFDF17746497F7052), /* 5^-146 */
+    UINT64_C(0x9FD561F1FD0F9BD3), UINT64_C(0xFEB6EA8BEDEFA633), /* 5^-145 */
+    UINT64_C(0xC7CABA6E7C5382C8), UINT64_C(0xFE64A52EE96B8FC0), /* 5^-144 */
+    UINT64_C(0xF9BD690A1B68637B), UINT64_C(0x3DFDCE7AA3C673B0), /* 5^-143 */
+    UINT64_C(0x9C1661A651213E2D), UINT64_C(0x06BEA10CA65C084E), /* 5^-142 */
+    UINT64_C(0xC31BFA0FE5698DB8), UINT64_C(0x486E494FCFF30A62), /* 5^-141 */
+    UINT64_C(0xF3E2F893DEC3F126), UINT64_C(0x5A89DBA3C3EFCCFA), /* 5^-140 */
+    UINT64_C(0x986DDB5C6B3A76B7), UINT64_C(0xF89629465A75E01C), /* 5^-139 */
+    UINT64_C(0xBE89523386091465), UINT64_C(0xF6BBB397F1135823), /* 5^-138 */
+    UINT64_C(0xEE2BA6C0678B597F), UINT64_C(0x746AA07DED582E2C), /* 5^-137 */
+    UINT64_C(0x94DB483840B717EF), UINT64_C(0xA8C2A44EB4571CDC), /* 5^-136 */
+    UINT64_C(0xBA121A4650E4DDEB), UINT64_C(0x92F34D62616CE413), /* 5^-135 */
+    UINT64_C(0xE896A0D7E51E1566), UINT64_C(0x77B020BAF9C81D17), /* 5^-134 */
+    UINT64_C(0x915E2486EF32CD60), UINT64_C(0x0ACE1474DC1D122E), /* 5^-133 */
+    UINT64_C(0xB5B5ADA8AAFF80B8), UINT64_C(0x0D819992132456BA), /* 5^-132 */
+    UINT64_C(0xE3231912D5BF60E6), UINT64_C(0x10E1FFF697ED6C69), /* 5^-131 */
+    UINT64_C(0x8DF5EFABC5979C8F), UINT64_C(0xCA8D3FFA1EF463C1), /* 5^-130 */
+    UINT64_C(0xB1736B96B6FD83B3), UINT64_C(0xBD308FF8A6B17CB2), /* 5^-129 */
+    UINT64_C(0xDDD0467C64BCE4A0), UINT64_C(0xAC7CB3F6D05DDBDE), /* 5^-128 */
+    UINT64_C(0x8AA22C0DBEF60EE4), UINT64_C(0x6BCDF07A423AA96B), /* 5^-127 */
+    UINT64_C(0xAD4AB7112EB3929D), UINT64_C(0x86C16C98D2C953C6), /* 5^-126 */
+    UINT64_C(0xD89D64D57A607744), UINT64_C(0xE871C7BF077BA8B7), /* 5^-125 */
+    UINT64_C(0x87625F056C7C4A8B), UINT64_C(0x11471CD764AD4972), /* 5^-124 */
+    UINT64_C(0xA93AF6C6C79B5D2D), UINT64_C(0xD598E40D3DD89BCF), /* 5^-123 */
+    UINT64_C(0xD389B47879823479), UINT64_C(0x4AFF1D108D4EC2C3), /* 5^-122 */
+    UINT64_C(0x843610CB4BF160CB), UINT64_C(0xCEDF722A585139BA), /* 5^-121 */
+    UINT64_C(0xA54394FE1EEDB8FE), UINT64_C(0xC2974EB4EE658828), /* 5^-120 */
+    UINT64_C(0xCE947A3DA6A9273E), UINT64_C(0x733D226229FEEA32), /* 5^-119 */
+    UINT64_C(0x811CCC668829B887), UINT64_C(0x0806357D5A3F525F), /* 5^-118 */
+    UINT64_C(0xA163FF802A3426A8), UINT64_C(0xCA07C2DCB0CF26F7), /* 5^-117 */
+    UINT64_C(0xC9BCFF6034C13052), UINT64_C(0xFC89B393DD02F0B5), /* 5^-116 */
+    UINT64_C(0xFC2C3F3841F17C67), UINT64_C(0xBBAC2078D443ACE2), /* 5^-115 */
+    UINT64_C(0x9D9BA7832936EDC0), UINT64_C(0xD54B944B84AA4C0D), /* 5^-114 */
+    UINT64_C(0xC5029163F384A931), UINT64_C(0x0A9E795E65D4DF11), /* 5^-113 */
+    UINT64_C(0xF64335BCF065D37D), UINT64_C(0x4D4617B5FF4A16D5), /* 5^-112 */
+    UINT64_C(0x99EA0196163FA42E), UINT64_C(0x504BCED1BF8E4E45), /* 5^-111 */
+    UINT64_C(0xC06481FB9BCF8D39), UINT64_C(0xE45EC2862F71E1D6), /* 5^-110 */
+    UINT64_C(0xF07DA27A82C37088), UINT64_C(0x5D767327BB4E5A4C), /* 5^-109 */
+    UINT64_C(0x964E858C91BA2655), UINT64_C(0x3A6A07F8D510F86F), /* 5^-108 */
+    UINT64_C(0xBBE226EFB628AFEA), UINT64_C(0x890489F70A55368B), /* 5^-107 */
+    UINT64_C(0xEADAB0ABA3B2DBE5), UINT64_C(0x2B45AC74CCEA842E), /* 5^-106 */
+    UINT64_C(0x92C8AE6B464FC96F), UINT64_C(0x3B0B8BC90012929D), /* 5^-105 */
+    UINT64_C(0xB77ADA0617E3BBCB), UINT64_C(0x09CE6EBB40173744), /* 5^-104 */
+    UINT64_C(0xE55990879DDCAABD), UINT64_C(0xCC420A6A101D0515), /* 5^-103 */
+    UINT64_C(0x8F57FA54C2A9EAB6), UINT64_C(0x9FA946824A12232D), /* 5^-102 */
+    UINT64_C(0xB32DF8E9F3546564), UINT64_C(0x47939822DC96ABF9), /* 5^-101 */
+    UINT64_C(0xDFF9772470297EBD), UINT64_C(0x59787E2B93BC56F7), /* 5^-100 */
+    UINT64_C(0x8BFBEA76C619EF36), UINT64_C(0x57EB4EDB3C55B65A), /* 5^-99 */
+    UINT64_C(0xAEFAE51477A06B03), UINT64_C(0xEDE622920B6B23F1), /* 5^-98 */
+    UINT64_C(0xDAB99E59958885C4), UINT64_C(0xE95FAB368E45ECED), /* 5^-97 */
+    UINT64_C(0x88B402F7FD75539B), UINT64_C(0x11DBCB0218EBB414), /* 5^-96 */
+    UINT64_C(0xAAE103B5FCD2A881), UINT64_C(0xD652BDC29F26A119), /* 5^-95 */
+    UINT64_C(0xD59944A37C0752A2), UINT64_C(0x4BE76D3346F0495F), /* 5^-94 */
+    UINT64_C(0x857FCAE62D8493A5), UINT64_C(0x6F70A4400C562DDB), /* 5^-93 */
+    UINT64_C(0xA6DFBD9FB8E5B88E), UINT64_C(0xCB4CCD500F6BB952), /* 5^-92 */
+    UINT64_C(0xD097AD07A71F26B2), UINT64_C(0x7E2000A41346A7A7), /* 5^-91 */
+    UINT64_C(0x825ECC24C873782F), UINT64_C(0x8ED400668C0C28C8), /* 5^-90 */
+    UINT64_C(0xA2F67F2DFA90563B), UINT64_C(0x728900802F0F32FA), /* 5^-89 */
+    UINT64_C(0xCBB41EF979346BCA), UINT64_C(0x4F2B40A03AD2FFB9), /* 5^-88 */
+    UINT64_C(0xFEA126B7D78186BC), UINT64_C(0xE2F610C84987BFA8), /* 5^-87 */
+    UINT64_C(0x9F24B832E6B0F436), UINT64_C(0x0DD9CA7D2DF4D7C9), /* 5^-86 */
+    UINT64_C(0xC6EDE63FA05D3143), UINT64_C(0x91503D1C79720DBB), /* 5^-85 */
+    UINT64_C(0xF8A95FCF88747D94), UINT64_C(0x75A44C6397CE912A), /* 5^-84 */
+    UINT64_C(0x9B69DBE1B548CE7C), UINT64_C(0xC986AFBE3EE11ABA), /* 5^-83 */
+    UINT64_C(0xC24452DA229B021B), UINT64_C(0xFBE85BADCE996168), /* 5^-82 */
+    UINT64_C(0xF2D56790AB41C2A2), UINT64_C(0xFAE27299423FB9C3), /* 5^-81 */
+    UINT64_C(0x97C560BA6B0919A5), UINT64_C(0xDCCD879FC967D41A), /* 5^-80 */
+    UINT64_C(0xBDB6B8E905CB600F), UINT64_C(0x5400E987BBC1C920), /* 5^-79 */
+    UINT64_C(0xED246723473E3813), UINT64_C(0x290123E9AAB23B68), /* 5^-78 */
+    UINT64_C(0x9436C0760C86E30B), UINT64_C(0xF9A0B6720AAF6521), /* 5^-77 */
+    UINT64_C(0xB94470938FA89BCE), UINT64_C(0xF808E40E8D5B3E69), /* 5^-76 */
+    UINT64_C(0xE7958CB87392C2C2), UINT64_C(0xB60B1D1230B20E04), /* 5^-75 */
+    UINT64_C(0x90BD77F3483BB9B9), UINT64_C(0xB1C6F22B5E6F48C2), /* 5^-74 */
+    UINT64_C(0xB4ECD5F01A4AA828), UINT64_C(0x1E38AEB6360B1AF3), /* 5^-73 */
+    UINT64_C(0xE2280B6C20DD5232), UINT64_C(0x25C6DA63C38DE1B0), /* 5^-72 */
+    UINT64_C(0x8D590723948A535F), UINT64_C(0x579C487E5A38AD0E), /* 5^-71 */
+    UINT64_C(0xB0AF48EC79ACE837), UINT64_C(0x2D835A9DF0C6D851), /* 5^-70 */
+    UINT64_C(0xDCDB1B2798182244), UINT64_C(0xF8E431456CF88E65), /* 5^-69 */
+    UINT64_C(0x8A08F0F8BF0F156B), UINT64_C(0x1B8E9ECB641B58FF), /* 5^-68 */
+    UINT64_C(0xAC8B2D36EED2DAC5), UINT64_C(0xE272467E3D222F3F), /* 5^-67 */
+    UINT64_C(0xD7ADF884AA879177), UINT64_C(0x5B0ED81DCC6ABB0F), /* 5^-66 */
+    UINT64_C(0x86CCBB52EA94BAEA), UINT64_C(0x98E947129FC2B4E9), /* 5^-65 */
+    UINT64_C(0xA87FEA27A539E9A5), UINT64_C(0x3F2398D747B36224), /* 5^-64 */
+    UINT64_C(0xD29FE4B18E88640E), UINT64_C(0x8EEC7F0D19A03AAD), /* 5^-63 */
+    UINT64_C(0x83A3EEEEF9153E89), UINT64_C(0x1953CF68300424AC), /* 5^-62 */
+    UINT64_C(0xA48CEAAAB75A8E2B), UINT64_C(0x5FA8C3423C052DD7), /* 5^-61 */
+    UINT64_C(0xCDB02555653131B6), UINT64_C(0x3792F412CB06794D), /* 5^-60 */
+    UINT64_C(0x808E17555F3EBF11), UINT64_C(0xE2BBD88BBEE40BD0), /* 5^-59 */
+    UINT64_C(0xA0B19D2AB70E6ED6), UINT64_C(0x5B6ACEAEAE9D0EC4), /* 5^-58 */
+    UINT64_C(0xC8DE047564D20A8B), UINT64_C(0xF245825A5A445275), /* 5^-57 */
+    UINT64_C(0xFB158592BE068D2E), UINT64_C(0xEED6E2F0F0D56712), /* 5^-56 */
+    UINT64_C(0x9CED737BB6C4183D), UINT64_C(0x55464DD69685606B), /* 5^-55 */
+    UINT64_C(0xC428D05AA4751E4C), UINT64_C(0xAA97E14C3C26B886), /* 5^-54 */
+    UINT64_C(0xF53304714D9265DF), UINT64_C(0xD53DD99F4B3066A8), /* 5^-53 */
+    UINT64_C(0x993FE2C6D07B7FAB), UINT64_C(0xE546A8038EFE4029), /* 5^-52 */
+    UINT64_C(0xBF8FDB78849A5F96), UINT64_C(0xDE98520472BDD033), /* 5^-51 */
+    UINT64_C(0xEF73D256A5C0F77C), UINT64_C(0x963E66858F6D4440), /* 5^-50 */
+    UINT64_C(0x95A8637627989AAD), UINT64_C(0xDDE7001379A44AA8), /* 5^-49 */
+    UINT64_C(0xBB127C53B17EC159), UINT64_C(0x5560C018580D5D52), /* 5^-48 */
+    UINT64_C(0xE9D71B689DDE71AF), UINT64_C(0xAAB8F01E6E10B4A6), /* 5^-47 */
+    UINT64_C(0x9226712162AB070D), UINT64_C(0xCAB3961304CA70E8), /* 5^-46 */
+    UINT64_C(0xB6B00D69BB55C8D1), UINT64_C(0x3D607B97C5FD0D22), /* 5^-45 */
+    UINT64_C(0xE45C10C42A2B3B05), UINT64_C(0x8CB89A7DB77C506A), /* 5^-44 */
+    UINT64_C(0x8EB98A7A9A5B04E3), UINT64_C(0x77F3608E92ADB242), /* 5^-43 */
+    UINT64_C(0xB267ED1940F1C61C), UINT64_C(0x55F038B237591ED3), /* 5^-42 */
+    UINT64_C(0xDF01E85F912E37A3), UINT64_C(0x6B6C46DEC52F6688), /* 5^-41 */
+    UINT64_C(0x8B61313BBABCE2C6), UINT64_C(0x2323AC4B3B3DA015), /* 5^-40 */
+    UINT64_C(0xAE397D8AA96C1B77), UINT64_C(0xABEC975E0A0D081A), /* 5^-39 */
+    UINT64_C(0xD9C7DCED53C72255), UINT64_C(0x96E7BD358C904A21), /* 5^-38 */
+    UINT64_C(0x881CEA14545C7575), UINT64_C(0x7E50D64177DA2E54), /* 5^-37 */
+    UINT64_C(0xAA242499697392D2), UINT64_C(0xDDE50BD1D5D0B9E9), /* 5^-36 */
+    UINT64_C(0xD4AD2DBFC3D07787), UINT64_C(0x955E4EC64B44E864), /* 5^-35 */
+    UINT64_C(0x84EC3C97DA624AB4), UINT64_C(0xBD5AF13BEF0B113E), /* 5^-34 */
+    UINT64_C(0xA6274BBDD0FADD61), UINT64_C(0xECB1AD8AEACDD58E), /* 5^-33 */
+    UINT64_C(0xCFB11EAD453994BA), UINT64_C(0x67DE18EDA5814AF2), /* 5^-32 */
+    UINT64_C(0x81CEB32C4B43FCF4), UINT64_C(0x80EACF948770CED7), /* 5^-31 */
+    UINT64_C(0xA2425FF75E14FC31), UINT64_C(0xA1258379A94D028D), /* 5^-30 */
+    UINT64_C(0xCAD2F7F5359A3B3E), UINT64_C(0x096EE45813A04330), /* 5^-29 */
+    UINT64_C(0xFD87B5F28300CA0D), UINT64_C(0x8BCA9D6E188853FC), /* 5^-28 */
+    UINT64_C(0x9E74D1B791E07E48), UINT64_C(0x775EA264CF55347E), /* 5^-27 */
+    UINT64_C(0xC612062576589DDA), UINT64_C(0x95364AFE032A819E), /* 5^-26 */
+    UINT64_C(0xF79687AED3EEC551), UINT64_C(0x3A83DDBD83F52205), /* 5^-25 */
+    UINT64_C(0x9ABE14CD44753B52), UINT64_C(0xC4926A9672793543), /* 5^-24 */
+    UINT64_C(0xC16D9A0095928A27), UINT64_C(0x75B7053C0F178294), /* 5^-23 */
+    UINT64_C(0xF1C90080BAF72CB1), UINT64_C(0x5324C68B12DD6339), /* 5^-22 */
+    UINT64_C(0x971DA05074DA7BEE), UINT64_C(0xD3F6FC16EBCA5E04), /* 5^-21 */
+    UINT64_C(0xBCE5086492111AEA), UINT64_C(0x88F4BB1CA6BCF585), /* 5^-20 */
+    UINT64_C(0xEC1E4A7DB69561A5), UINT64_C(0x2B31E9E3D06C32E6), /* 5^-19 */
+    UINT64_C(0x9392EE8E921D5D07), UINT64_C(0x3AFF322E62439FD0), /* 5^-18 */
+    UINT64_C(0xB877AA3236A4B449), UINT64_C(0x09BEFEB9FAD487C3), /* 5^-17 */
+    UINT64_C(0xE69594BEC44DE15B), UINT64_C(0x4C2EBE687989A9B4), /* 5^-16 */
+    UINT64_C(0x901D7CF73AB0ACD9), UINT64_C(0x0F9D37014BF60A11), /* 5^-15 */
+    UINT64_C(0xB424DC35095CD80F), UINT64_C(0x538484C19EF38C95), /* 5^-14 */
+    UINT64_C(0xE12E13424BB40E13), UINT64_C(0x2865A5F206B06FBA), /* 5^-13 */
+    UINT64_C(0x8CBCCC096F5088CB), UINT64_C(0xF93F87B7442E45D4), /* 5^-12 */
+    UINT64_C(0xAFEBFF0BCB24AAFE), UINT64_C(0xF78F69A51539D749), /* 5^-11 */
+    UINT64_C(0xDBE6FECEBDEDD5BE), UINT64_C(0xB573440E5A884D1C), /* 5^-10 */
+    UINT64_C(0x89705F4136B4A597), UINT64_C(0x31680A88F8953031), /* 5^-9 */
+    UINT64_C(0xABCC77118461CEFC), UINT64_C(0xFDC20D2B36BA7C3E), /* 5^-8 */
+    UINT64_C(0xD6BF94D5E57A42BC), UINT64_C(0x3D32907604691B4D), /* 5^-7 */
+    UINT64_C(0x8637BD05AF6C69B5), UINT64_C(0xA63F9A49C2C1B110), /* 5^-6 */
+    UINT64_C(0xA7C5AC471B478423), UINT64_C(0x0FCF80DC33721D54), /* 5^-5 */
+    UINT64_C(0xD1B71758E219652B), UINT64_C(0xD3C36113404EA4A9), /* 5^-4 */
+    UINT64_C(0x83126E978D4FDF3B), UINT64_C(0x645A1CAC083126EA), /* 5^-3 */
+    UINT64_C(0xA3D70A3D70A3D70A), UINT64_C(0x3D70A3D70A3D70A4), /* 5^-2 */
+    UINT64_C(0xCCCCCCCCCCCCCCCC), UINT64_C(0xCCCCCCCCCCCCCCCD), /* 5^-1 */
+    UINT64_C(0x8000000000000000), UINT64_C(0x0000000000000000), /* 5^0 */
+    UINT64_C(0xA000000000000000), UINT64_C(0x0000000000000000), /* 5^1 */
+    UINT64_C(0xC800000000000000), UINT64_C(0x0000000000000000), /* 5^2 */
+    UINT64_C(0xFA00000000000000), UINT64_C(0x0000000000000000), /* 5^3 */
+    UINT64_C(0x9C40000000000000), UINT64_C(0x0000000000000000), /* 5^4 */
+    UINT64_C(0xC350000000000000), UINT64_C(0x0000000000000000), /* 5^5 */
+    UINT64_C(0xF424000000000000), UINT64_C(0x0000000000000000), /* 5^6 */
+    UINT64_C(0x9896800000000000), UINT64_C(0x0000000000000000), /* 5^7 */
+    UINT64_C(0xBEBC200000000000), UINT64_C(0x0000000000000000), /* 5^8 */
+    UINT64_C(0xEE6B280000000000), UINT64_C(0x0000000000000000), /* 5^9 */
+    UINT64_C(0x9502F90000000000), UINT64_C(0x0000000000000000), /* 5^10 */
+    UINT64_C(0xBA43B74000000000), UINT64_C(0x0000000000000000), /* 5^11 */
+    UINT64_C(0xE8D4A51000000000), UINT64_C(0x0000000000000000), /* 5^12 */
+    UINT64_C(0x9184E72A00000000), UINT64_C(0x0000000000000000), /* 5^13 */
+    UINT64_C(0xB5E620F480000000), UINT64_C(0x0000000000000000), /* 5^14 */
+    UINT64_C(0xE35FA931A0000000), UINT64_C(0x0000000000000000), /* 5^15 */
+    UINT64_C(0x8E1BC9BF04000000), UINT64_C(0x0000000000000000), /* 5^16 */
+    UINT64_C(0xB1A2BC2EC5000000), UINT64_C(0x0000000000000000), /* 5^17 */
+    UINT64_C(0xDE0B6B3A76400000), UINT64_C(0x0000000000000000), /* 5^18 */
+    UINT64_C(0x8AC7230489E80000), UINT64_C(0x0000000000000000), /* 5^19 */
+    UINT64_C(0xAD78EBC5AC620000), UINT64_C(0x0000000000000000), /* 5^20 */
+    UINT64_C(0xD8D726B7177A8000), UINT64_C(0x0000000000000000), /* 5^21 */
+    UINT64_C(0x878678326EAC9000), UINT64_C(0x0000000000000000), /* 5^22 */
+    UINT64_C(0xA968163F0A57B400), UINT64_C(0x0000000000000000), /* 5^23 */
+    UINT64_C(0xD3C21BCECCEDA100), UINT64_C(0x0000000000000000), /* 5^24 */
+    UINT64_C(0x84595161401484A0), UINT64_C(0x0000000000000000), /* 5^25 */
+    UINT64_C(0xA56FA5B99019A5C8), UINT64_C(0x0000000000000000), /* 5^26 */
+    UINT64_C(0xCECB8F27F4200F3A), UINT64_C(0x0000000000000000), /* 5^27 */
+    UINT64_C(0x813F3978F8940984), UINT64_C(0x4000000000000000), /* 5^28 */
+    UINT64_C(0xA18F07D736B90BE5), UINT64_C(0x5000000000000000), /* 5^29 */
+    UINT64_C(0xC9F2C9CD04674EDE), UINT64_C(0xA400000000000000), /* 5^30 */
+    UINT64_C(0xFC6F7C4045812296), UINT64_C(0x4D00000000000000), /* 5^31 */
+    UINT64_C(0x9DC5ADA82B70B59D), UINT64_C(0xF020000000000000), /* 5^32 */
+    UINT64_C(0xC5371912364CE305), UINT64_C(0x6C28000000000000), /* 5^33 */
+    UINT64_C(0xF684DF56C3E01BC6), UINT64_C(0xC732000000000000), /* 5^34 */
+    UINT64_C(0x9A130B963A6C115C), UINT64_C(0x3C7F400000000000), /* 5^35 */
+    UINT64_C(0xC097CE7BC90715B3), UINT64_C(0x4B9F100000000000), /* 5^36 */
+    UINT64_C(0xF0BDC21ABB48DB20), UINT64_C(0x1E86D40000000000), /* 5^37 */
+    UINT64_C(0x96769950B50D88F4), UINT64_C(0x1314448000000000), /* 5^38 */
+    UINT64_C(0xBC143FA4E250EB31), UINT64_C(0x17D955A000000000), /* 5^39 */
+    UINT64_C(0xEB194F8E1AE525FD), UINT64_C(0x5DCFAB0800000000), /* 5^40 */
+    UINT64_C(0x92EFD1B8D0CF37BE), UINT64_C(0x5AA1CAE500000000), /* 5^41 */
+    UINT64_C(0xB7ABC627050305AD), UINT64_C(0xF14A3D9E40000000), /* 5^42 */
+    UINT64_C(0xE596B7B0C643C719), UINT64_C(0x6D9CCD05D0000000), /* 5^43 */
+    UINT64_C(0x8F7E32CE7BEA5C6F), UINT64_C(0xE4820023A2000000), /* 5^44 */
+    UINT64_C(0xB35DBF821AE4F38B), UINT64_C(0xDDA2802C8A800000), /* 5^45 */
+    UINT64_C(0xE0352F62A19E306E), UINT64_C(0xD50B2037AD200000), /* 5^46 */
+    UINT64_C(0x8C213D9DA502DE45), UINT64_C(0x4526F422CC340000), /* 5^47 */
+    UINT64_C(0xAF298D050E4395D6), UINT64_C(0x9670B12B7F410000), /* 5^48 */
+    UINT64_C(0xDAF3F04651D47B4C), UINT64_C(0x3C0CDD765F114000), /* 5^49 */
+    UINT64_C(0x88D8762BF324CD0F), UINT64_C(0xA5880A69FB6AC800), /* 5^50 */
+    UINT64_C(0xAB0E93B6EFEE0053), UINT64_C(0x8EEA0D047A457A00), /* 5^51 */
+    UINT64_C(0xD5D238A4ABE98068), UINT64_C(0x72A4904598D6D880), /* 5^52 */
+    UINT64_C(0x85A36366EB71F041), UINT64_C(0x47A6DA2B7F864750), /* 5^53 */
+    UINT64_C(0xA70C3C40A64E6C51), UINT64_C(0x999090B65F67D924), /* 5^54 */
+    UINT64_C(0xD0CF4B50CFE20765), UINT64_C(0xFFF4B4E3F741CF6D), /* 5^55 */
+    UINT64_C(0x82818F1281ED449F), UINT64_C(0xBFF8F10E7A8921A4), /* 5^56 */
+    UINT64_C(0xA321F2D7226895C7), UINT64_C(0xAFF72D52192B6A0D), /* 5^57 */
+    UINT64_C(0xCBEA6F8CEB02BB39), UINT64_C(0x9BF4F8A69F764490), /* 5^58 */
+    UINT64_C(0xFEE50B7025C36A08), UINT64_C(0x02F236D04753D5B4), /* 5^59 */
+    UINT64_C(0x9F4F2726179A2245), UINT64_C(0x01D762422C946590), /* 5^60 */
+    UINT64_C(0xC722F0EF9D80AAD6), UINT64_C(0x424D3AD2B7B97EF5), /* 5^61 */
+    UINT64_C(0xF8EBAD2B84E0D58B), UINT64_C(0xD2E0898765A7DEB2), /* 5^62 */
+    UINT64_C(0x9B934C3B330C8577), UINT64_C(0x63CC55F49F88EB2F), /* 5^63 */
+    UINT64_C(0xC2781F49FFCFA6D5), UINT64_C(0x3CBF6B71C76B25FB), /* 5^64 */
+    UINT64_C(0xF316271C7FC3908A), UINT64_C(0x8BEF464E3945EF7A), /* 5^65 */
+    UINT64_C(0x97EDD871CFDA3A56), UINT64_C(0x97758BF0E3CBB5AC), /* 5^66 */
+    UINT64_C(0xBDE94E8E43D0C8EC), UINT64_C(0x3D52EEED1CBEA317), /* 5^67 */
+    UINT64_C(0xED63A231D4C4FB27), UINT64_C(0x4CA7AAA863EE4BDD), /* 5^68 */
+    UINT64_C(0x945E455F24FB1CF8), UINT64_C(0x8FE8CAA93E74EF6A), /* 5^69 */
+    UINT64_C(0xB975D6B6EE39E436), UINT64_C(0xB3E2FD538E122B44), /* 5^70 */
+    UINT64_C(0xE7D34C64A9C85D44), UINT64_C(0x60DBBCA87196B616), /* 5^71 */
+    UINT64_C(0x90E40FBEEA1D3A4A), UINT64_C(0xBC8955E946FE31CD), /* 5^72 */
+    UINT64_C(0xB51D13AEA4A488DD), UINT64_C(0x6BABAB6398BDBE41), /* 5^73 */
+    UINT64_C(0xE264589A4DCDAB14), UINT64_C(0xC696963C7EED2DD1), /* 5^74 */
+    UINT64_C(0x8D7EB76070A08AEC), UINT64_C(0xFC1E1DE5CF543CA2), /* 5^75 */
+    UINT64_C(0xB0DE65388CC8ADA8), UINT64_C(0x3B25A55F43294BCB), /* 5^76 */
+    UINT64_C(0xDD15FE86AFFAD912), UINT64_C(0x49EF0EB713F39EBE), /* 5^77 */
+    UINT64_C(0x8A2DBF142DFCC7AB), UINT64_C(0x6E3569326C784337), /* 5^78 */
+    UINT64_C(0xACB92ED9397BF996), UINT64_C(0x49C2C37F07965404), /* 5^79 */
+    UINT64_C(0xD7E77A8F87DAF7FB), UINT64_C(0xDC33745EC97BE906), /* 5^80 */
+    UINT64_C(0x86F0AC99B4E8DAFD), UINT64_C(0x69A028BB3DED71A3), /* 5^81 */
+    UINT64_C(0xA8ACD7C0222311BC), UINT64_C(0xC40832EA0D68CE0C), /* 5^82 */
+    UINT64_C(0xD2D80DB02AABD62B), UINT64_C(0xF50A3FA490C30190), /* 5^83 */
+    UINT64_C(0x83C7088E1AAB65DB), UINT64_C(0x792667C6DA79E0FA), /* 5^84 */
+    UINT64_C(0xA4B8CAB1A1563F52), UINT64_C(0x577001B891185938), /* 5^85 */
+    UINT64_C(0xCDE6FD5E09ABCF26), UINT64_C(0xED4C0226B55E6F86), /* 5^86 */
+    UINT64_C(0x80B05E5AC60B6178), UINT64_C(0x544F8158315B05B4), /* 5^87 */
+    UINT64_C(0xA0DC75F1778E39D6), UINT64_C(0x696361AE3DB1C721), /* 5^88 */
+    UINT64_C(0xC913936DD571C84C), UINT64_C(0x03BC3A19CD1E38E9), /* 5^89 */
+    UINT64_C(0xFB5878494ACE3A5F), UINT64_C(0x04AB48A04065C723), /* 5^90 */
+    UINT64_C(0x9D174B2DCEC0E47B), UINT64_C(0x62EB0D64283F9C76), /* 5^91 */
+    UINT64_C(0xC45D1DF942711D9A), UINT64_C(0x3BA5D0BD324F8394), /* 5^92 */
+    UINT64_C(0xF5746577930D6500), UINT64_C(0xCA8F44EC7EE36479), /* 5^93 */
+    UINT64_C(0x9968BF6ABBE85F20), UINT64_C(0x7E998B13CF4E1ECB), /* 5^94 */
+    UINT64_C(0xBFC2EF456AE276E8), UINT64_C(0x9E3FEDD8C321A67E), /* 5^95 */
+    UINT64_C(0xEFB3AB16C59B14A2), UINT64_C(0xC5CFE94EF3EA101E), /* 5^96 */
+    UINT64_C(0x95D04AEE3B80ECE5), UINT64_C(0xBBA1F1D158724A12), /* 5^97 */
+    UINT64_C(0xBB445DA9CA61281F), UINT64_C(0x2A8A6E45AE8EDC97), /* 5^98 */
+    UINT64_C(0xEA1575143CF97226), UINT64_C(0xF52D09D71A3293BD), /* 5^99 */
+    UINT64_C(0x924D692CA61BE758), UINT64_C(0x593C2626705F9C56), /* 5^100 */
+    UINT64_C(0xB6E0C377CFA2E12E), UINT64_C(0x6F8B2FB00C77836C), /* 5^101 */
+    UINT64_C(0xE498F455C38B997A), UINT64_C(0x0B6DFB9C0F956447), /* 5^102 */
+    UINT64_C(0x8EDF98B59A373FEC), UINT64_C(0x4724BD4189BD5EAC), /* 5^103 */
+    UINT64_C(0xB2977EE300C50FE7), UINT64_C(0x58EDEC91EC2CB657), /* 5^104 */
+    UINT64_C(0xDF3D5E9BC0F653E1), UINT64_C(0x2F2967B66737E3ED), /* 5^105 */
+    UINT64_C(0x8B865B215899F46C), UINT64_C(0xBD79E0D20082EE74), /* 5^106 */
+    UINT64_C(0xAE67F1E9AEC07187), UINT64_C(0xECD8590680A3AA11), /* 5^107 */
+    UINT64_C(0xDA01EE641A708DE9), UINT64_C(0xE80E6F4820CC9495), /* 5^108 */
+    UINT64_C(0x884134FE908658B2), UINT64_C(0x3109058D147FDCDD), /* 5^109 */
+    UINT64_C(0xAA51823E34A7EEDE), UINT64_C(0xBD4B46F0599FD415), /* 5^110 */
+    UINT64_C(0xD4E5E2CDC1D1EA96), UINT64_C(0x6C9E18AC7007C91A), /* 5^111 */
+    UINT64_C(0x850FADC09923329E), UINT64_C(0x03E2CF6BC604DDB0), /* 5^112 */
+    UINT64_C(0xA6539930BF6BFF45), UINT64_C(0x84DB8346B786151C), /* 5^113 */
+    UINT64_C(0xCFE87F7CEF46FF16), UINT64_C(0xE612641865679A63), /* 5^114 */
+    UINT64_C(0x81F14FAE158C5F6E), UINT64_C(0x4FCB7E8F3F60C07E), /* 5^115 */
+    UINT64_C(0xA26DA3999AEF7749), UINT64_C(0xE3BE5E330F38F09D), /* 5^116 */
+    UINT64_C(0xCB090C8001AB551C), UINT64_C(0x5CADF5BFD3072CC5), /* 5^117 */
+    UINT64_C(0xFDCB4FA002162A63), UINT64_C(0x73D9732FC7C8F7F6), /* 5^118 */
+    UINT64_C(0x9E9F11C4014DDA7E), UINT64_C(0x2867E7FDDCDD9AFA), /* 5^119 */
+    UINT64_C(0xC646D63501A1511D), UINT64_C(0xB281E1FD541501B8), /* 5^120 */
+    UINT64_C(0xF7D88BC24209A565), UINT64_C(0x1F225A7CA91A4226), /* 5^121 */
+    UINT64_C(0x9AE757596946075F), UINT64_C(0x3375788DE9B06958), /* 5^122 */
+    UINT64_C(0xC1A12D2FC3978937), UINT64_C(0x0052D6B1641C83AE), /* 5^123 */
+    UINT64_C(0xF209787BB47D6B84), UINT64_C(0xC0678C5DBD23A49A), /* 5^124 */
+    UINT64_C(0x9745EB4D50CE6332), UINT64_C(0xF840B7BA963646E0), /* 5^125 */
+    UINT64_C(0xBD176620A501FBFF), UINT64_C(0xB650E5A93BC3D898), /* 5^126 */
+    UINT64_C(0xEC5D3FA8CE427AFF), UINT64_C(0xA3E51F138AB4CEBE), /* 5^127 */
+    UINT64_C(0x93BA47C980E98CDF), UINT64_C(0xC66F336C36B10137), /* 5^128 */
+    UINT64_C(0xB8A8D9BBE123F017), UINT64_C(0xB80B0047445D4184), /* 5^129 */
+    UINT64_C(0xE6D3102AD96CEC1D), UINT64_C(0xA60DC059157491E5), /* 5^130 */
+    UINT64_C(0x9043EA1AC7E41392), UINT64_C(0x87C89837AD68DB2F), /* 5^131 */
+    UINT64_C(0xB454E4A179DD1877), UINT64_C(0x29BABE4598C311FB), /* 5^132 */
+    UINT64_C(0xE16A1DC9D8545E94), UINT64_C(0xF4296DD6FEF3D67A), /* 5^133 */
+    UINT64_C(0x8CE2529E2734BB1D), UINT64_C(0x1899E4A65F58660C), /* 5^134 */
+    UINT64_C(0xB01AE745B101E9E4), UINT64_C(0x5EC05DCFF72E7F8F), /* 5^135 */
+    UINT64_C(0xDC21A1171D42645D), UINT64_C(0x76707543F4FA1F73), /* 5^136 */
+    UINT64_C(0x899504AE72497EBA), UINT64_C(0x6A06494A791C53A8), /* 5^137 */
+    UINT64_C(0xABFA45DA0EDBDE69), UINT64_C(0x0487DB9D17636892), /* 5^138 */
+    UINT64_C(0xD6F8D7509292D603), UINT64_C(0x45A9D2845D3C42B6), /* 5^139 */
+    UINT64_C(0x865B86925B9BC5C2), UINT64_C(0x0B8A2392BA45A9B2), /* 5^140 */
+    UINT64_C(0xA7F26836F282B732), UINT64_C(0x8E6CAC7768D7141E), /* 5^141 */
+    UINT64_C(0xD1EF0244AF2364FF), UINT64_C(0x3207D795430CD926), /* 5^142 */
+    UINT64_C(0x8335616AED761F1F), UINT64_C(0x7F44E6BD49E807B8), /* 5^143 */
+    UINT64_C(0xA402B9C5A8D3A6E7), UINT64_C(0x5F16206C9C6209A6), /* 5^144 */
+    UINT64_C(0xCD036837130890A1), UINT64_C(0x36DBA887C37A8C0F), /* 5^145 */
+    UINT64_C(0x802221226BE55A64), UINT64_C(0xC2494954DA2C9789), /* 5^146 */
+    UINT64_C(0xA02AA96B06DEB0FD), UINT64_C(0xF2DB9BAA10B7BD6C), /* 5^147 */
+    UINT64_C(0xC83553C5C8965D3D), UINT64_C(0x6F92829494E5ACC7), /* 5^148 */
+    UINT64_C(0xFA42A8B73ABBF48C), UINT64_C(0xCB772339BA1F17F9), /* 5^149 */
+    UINT64_C(0x9C69A97284B578D7), UINT64_C(0xFF2A760414536EFB), /* 5^150 */
+    UINT64_C(0xC38413CF25E2D70D), UINT64_C(0xFEF5138519684ABA), /* 5^151 */
+    UINT64_C(0xF46518C2EF5B8CD1), UINT64_C(0x7EB258665FC25D69), /* 5^152 */
+    UINT64_C(0x98BF2F79D5993802), UINT64_C(0xEF2F773FFBD97A61), /* 5^153 */
+    UINT64_C(0xBEEEFB584AFF8603), UINT64_C(0xAAFB550FFACFD8FA), /* 5^154 */
+    UINT64_C(0xEEAABA2E5DBF6784), UINT64_C(0x95BA2A53F983CF38), /* 5^155 */
+    UINT64_C(0x952AB45CFA97A0B2), UINT64_C(0xDD945A747BF26183), /* 5^156 */
+    UINT64_C(0xBA756174393D88DF), UINT64_C(0x94F971119AEEF9E4), /* 5^157 */
+    UINT64_C(0xE912B9D1478CEB17), UINT64_C(0x7A37CD5601AAB85D), /* 5^158 */
+    UINT64_C(0x91ABB422CCB812EE), UINT64_C(0xAC62E055C10AB33A), /* 5^159 */
+    UINT64_C(0xB616A12B7FE617AA), UINT64_C(0x577B986B314D6009), /* 5^160 */
+    UINT64_C(0xE39C49765FDF9D94), UINT64_C(0xED5A7E85FDA0B80B), /* 5^161 */
+    UINT64_C(0x8E41ADE9FBEBC27D), UINT64_C(0x14588F13BE847307), /* 5^162 */
+    UINT64_C(0xB1D219647AE6B31C), UINT64_C(0x596EB2D8AE258FC8), /* 5^163 */
+    UINT64_C(0xDE469FBD99A05FE3), UINT64_C(0x6FCA5F8ED9AEF3BB), /* 5^164 */
+    UINT64_C(0x8AEC23D680043BEE), UINT64_C(0x25DE7BB9480D5854), /* 5^165 */
+    UINT64_C(0xADA72CCC20054AE9), UINT64_C(0xAF561AA79A10AE6A), /* 5^166 */
+    UINT64_C(0xD910F7FF28069DA4), UINT64_C(0x1B2BA1518094DA04), /* 5^167 */
+    UINT64_C(0x87AA9AFF79042286), UINT64_C(0x90FB44D2F05D0842), /* 5^168 */
+    UINT64_C(0xA99541BF57452B28), UINT64_C(0x353A1607AC744A53), /* 5^169 */
+    UINT64_C(0xD3FA922F2D1675F2), UINT64_C(0x42889B8997915CE8), /* 5^170 */
+    UINT64_C(0x847C9B5D7C2E09B7), UINT64_C(0x69956135FEBADA11), /* 5^171 */
+    UINT64_C(0xA59BC234DB398C25), UINT64_C(0x43FAB9837E699095), /* 5^172 */
+    UINT64_C(0xCF02B2C21207EF2E), UINT64_C(0x94F967E45E03F4BB), /* 5^173 */
+    UINT64_C(0x8161AFB94B44F57D), UINT64_C(0x1D1BE0EEBAC278F5), /* 5^174 */
+    UINT64_C(0xA1BA1BA79E1632DC), UINT64_C(0x6462D92A69731732), /* 5^175 */
+    UINT64_C(0xCA28A291859BBF93), UINT64_C(0x7D7B8F7503CFDCFE), /* 5^176 */
+    UINT64_C(0xFCB2CB35E702AF78), UINT64_C(0x5CDA735244C3D43E), /* 5^177 */
+    UINT64_C(0x9DEFBF01B061ADAB), UINT64_C(0x3A0888136AFA64A7), /* 5^178 */
+    UINT64_C(0xC56BAEC21C7A1916), UINT64_C(0x088AAA1845B8FDD0), /* 5^179 */
+    UINT64_C(0xF6C69A72A3989F5B), UINT64_C(0x8AAD549E57273D45), /* 5^180 */
+    UINT64_C(0x9A3C2087A63F6399), UINT64_C(0x36AC54E2F678864B), /* 5^181 */
+    UINT64_C(0xC0CB28A98FCF3C7F), UINT64_C(0x84576A1BB416A7DD), /* 5^182 */
+    UINT64_C(0xF0FDF2D3F3C30B9F), UINT64_C(0x656D44A2A11C51D5), /* 5^183 */
+    UINT64_C(0x969EB7C47859E743), UINT64_C(0x9F644AE5A4B1B325), /* 5^184 */
+    UINT64_C(0xBC4665B596706114), UINT64_C(0x873D5D9F0DDE1FEE), /* 5^185 */
+    UINT64_C(0xEB57FF22FC0C7959), UINT64_C(0xA90CB506D155A7EA), /* 5^186 */
+    UINT64_C(0x9316FF75DD87CBD8), UINT64_C(0x09A7F12442D588F2), /* 5^187 */
+    UINT64_C(0xB7DCBF5354E9BECE), UINT64_C(0x0C11ED6D538AEB2F), /* 5^188 */
+    UINT64_C(0xE5D3EF282A242E81), UINT64_C(0x8F1668C8A86DA5FA), /* 5^189 */
+    UINT64_C(0x8FA475791A569D10), UINT64_C(0xF96E017D694487BC), /* 5^190 */
+    UINT64_C(0xB38D92D760EC4455), UINT64_C(0x37C981DCC395A9AC), /* 5^191 */
+    UINT64_C(0xE070F78D3927556A), UINT64_C(0x85BBE253F47B1417), /* 5^192 */
+    UINT64_C(0x8C469AB843B89562), UINT64_C(0x93956D7478CCEC8E), /* 5^193 */
+    UINT64_C(0xAF58416654A6BABB), UINT64_C(0x387AC8D1970027B2), /* 5^194 */
+    UINT64_C(0xDB2E51BFE9D0696A), UINT64_C(0x06997B05FCC0319E), /* 5^195 */
+    UINT64_C(0x88FCF317F22241E2), UINT64_C(0x441FECE3BDF81F03), /* 5^196 */
+    UINT64_C(0xAB3C2FDDEEAAD25A), UINT64_C(0xD527E81CAD7626C3), /* 5^197 */
+    UINT64_C(0xD60B3BD56A5586F1), UINT64_C(0x8A71E223D8D3B074), /* 5^198 */
+    UINT64_C(0x85C7056562757456), UINT64_C(0xF6872D5667844E49), /* 5^199 */
+    UINT64_C(0xA738C6BEBB12D16C), UINT64_C(0xB428F8AC016561DB), /* 5^200 */
+    UINT64_C(0xD106F86E69D785C7), UINT64_C(0xE13336D701BEBA52), /* 5^201 */
+    UINT64_C(0x82A45B450226B39C), UINT64_C(0xECC0024661173473), /* 5^202 */
+    UINT64_C(0xA34D721642B06084), UINT64_C(0x27F002D7F95D0190), /* 5^203 */
+    UINT64_C(0xCC20CE9BD35C78A5), UINT64_C(0x31EC038DF7B441F4), /* 5^204 */
+    UINT64_C(0xFF290242C83396CE), UINT64_C(0x7E67047175A15271), /* 5^205 */
+    UINT64_C(0x9F79A169BD203E41), UINT64_C(0x0F0062C6E984D386), /* 5^206 */
+    UINT64_C(0xC75809C42C684DD1), UINT64_C(0x52C07B78A3E60868), /* 5^207 */
+    UINT64_C(0xF92E0C3537826145), UINT64_C(0xA7709A56CCDF8A82), /* 5^208 */
+    UINT64_C(0x9BBCC7A142B17CCB), UINT64_C(0x88A66076400BB691), /* 5^209 */
+    UINT64_C(0xC2ABF989935DDBFE), UINT64_C(0x6ACFF893D00EA435), /* 5^210 */
+    UINT64_C(0xF356F7EBF83552FE), UINT64_C(0x0583F6B8C4124D43), /* 5^211 */
+    UINT64_C(0x98165AF37B2153DE), UINT64_C(0xC3727A337A8B704A), /* 5^212 */
+    UINT64_C(0xBE1BF1B059E9A8D6), UINT64_C(0x744F18C0592E4C5C), /* 5^213 */
+    UINT64_C(0xEDA2EE1C7064130C), UINT64_C(0x1162DEF06F79DF73), /* 5^214 */
+    UINT64_C(0x9485D4D1C63E8BE7), UINT64_C(0x8ADDCB5645AC2BA8), /* 5^215 */
+    UINT64_C(0xB9A74A0637CE2EE1), UINT64_C(0x6D953E2BD7173692), /* 5^216 */
+    UINT64_C(0xE8111C87C5C1BA99), UINT64_C(0xC8FA8DB6CCDD0437), /* 5^217 */
+    UINT64_C(0x910AB1D4DB9914A0), UINT64_C(0x1D9C9892400A22A2), /* 5^218 */
+    UINT64_C(0xB54D5E4A127F59C8), UINT64_C(0x2503BEB6D00CAB4B), /* 5^219 */
+    UINT64_C(0xE2A0B5DC971F303A), UINT64_C(0x2E44AE64840FD61D), /* 5^220 */
+    UINT64_C(0x8DA471A9DE737E24), UINT64_C(0x5CEAECFED289E5D2), /* 5^221 */
+    UINT64_C(0xB10D8E1456105DAD), UINT64_C(0x7425A83E872C5F47), /* 5^222 */
+    UINT64_C(0xDD50F1996B947518), UINT64_C(0xD12F124E28F77719), /* 5^223 */
+    UINT64_C(0x8A5296FFE33CC92F), UINT64_C(0x82BD6B70D99AAA6F), /* 5^224 */
+    UINT64_C(0xACE73CBFDC0BFB7B), UINT64_C(0x636CC64D1001550B), /* 5^225 */
+    UINT64_C(0xD8210BEFD30EFA5A), UINT64_C(0x3C47F7E05401AA4E), /* 5^226 */
+    UINT64_C(0x8714A775E3E95C78), UINT64_C(0x65ACFAEC34810A71), /* 5^227 */
+    UINT64_C(0xA8D9D1535CE3B396), UINT64_C(0x7F1839A741A14D0D), /* 5^228 */
+    UINT64_C(0xD31045A8341CA07C), UINT64_C(0x1EDE48111209A050), /* 5^229 */
+    UINT64_C(0x83EA2B892091E44D), UINT64_C(0x934AED0AAB460432), /* 5^230 */
+    UINT64_C(0xA4E4B66B68B65D60), UINT64_C(0xF81DA84D5617853F), /* 5^231 */
+    UINT64_C(0xCE1DE40642E3F4B9), UINT64_C(0x36251260AB9D668E), /* 5^232 */
+    UINT64_C(0x80D2AE83E9CE78F3), UINT64_C(0xC1D72B7C6B426019), /* 5^233 */
+    UINT64_C(0xA1075A24E4421730), UINT64_C(0xB24CF65B8612F81F), /* 5^234 */
+    UINT64_C(0xC94930AE1D529CFC), UINT64_C(0xDEE033F26797B627), /* 5^235 */
+    UINT64_C(0xFB9B7CD9A4A7443C), UINT64_C(0x169840EF017DA3B1), /* 5^236 */
+    UINT64_C(0x9D412E0806E88AA5), UINT64_C(0x8E1F289560EE864E), /* 5^237 */
+    UINT64_C(0xC491798A08A2AD4E), UINT64_C(0xF1A6F2BAB92A27E2), /* 5^238 */
+    UINT64_C(0xF5B5D7EC8ACB58A2), UINT64_C(0xAE10AF696774B1DB), /* 5^239 */
+    UINT64_C(0x9991A6F3D6BF1765), UINT64_C(0xACCA6DA1E0A8EF29), /* 5^240 */
+    UINT64_C(0xBFF610B0CC6EDD3F), UINT64_C(0x17FD090A58D32AF3), /* 5^241 */
+    UINT64_C(0xEFF394DCFF8A948E), UINT64_C(0xDDFC4B4CEF07F5B0), /* 5^242 */
+    UINT64_C(0x95F83D0A1FB69CD9), UINT64_C(0x4ABDAF101564F98E), /* 5^243 */
+    UINT64_C(0xBB764C4CA7A4440F), UINT64_C(0x9D6D1AD41ABE37F1), /* 5^244 */
+    UINT64_C(0xEA53DF5FD18D5513), UINT64_C(0x84C86189216DC5ED), /* 5^245 */
+    UINT64_C(0x92746B9BE2F8552C), UINT64_C(0x32FD3CF5B4E49BB4), /* 5^246 */
+    UINT64_C(0xB7118682DBB66A77), UINT64_C(0x3FBC8C33221DC2A1), /* 5^247 */
+    UINT64_C(0xE4D5E82392A40515), UINT64_C(0x0FABAF3FEAA5334A), /* 5^248 */
+    UINT64_C(0x8F05B1163BA6832D), UINT64_C(0x29CB4D87F2A7400E), /* 5^249 */
+    UINT64_C(0xB2C71D5BCA9023F8), UINT64_C(0x743E20E9EF511012), /* 5^250 */
+    UINT64_C(0xDF78E4B2BD342CF6), UINT64_C(0x914DA9246B255416), /* 5^251 */
+    UINT64_C(0x8BAB8EEFB6409C1A), UINT64_C(0x1AD089B6C2F7548E), /* 5^252 */
+    UINT64_C(0xAE9672ABA3D0C320), UINT64_C(0xA184AC2473B529B1), /* 5^253 */
+    UINT64_C(0xDA3C0F568CC4F3E8), UINT64_C(0xC9E5D72D90A2741E), /* 5^254 */
+    UINT64_C(0x8865899617FB1871), UINT64_C(0x7E2FA67C7A658892), /* 5^255 */
+    UINT64_C(0xAA7EEBFB9DF9DE8D), UINT64_C(0xDDBB901B98FEEAB7), /* 5^256 */
+    UINT64_C(0xD51EA6FA85785631), UINT64_C(0x552A74227F3EA565), /* 5^257 */
+    UINT64_C(0x8533285C936B35DE), UINT64_C(0xD53A88958F87275F), /* 5^258 */
+    UINT64_C(0xA67FF273B8460356), UINT64_C(0x8A892ABAF368F137), /* 5^259 */
+    UINT64_C(0xD01FEF10A657842C), UINT64_C(0x2D2B7569B0432D85), /* 5^260 */
+    UINT64_C(0x8213F56A67F6B29B), UINT64_C(0x9C3B29620E29FC73), /* 5^261 */
+    UINT64_C(0xA298F2C501F45F42), UINT64_C(0x8349F3BA91B47B8F), /* 5^262 */
+    UINT64_C(0xCB3F2F7642717713), UINT64_C(0x241C70A936219A73), /* 5^263 */
+    UINT64_C(0xFE0EFB53D30DD4D7), UINT64_C(0xED238CD383AA0110), /* 5^264 */
+    UINT64_C(0x9EC95D1463E8A506), UINT64_C(0xF4363804324A40AA), /* 5^265 */
+    UINT64_C(0xC67BB4597CE2CE48), UINT64_C(0xB143C6053EDCD0D5), /* 5^266 */
+    UINT64_C(0xF81AA16FDC1B81DA), UINT64_C(0xDD94B7868E94050A), /* 5^267 */
+    UINT64_C(0x9B10A4E5E9913128), UINT64_C(0xCA7CF2B4191C8326), /* 5^268 */
+    UINT64_C(0xC1D4CE1F63F57D72), UINT64_C(0xFD1C2F611F63A3F0), /* 5^269 */
+    UINT64_C(0xF24A01A73CF2DCCF), UINT64_C(0xBC633B39673C8CEC), /* 5^270 */
+    UINT64_C(0x976E41088617CA01), UINT64_C(0xD5BE0503E085D813), /* 5^271 */
+    UINT64_C(0xBD49D14AA79DBC82), UINT64_C(0x4B2D8644D8A74E18), /* 5^272 */
+    UINT64_C(0xEC9C459D51852BA2), UINT64_C(0xDDF8E7D60ED1219E), /* 5^273 */
+    UINT64_C(0x93E1AB8252F33B45), UINT64_C(0xCABB90E5C942B503), /* 5^274 */
+    UINT64_C(0xB8DA1662E7B00A17), UINT64_C(0x3D6A751F3B936243), /* 5^275 */
+    UINT64_C(0xE7109BFBA19C0C9D), UINT64_C(0x0CC512670A783AD4), /* 5^276 */
+    UINT64_C(0x906A617D450187E2), UINT64_C(0x27FB2B80668B24C5), /* 5^277 */
+    UINT64_C(0xB484F9DC9641E9DA), UINT64_C(0xB1F9F660802DEDF6), /* 5^278 */
+    UINT64_C(0xE1A63853BBD26451), UINT64_C(0x5E7873F8A0396973), /* 5^279 */
+    UINT64_C(0x8D07E33455637EB2), UINT64_C(0xDB0B487B6423E1E8), /* 5^280 */
+    UINT64_C(0xB049DC016ABC5E5F), UINT64_C(0x91CE1A9A3D2CDA62), /* 5^281 */
+    UINT64_C(0xDC5C5301C56B75F7), UINT64_C(0x7641A140CC7810FB), /* 5^282 */
+    UINT64_C(0x89B9B3E11B6329BA), UINT64_C(0xA9E904C87FCB0A9D), /* 5^283 */
+    UINT64_C(0xAC2820D9623BF429), UINT64_C(0x546345FA9FBDCD44), /* 5^284 */
+    UINT64_C(0xD732290FBACAF133), UINT64_C(0xA97C177947AD4095), /* 5^285 */
+    UINT64_C(0x867F59A9D4BED6C0), UINT64_C(0x49ED8EABCCCC485D), /* 5^286 */
+    UINT64_C(0xA81F301449EE8C70), UINT64_C(0x5C68F256BFFF5A74), /* 5^287 */
+    UINT64_C(0xD226FC195C6A2F8C), UINT64_C(0x73832EEC6FFF3111), /* 5^288 */
+    UINT64_C(0x83585D8FD9C25DB7), UINT64_C(0xC831FD53C5FF7EAB), /* 5^289 */
+    UINT64_C(0xA42E74F3D032F525), UINT64_C(0xBA3E7CA8B77F5E55), /* 5^290 */
+    UINT64_C(0xCD3A1230C43FB26F), UINT64_C(0x28CE1BD2E55F35EB), /* 5^291 */
+    UINT64_C(0x80444B5E7AA7CF85), UINT64_C(0x7980D163CF5B81B3), /* 5^292 */
+    UINT64_C(0xA0555E361951C366), UINT64_C(0xD7E105BCC332621F), /* 5^293 */
+    UINT64_C(0xC86AB5C39FA63440), UINT64_C(0x8DD9472BF3FEFAA7), /* 5^294 */
+    UINT64_C(0xFA856334878FC150), UINT64_C(0xB14F98F6F0FEB951), /* 5^295 */
+    UINT64_C(0x9C935E00D4B9D8D2), UINT64_C(0x6ED1BF9A569F33D3), /* 5^296 */
+    UINT64_C(0xC3B8358109E84F07), UINT64_C(0x0A862F80EC4700C8), /* 5^297 */
+    UINT64_C(0xF4A642E14C6262C8), UINT64_C(0xCD27BB612758C0FA), /* 5^298 */
+    UINT64_C(0x98E7E9CCCFBD7DBD), UINT64_C(0x8038D51CB897789C), /* 5^299 */
+    UINT64_C(0xBF21E44003ACDD2C), UINT64_C(0xE0470A63E6BD56C3), /* 5^300 */
+    UINT64_C(0xEEEA5D5004981478), UINT64_C(0x1858CCFCE06CAC74), /* 5^301 */
+    UINT64_C(0x95527A5202DF0CCB), UINT64_C(0x0F37801E0C43EBC8), /* 5^302 */
+    UINT64_C(0xBAA718E68396CFFD), UINT64_C(0xD30560258F54E6BA), /* 5^303 */
+    UINT64_C(0xE950DF20247C83FD), UINT64_C(0x47C6B82EF32A2069), /* 5^304 */
+    UINT64_C(0x91D28B7416CDD27E), UINT64_C(0x4CDC331D57FA5441), /* 5^305 */
+    UINT64_C(0xB6472E511C81471D), UINT64_C(0xE0133FE4ADF8E952), /* 5^306 */
+    UINT64_C(0xE3D8F9E563A198E5), UINT64_C(0x58180FDDD97723A6), /* 5^307 */
+    UINT64_C(0x8E679C2F5E44FF8F), UINT64_C(0x570F09EAA7EA7648), /* 5^308 */
+
+};
+
+static int lept_clz64(uint64_t x) {
+    assert(x != 0);
+#if defined(__GNUC__)
+    return __builtin_clzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    {
+        unsigned long i;
+        _BitScanReverse64(&i, x);
+        return 63 - (int)i;
+    }
+#else
+    {
+        int n = 0;
+        for (; !(x & (UINT64_C(1) << 63)); x <<= 1)
+            n++;
+        return n;
+    }
+#endif
+}
+
+static void lept_mul128(uint64_t a, uint64_t b, uint64_t* hi, uint64_t* lo) {
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 lept_uint128;
+    lept_uint128 r = (lept_uint128)a * b;
+    *hi = (uint64_t)(r >> 64);
+    *lo = (uint64_t)r;
+#elif defined(_MSC_VER) && defined(_M_X64)
+    *lo = _umul128(a, b, hi);
+#else
+    uint64_t a0 = a & 0xFFFFFFFF, a1 = a >> 32, b0 = b & 0xFFFFFFFF, b1 = b >> 32;
+    uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0;
+    uint64_t mid = (p00 >> 32) + (p01 & 0xFFFFFFFF) + (p10 & 0xFFFFFFFF);
+    *hi = a1 * b1 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+    *lo = (mid << 32) | (p00 & 0xFFFFFFFF);
+#endif
+}
+
+/* Correctly rounded w * 10^q, w != 0. Returns 0 when the result cannot be decided without more digits. */
+static int lept_eisel_lemire(uint64_t w, long q, double* d) {
+    uint64_t hi, lo, hi2, lo2, mantissa, bits;
+    int lz, upperbit;
+    long power2;
+    assert(w != 0);
+    if (q < LEPT_POW5_MIN_EXP) {
+        *d = 0.0;
+        return 1;
+    }
+    if (q > LEPT_POW5_MAX_EXP) {
+        *d = HUGE_VAL;
+        return 1;
+    }
+    lz = lept_clz64(w);
+    w <<= lz;
+    lept_mul128(w, lept_pow5_128[2 * (q - LEPT_POW5_MIN_EXP)], &hi, &lo);
+    if ((hi & 0x1FF) == 0x1FF) { /* the truncated product may be off in the bits that matter */
+        lept_mul128(w, lept_pow5_128[2 * (q - LEPT_POW5_MIN_EXP) + 1], &hi2, &lo2);
+        lo += hi2;
+        if (hi2 > lo)
+            hi++;
+        if (lo == UINT64_C(0xFFFFFFFFFFFFFFFF) && (q < -27 || q > 55))
+            return 0;
+    }
+    upperbit = (int)(hi >> 63);
+    mantissa = hi >> (upperbit + 9);
+    power2 = ((217706 * q) >> 16) + 63 + upperbit - lz + 1023; /* floor(q * log2(10)) + 63, biased */
+    if (power2 <= 0) { /* subnormal */
+        if (-power2 + 1 >= 64) {
+            *d = 0.0;
+            return 1;
+        }
+        mantissa >>= -power2 + 1;
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        power2 = mantissa < (UINT64_C(1) << 52) ? 0 : 1;
+    }
+    else {
+        /* exactly halfway between two doubles: round to even */
+        if (lo <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 && (mantissa << (upperbit + 9)) == hi)
+            mantissa &= ~UINT64_C(1);
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        if (mantissa >= (UINT64_C(2) << 52)) {
+            mantissa = UINT64_C(1) << 52;
+            power2++;
+        }
+        mantissa &= ~(UINT64_C(1) << 52);
+        if (power2 >= 0x7FF) {
+            *d = HUGE_VAL;
+            return 1;
+        }
+    }
+    bits = mantissa | (uint64_t)power2 << 52;
+    memcpy(d, &bits, sizeof(double));
+    return 1;
+}
+
+static uint64_t lept_load8(const char* p) {
+    uint64_t x;
+    memcpy(&x, p, sizeof(x));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    x = __builtin_bswap64(x);
+#endif
+    return x;
+}
+
+static int lept_is_eight_digits(uint64_t x) {
+    return (((x + UINT64_C(0x4646464646464646)) | (x - UINT64_C(0x3030303030303030))) & UINT64_C(0x8080808080808080)) == 0;
+}
+
+static uint64_t lept_parse_eight_digits(uint64_t x) {
+    x -= UINT64_C(0x3030303030303030);
+    x = x * 10 + (x >> 8);
+    return (((x & UINT64_C(0x000000FF000000FF)) * UINT64_C(0x000F424000000064)) +
+        (((x >> 16) & UINT64_C(0x000000FF000000FF)) * UINT64_C(0x0000271000000001))) >> 32;
+}
+
+/*
+ * Fold a run of digits into the significand *m, keeping at most 19 significant digits in *nd.
+ * Fraction digits scale *exp10 down when kept, integer digits scale it up when dropped.
+ */
+static const char* lept_parse_digits(const char* p, const char* end, int frac, uint64_t* m, int* nd, long* exp10, int* truncated) {
+    uint64_t x;
+    for (;;) {
+        if (*m != 0 && *nd <= 11 && end - p >= 8 && lept_is_eight_digits(x = lept_load8(p))) {
+            *m = *m * 100000000 + lept_parse_eight_digits(x);
+            *nd += 8;
+            if (frac)
+                *exp10 -= 8;
+            p += 8;
+            continue;
+        }
+        if (p == end || !ISDIGIT(*p))
+            return p;
+        if (*nd < 19) {
+            *m = *m * 10 + (unsigned)(*p - '0');
+            if (*m != 0)
+                (*nd)++;
+            if (frac)
+                (*exp10)--;
+        }
+        else {
+            if (!frac)
+                (*exp10)++;
+            if (*p != '0')
+                *truncated = 1;
+        }
+        p++;
+    }
+}
+
+/* Locale-independent strtod() for the slow path */
+static double lept_strtod(lept_context* c, const char* s, size_t len) {
+    char point = localeconv()->decimal_point[0];
+    char* buf = (char*)lept_context_push(c, len + 1);
+    double d;
+    size_t i;
+    memcpy(buf, s, len);
+    buf[len] = '\0';
+    if (point != '.')
+        for (i = 0; i < len; i++)
+            if (buf[i] == '.')
+                buf[i] = point;
+    d = strtod(buf, NULL);
+    lept_context_pop(c, len + 1);
+    return d;
+}
+
+/* Store digits without fraction or exponent as LEPT_INTEGER if they fit, end points past the last digit */
+static int lept_parse_integer(lept_value* v, uint64_t m, long exp10, int neg, const char* end) {
+    if (exp10 == 1) { /* 20 digits, the last one did not fit in the significand */
+        unsigned d = (unsigned)(end[-1] - '0');
+        if (neg || m > (UINT64_C(0xFFFFFFFFFFFFFFFF) - d) / 10)
+            return 0;
+        m = m * 10 + d;
+    }
+    else if (exp10 != 0)
+        return 0;
+    if (neg) {
+        if (m == 0 || m > (UINT64_C(1) << 63))
+            return 0; /* -0 keeps its sign as a double */
+        v->u.i = m == (UINT64_C(1) << 63) ? INT64_MIN : -(int64_t)m;
+        v->flags = 0;
+    }
+    else if (m > INT64_MAX) {
+        v->u.ui = m;
+        v->flags = LEPT_VALUE_UINT64;
+    }
+    else {
+        v->u.i = (int64_t)m;
+        v->flags = 0;
+    }
+    v->type = LEPT_INTEGER;
+    return 1;
+}
+
 static int lept_parse_number(lept_context* c, lept_value* v) {
     const char* p = c->json;
-    if (*p == '-') p++;
-    if (*p == '0') p++;
+    const char* end = c->end;
+    uint64_t m = 0;
+    long exp10 = 0, e = 0;
+    int neg = 0, nd = 0, truncated = 0, eneg = 0, integer = 1;
+    double d, d2;
+    if (p != end && *p == '-') {
+        neg = 1;
+        p++;
+    }
+    if (p != end && *p == '0') p++;
     else {
-        if (!ISDIGIT1TO9(*p)) return LEPT_PARSE_INVALID_VALUE;
-        for (p++; ISDIGIT(*p); p++);
+        if (p == end || !ISDIGIT1TO9(*p)) return LEPT_PARSE_INVALID_VALUE;
+        p = lept_parse_digits(p, end, 0, &m, &nd, &exp10, &truncated);
     }
-    if (*p == '.') {
+    if (p != end && *p == '.') {
         p++;
-        if (!ISDIGIT(*p)) return LEPT_PARSE_INVALID_VALUE;
-        for (p++; ISDIGIT(*p); p++);
+        if (p == end || !ISDIGIT(*p)) return LEPT_PARSE_INVALID_VALUE;
+        p = lept_parse_digits(p, end, 1, &m, &nd, &exp10, &truncated);
+        integer = 0;
     }
-    if (*p == 'e' || *p == 'E') {
+    if (p != end && (*p == 'e' || *p == 'E')) {
+        integer = 0;
         p++;
-        if (*p == '+' || *p == '-') p++;
-        if (!ISDIGIT(*p)) return LEPT_PARSE_INVALID_VALUE;
-        for (p++; ISDIGIT(*p); p++);
+        if (p != end && (*p == '+' || *p == '-')) eneg = *p++ == '-';
+        if (p == end || !ISDIGIT(*p)) return LEPT_PARSE_INVALID_VALUE;
+        for (; p != end && ISDIGIT(*p); p++)
+            if (e < 100000) /* far beyond any double, saturate */
+                e = e * 10 + (*p - '0');
+        exp10 += eneg ? -e : e;
     }
-    errno = 0;
-    v->u.n = strtod(c->json, NULL);
-    if (errno == ERANGE && (v->u.n == HUGE_VAL || v->u.n == -HUGE_VAL))
+    if (integer && lept_parse_integer(v, m, exp10, neg, p)) {
+        c->json = p;
+        return LEPT_PARSE_OK;
+    }
+    if (m == 0)
+        d = 0.0;
+    else if (!lept_eisel_lemire(m, exp10, &d) ||
+        (truncated && (!lept_eisel_lemire(m + 1, exp10, &d2) || d != d2)))
+        d = fabs(lept_strtod(c, c->json, (size_t)(p - c->json)));
+    if (d == HUGE_VAL)
         return LEPT_PARSE_NUMBER_TOO_BIG;
+    v->u.n = neg ? -d : d;
     v->type = LEPT_NUMBER;
     c->json = p;
     return LEPT_PARSE_OK;
 }
 
-static const char* lept_parse_hex4(const char* p, unsigned* u) {
-    int i;
-    *u = 0;
-    for (i = 0; i < 4; i++) {
-        char ch = *p++;
-        *u <<= 4;
-        if      (ch >= '0' && ch <= '9')  *u |= ch - '0';
-        else if (ch >= 'A' && ch <= 'F')  *u |= ch - ('A' - 10);
-        else if (ch >= 'a' && ch <= 'f')  *u |= ch - ('a' - 10);
-        else return NULL;
+static const char* lept_parse_hex4(const char* p, const char* end, unsigned* u) {
+    int h0, h1, h2, h3;
+    if (end - p < 4)
+        return NULL;
+    h0 = lept_hex_digit[(unsigned char)p[0]];
+    h1 = lept_hex_digit[(unsigned char)p[1]];
+    h2 = lept_hex_digit[(unsigned char)p[2]];
+    h3 = lept_hex_digit[(unsigned char)p[3]];
+    if ((h0 | h1 | h2 | h3) < 0)
+        return NULL;
+    *u = (unsigned)(h0 << 12 | h1 << 8 | h2 << 4 | h3);
+    return p + 4;
+}
+
+/* Decode the hex digits of a \u escape at p, joining a surrogate pair. Return pointer past them, or NULL with the error in *ret */
+static const char* lept_parse_unicode(const char* p, const char* end, unsigned* u, int* ret) {
+    unsigned u2;
+    if (!(p = lept_parse_hex4(p, end, u))) {
+        *ret = LEPT_PARSE_INVALID_UNICODE_HEX;
+        return NULL;
+    }
+    if (*u >= 0xD800 && *u <= 0xDBFF) { /* surrogate pair */
+        if (end - p < 2 || p[0] != '\\' || p[1] != 'u') {
+            *ret = LEPT_PARSE_INVALID_UNICODE_SURROGATE;
+            return NULL;
+        }
+        if (!(p = lept_parse_hex4(p + 2, end, &u2))) {
+            *ret = LEPT_PARSE_INVALID_UNICODE_HEX;
+            return NULL;
+        }
+        if (u2 < 0xDC00 || u2 > 0xDFFF) {
+            *ret = LEPT_PARSE_INVALID_UNICODE_SURROGATE;
+            return NULL;
+        }
+        *u = (((*u - 0xD800) << 10) | (u2 - 0xDC00)) + 0x10000;
+    }
+    else if (*u >= 0xDC00 && *u <= 0xDFFF) { /* low surrogate without a high one */
+        *ret = LEPT_PARSE_INVALID_UNICODE_SURROGATE;
+        return NULL;
     }
     return p;
 }
 
-static void lept_encode_utf8(lept_context* c, unsigned u) {
-    if (u <= 0x7F) 
-        PUTC(c, u & 0xFF);
+/* Write u as UTF-8 to d and return the number of bytes, at most 4 */
+static size_t lept_write_utf8(char* d, unsigned u) {
+    if (u <= 0x7F) {
+        d[0] = (char)u;
+        return 1;
+    }
     else if (u <= 0x7FF) {
-        PUTC(c, 0xC0 | ((u >> 6) & 0xFF));
-        PUTC(c, 0x80 | ( u       & 0x3F));
+        d[0] = (char)(0xC0 | ((u >> 6) & 0xFF));
+        d[1] = (char)(0x80 | ( u       & 0x3F));
+        return 2;
     }
     else if (u <= 0xFFFF) {
-        PUTC(c, 0xE0 | ((u >> 12) & 0xFF));
-        PUTC(c, 0x80 | ((u >>  6) & 0x3F));
-        PUTC(c, 0x80 | ( u        & 0x3F));
-    }
-    else {
-        assert(u <= 0x10FFFF);
-        PUTC(c, 0xF0 | ((u >> 18) & 0xFF));
-        PUTC(c, 0x80 | ((u >> 12) & 0x3F));
-        PUTC(c, 0x80 | ((u >>  6) & 0x3F));
-        PUTC(c, 0x80 | ( u        & 0x3F));
+        d[0] = (char)(0xE0 | ((u >> 12) & 0xFF));
+        d[1] = (char)(0x80 | ((u >>  6) & 0x3F));
+        d[2] = (char)(0x80 | ( u        & 0x3F));
+        return 3;
     }
+    assert(u <= 0x10FFFF);
+    d[0] = (char)(0xF0 | ((u >> 18) & 0xFF));
+    d[1] = (char)(0x80 | ((u >> 12) & 0x3F));
+    d[2] = (char)(0x80 | ((u >>  6) & 0x3F));
+    d[3] = (char)(0x80 | ( u        & 0x3F));
+    return 4;
+}
+
+static void lept_encode_utf8(lept_context* c, unsigned u) {
+    char* d = (char*)lept_context_push(c, 4);
+    c->top -= 4 - lept_write_utf8(d, u);
 }
 
 #define STRING_ERROR(ret) do { c->top = head; return ret; } while(0)
 
+static int lept_parse_string_insitu(lept_context* c, char** str, size_t* len);
+
 static int lept_parse_string_raw(lept_context* c, char** str, size_t* len) {
     size_t head = c->top;
-    unsigned u, u2;
+    unsigned u;
+    int ret;
     const char* p;
+    if (c->flags & LEPT_PARSE_INSITU)
+        return lept_parse_string_insitu(c, str, len);
     EXPECT(c, '\"');
     p = c->json;
     for (;;) {
-        char ch = *p++;
-        switch (ch) {
+        const char* q = lept_scan_string(p, c->end);
+        if (q != p) {
+            PUTS(c, p, (size_t)(q - p));
+            p = q;
+        }
+        if (p == c->end)
+            STRING_ERROR(LEPT_PARSE_MISS_QUOTATION_MARK);
+        switch (*p++) {
             case '\"':
                 *len = c->top - head;
                 *str = lept_context_pop(c, *len);
                 c->json = p;
                 return LEPT_PARSE_OK;
             case '\\':
+                if (p == c->end)
+                    STRING_ERROR(LEPT_PARSE_MISS_QUOTATION_MARK);
                 switch (*p++) {
                     case '\"': PUTC(c, '\"'); break;
                     case '\\': PUTC(c, '\\'); break;
@@ -158,185 +1732,2619 @@ static int lept_parse_string_raw(lept_context* c, char** str, size_t* len) {
                     case 'r':  PUTC(c, '\r'); break;
                     case 't':  PUTC(c, '\t'); break;
                     case 'u':
-                        if (!(p = lept_parse_hex4(p, &u)))
-                            STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_HEX);
-                        if (u >= 0xD800 && u <= 0xDBFF) { /* surrogate pair */
-                            if (*p++ != '\\')
-                                STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE);
-                            if (*p++ != 'u')
-                                STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE);
-                            if (!(p = lept_parse_hex4(p, &u2)))
-                                STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_HEX);
-                            if (u2 < 0xDC00 || u2 > 0xDFFF)
-                                STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE);
-                            u = (((u - 0xD800) << 10) | (u2 - 0xDC00)) + 0x10000;
-                        }
+                        if (!(p = lept_parse_unicode(p, c->end, &u, &ret)))
+                            STRING_ERROR(ret);
                         lept_encode_utf8(c, u);
                         break;
                     default:
                         STRING_ERROR(LEPT_PARSE_INVALID_STRING_ESCAPE);
                 }
                 break;
-            case '\0':
-                STRING_ERROR(LEPT_PARSE_MISS_QUOTATION_MARK);
+            default: /* lept_scan_string() only stops at control characters otherwise, including '\0' */
+                STRING_ERROR(LEPT_PARSE_INVALID_STRING_CHAR);
+        }
+    }
+}
+
+/*
+ * In-situ variant for lept_parse_insitu(): the decoded string is written over the input, which is never shorter,
+ * and null-terminated in place. *str points into the caller's buffer.
+ */
+static int lept_parse_string_insitu(lept_context* c, char** str, size_t* len) {
+    char* d = (char*)c->json + 1;
+    const char* p = d;
+    unsigned u;
+    int ret;
+    EXPECT(c, '\"');
+    *str = d;
+    for (;;) {
+        const char* q = lept_scan_string(p, c->end);
+        if (q != p) {
+            if (d != p)
+                memmove(d, p, (size_t)(q - p));
+            d += q - p;
+            p = q;
+        }
+        if (p == c->end)
+            return LEPT_PARSE_MISS_QUOTATION_MARK;
+        switch (*p++) {
+            case '\"':
+                *d = '\0';
+                *len = (size_t)(d - *str);
+                c->json = p;
+                return LEPT_PARSE_OK;
+            case '\\':
+                if (p == c->end)
+                    return LEPT_PARSE_MISS_QUOTATION_MARK;
+                switch (*p++) {
+                    case '\"': *d++ = '\"'; break;
+                    case '\\': *d++ = '\\'; break;
+                    case '/':  *d++ = '/';  break;
+                    case 'b':  *d++ = '\b'; break;
+                    case 'f':  *d++ = '\f'; break;
+                    case 'n':  *d++ = '\n'; break;
+                    case 'r':  *d++ = '\r'; break;
+                    case 't':  *d++ = '\t'; break;
+                    case 'u':
+                        if (!(p = lept_parse_unicode(p, c->end, &u, &ret)))
+                            return ret;
+                        d += lept_write_utf8(d, u); /* 6 or 12 input bytes become at most 4 */
+                        break;
+                    default:
+                        return LEPT_PARSE_INVALID_STRING_ESCAPE;
+                }
+                break;
             default:
-                if ((unsigned char)ch < 0x20)
-                    STRING_ERROR(LEPT_PARSE_INVALID_STRING_CHAR);
-                PUTC(c, ch);
+                return LEPT_PARSE_INVALID_STRING_CHAR;
         }
     }
 }
 
-static int lept_parse_string(lept_context* c, lept_value* v) {
+/*
+ * Event parser behind every DOM entry point and lept_parse_sax(). A string without escapes is reported straight
+ * from the input, otherwise it is decoded onto c->stack and popped, so it sits at c->stack + c->top during the
+ * callback. In-situ strings are decoded in place.
+ */
+static int lept_parse_sax_string(lept_context* c, const lept_handler* h, void* user, int key) {
+    char* s;
+    size_t len;
+    int ret;
+    const char* q;
+    if (!(c->flags & LEPT_PARSE_INSITU) && (q = lept_scan_string(c->json + 1, c->end)) != c->end && *q == '\"') {
+        s = (char*)(c->json + 1);
+        len = (size_t)(q - s);
+        c->json = q + 1;
+    }
+    else if ((ret = lept_parse_string_raw(c, &s, &len)) != LEPT_PARSE_OK)
+        return ret;
+    if (key ? h->key && !h->key(user, s, len) : h->string && !h->string(user, s, len))
+        return LEPT_PARSE_STOPPED;
+    return LEPT_PARSE_OK;
+}
+
+/* Report a literal or number */
+static int lept_sax_atom(const lept_handler* h, void* user, const lept_value* v) {
+    int ret;
+    switch (v->type) {
+        case LEPT_NULL:
+            ret = !h->null || h->null(user);
+            break;
+        case LEPT_FALSE:
+        case LEPT_TRUE:
+            ret = !h->boolean || h->boolean(user, v->type == LEPT_TRUE);
+            break;
+        case LEPT_INTEGER:
+            if (v->flags & LEPT_VALUE_UINT64)
+                ret = h->uint64 ? h->uint64(user, v->u.ui) : !h->number || h->number(user, (double)v->u.ui);
+            else
+                ret = h->integer ? h->integer(user, v->u.i) : !h->number || h->number(user, (double)v->u.i);
+            break;
+        default:
+            ret = !h->number || h->number(user, v->u.n);
+    }
+    return ret ? LEPT_PARSE_OK : LEPT_PARSE_STOPPED;
+}
+
+/* Parse a key and the colon after it */
+static int lept_parse_sax_key(lept_context* c, const lept_handler* h, void* user) {
+    int ret;
+    if (PEEK(c) != '"')
+        return LEPT_PARSE_MISS_KEY;
+    if ((ret = lept_parse_sax_string(c, h, user, 1)) != LEPT_PARSE_OK)
+        return ret;
+    lept_parse_whitespace(c);
+    if (PEEK(c) != ':')
+        return LEPT_PARSE_MISS_COLON;
+    c->json++;
+    lept_parse_whitespace(c);
+    return LEPT_PARSE_OK;
+}
+
+/*
+ * Containers are parsed without recursion. Each open one has a word on a stack of its own, the number of values
+ * so far << 1 | 1 for an object, so nesting costs no call frames. With the depth containers already open around
+ * the value, no more than LEPT_PARSE_MAX_DEPTH may be open at once.
+ */
+static int lept_parse_sax_value(lept_context* c, const lept_handler* h, void* user, size_t depth) {
+    lept_context s;
+    lept_value v;
+    size_t* level;
+    size_t base = depth;
+    int ret;
+    char ch;
+    s.stack = NULL;
+    s.size = s.top = 0;
+    for (;;) {
+        /* a value, or an opening bracket and what follows up to the first value */
+        if (c->json == c->end) {
+            ret = LEPT_PARSE_EXPECT_VALUE;
+            break;
+        }
+        switch (ch = *c->json) {
+            case '"':
+                ret = lept_parse_sax_string(c, h, user, 0);
+                break;
+            case '[':
+            case '{':
+                if (depth == LEPT_PARSE_MAX_DEPTH) {
+                    ret = LEPT_PARSE_TOO_DEEP;
+                    break;
+                }
+                c->json++;
+                if (ch == '[' ? h->start_array && !h->start_array(user) : h->start_object && !h->start_object(user)) {
+                    ret = LEPT_PARSE_STOPPED;
+                    break;
+                }
+                lept_parse_whitespace(c);
+                if (PEEK(c) == (ch == '[' ? ']' : '}')) {
+                    c->json++;
+                    if (ch == '[' ? h->end_array && !h->end_array(user, 0) : h->end_object && !h->end_object(user, 0))
+                        ret = LEPT_PARSE_STOPPED;
+                    else
+                        ret = LEPT_PARSE_OK;
+                    break;
+                }
+                *(size_t*)lept_context_push(&s, sizeof(size_t)) = ch == '{';
+                depth++;
+                if (ch == '{' && (ret = lept_parse_sax_key(c, h, user)) != LEPT_PARSE_OK)
+                    break;
+                continue;
+            default:
+                switch (ch) {
+                    case 't': ret = lept_parse_literal(c, &v, "true", 4, LEPT_TRUE); break;
+                    case 'f': ret = lept_parse_literal(c, &v, "false", 5, LEPT_FALSE); break;
+                    case 'n': ret = lept_parse_literal(c, &v, "null", 4, LEPT_NULL); break;
+                    default:  ret = lept_parse_number(c, &v); break;
+                }
+                if (ret == LEPT_PARSE_OK)
+                    ret = lept_sax_atom(h, user, &v);
+        }
+        if (ret != LEPT_PARSE_OK)
+            break;
+        /* a value is complete, close the containers it completes */
+        while (depth > base) {
+            level = (size_t*)(s.stack + s.top) - 1;
+            *level += 2;
+            lept_parse_whitespace(c);
+            if (PEEK(c) == ',') {
+                c->json++;
+                lept_parse_whitespace(c);
+                if (*level & 1)
+                    ret = lept_parse_sax_key(c, h, user);
+                break;
+            }
+            if (PEEK(c) != (*level & 1 ? '}' : ']')) {
+                ret = *level & 1 ? LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET : LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
+                break;
+            }
+            c->json++;
+            depth--;
+            lept_context_pop(&s, sizeof(size_t));
+            if (*level & 1 ? h->end_object && !h->end_object(user, *level >> 1) : h->end_array && !h->end_array(user, *level >> 1)) {
+                ret = LEPT_PARSE_STOPPED;
+                break;
+            }
+        }
+        if (ret != LEPT_PARSE_OK || depth == base)
+            break;
+    }
+    free(s.stack);
+    return ret;
+}
+
+/*
+ * DOM builder as a handler. Every value goes into the lept_value of a lept_member on c->stack, the key of which
+ * is NULL for array elements and the root. A container keeps its slot while its children are pushed above it.
+ * It stops the parse only at a string, array or object past LEPT_SIZE_MAX, which is LEPT_PARSE_TOO_LARGE.
+ */
+typedef struct {
+    lept_context* c;
+    int have_key;   /* the member on top has its key and waits for the value */
+}lept_dom;
+
+static lept_value* lept_dom_slot(lept_dom* d) {
+    lept_member* m;
+    if (d->have_key) {
+        d->have_key = 0;
+        return &((lept_member*)(d->c->stack + d->c->top) - 1)->v;
+    }
+    m = (lept_member*)lept_context_push(d->c, sizeof(lept_member));
+    m->k = NULL;
+    return &m->v;
+}
+
+static int lept_dom_null(void* user) {
+    lept_init(lept_dom_slot((lept_dom*)user));
+    return 1;
+}
+
+static int lept_dom_boolean(void* user, int b) {
+    lept_dom_slot((lept_dom*)user)->type = b ? LEPT_TRUE : LEPT_FALSE;
+    return 1;
+}
+
+static int lept_dom_number(void* user, double n) {
+    lept_value* v = lept_dom_slot((lept_dom*)user);
+    v->u.n = n;
+    v->type = LEPT_NUMBER;
+    return 1;
+}
+
+static int lept_dom_integer(void* user, int64_t i) {
+    lept_value* v = lept_dom_slot((lept_dom*)user);
+    v->u.i = i;
+    v->type = LEPT_INTEGER;
+    v->flags = 0;
+    return 1;
+}
+
+static int lept_dom_uint64(void* user, uint64_t u) {
+    lept_value* v = lept_dom_slot((lept_dom*)user);
+    v->u.ui = u;
+    v->type = LEPT_INTEGER;
+    v->flags = LEPT_VALUE_UINT64;
+    return 1;
+}
+
+/* Whether s may be referenced rather than copied: it is in the input and the parse flags allow it */
+static int lept_dom_refers(const lept_context* c, const char* s, int key) {
+    return (c->flags & LEPT_PARSE_INSITU) || (!key && (c->flags & LEPT_PARSE_ZERO_COPY_FLAG) && s != c->stack + c->top);
+}
+
+/* Reference s where the parse flags allow it, otherwise copy it before the slot push can overwrite it */
+static char* lept_dom_keep(lept_dom* d, const char* s, size_t len, int key, unsigned char* flags) {
+    char* p;
+    lept_context* c = d->c;
+    if (lept_dom_refers(c, s, key)) {
+        *flags = LEPT_VALUE_STRING_REF;
+        return (char*)s;
+    }
+    *flags = 0;
+    if (key)
+        return lept_intern(c->keys, s, len);
+    if (LEPT_CONTEXT_DOCUMENT(c) != NULL) {
+        *flags = LEPT_VALUE_STRING_REF;
+        p = (char*)lept_document_alloc(c->keys->document, len + 1);
+    }
+    else
+        p = (char*)malloc(len + 1);
+    if (len > 0)
+        memcpy(p, s, len);
+    p[len] = '\0';
+    return p;
+}
+
+static void lept_set_string_short(lept_value* v, const char* s, size_t len);
+
+static int lept_dom_string(void* user, const char* s, size_t len) {
+    lept_dom* d = (lept_dom*)user;
+    unsigned char flags;
+    char* p, buf[sizeof(((lept_value*)0)->u.ss)];
+    lept_value* v;
+    if (len > LEPT_SIZE_MAX)
+        return 0;
+    if (len <= LEPT_STRING_SHORT_MAX && !lept_dom_refers(d->c, s, 0)) {
+        if (len > 0)
+            memcpy(buf, s, len);
+        lept_set_string_short(lept_dom_slot(d), buf, len);
+        return 1;
+    }
+    p = lept_dom_keep(d, s, len, 0, &flags);
+    v = lept_dom_slot(d);
+    v->u.s.s = p;
+    LEPT_STRING_LENGTH(v) = len;
+    v->type = LEPT_STRING;
+    v->flags = flags;
+    return 1;
+}
+
+static int lept_dom_key(void* user, const char* s, size_t len) {
+    lept_dom* d = (lept_dom*)user;
+    unsigned char flags;
+    char* k = lept_dom_keep(d, s, len, 1, &flags);
+    lept_member* m = (lept_member*)lept_context_push(d->c, sizeof(lept_member));
+    m->k = k;
+    m->klen = len;
+    lept_init(&m->v);
+    d->have_key = 1;
+    return 1;
+}
+
+static int lept_dom_start(void* user) {
+    lept_init(lept_dom_slot((lept_dom*)user));
+    return 1;
+}
+
+/* lept_set_array() for count elements of the DOM being built, taken from its document if it has one */
+static void lept_dom_set_array(lept_context* c, lept_value* v, size_t count) {
+    lept_document* d = LEPT_CONTEXT_DOCUMENT(c);
+    if (d == NULL) {
+        lept_set_array(v, count);
+        return;
+    }
+    v->type = LEPT_ARRAY;
+    v->flags = LEPT_VALUE_STORAGE_REF;
+    LEPT_ARRAY_SIZE(v) = 0;
+    LEPT_SET_CAPACITY(v->u.a, count);
+    v->u.a.e = (lept_value*)lept_document_storage(d, count, sizeof(lept_value));
+}
+
+static void lept_dom_set_object(lept_context* c, lept_value* v, size_t count) {
+    lept_document* d = LEPT_CONTEXT_DOCUMENT(c);
+    if (d == NULL) {
+        lept_set_object(v, count);
+        return;
+    }
+    v->type = LEPT_OBJECT;
+    v->flags = LEPT_VALUE_STORAGE_REF | LEPT_VALUE_KEYS_REF;
+    LEPT_OBJECT_SIZE(v) = 0;
+    LEPT_SET_CAPACITY(v->u.o, count);
+    v->u.o.m = (lept_member*)lept_document_storage(d, count, sizeof(lept_member));
+}
+
+/* Drop a key of the DOM being built that no object took */
+static void lept_dom_release_key(lept_context* c, char* k) {
+    if (!(c->flags & LEPT_PARSE_INSITU) && LEPT_CONTEXT_DOCUMENT(c) == NULL)
+        lept_key_release(k);
+}
+
+static int lept_dom_end_array(void* user, size_t count) {
+    lept_context* c = ((lept_dom*)user)->c;
+    lept_member* m;
+    lept_value* v;
+    size_t i;
+    if (count > LEPT_SIZE_MAX)
+        return 0;
+    m = (lept_member*)lept_context_pop(c, count * sizeof(lept_member));
+    v = &((lept_member*)(c->stack + c->top) - 1)->v;
+    lept_dom_set_array(c, v, count);
+    for (i = 0; i < count; i++)
+        memcpy(&v->u.a.e[i], &m[i].v, sizeof(lept_value));
+    LEPT_ARRAY_SIZE(v) = count;
+    return 1;
+}
+
+static int lept_dom_end_object(void* user, size_t count) {
+    lept_context* c = ((lept_dom*)user)->c;
+    lept_member* m;
+    lept_value* v;
+    if (count > LEPT_SIZE_MAX)
+        return 0;
+    m = (lept_member*)lept_context_pop(c, count * sizeof(lept_member));
+    v = &((lept_member*)(c->stack + c->top) - 1)->v;
+    lept_dom_set_object(c, v, count);
+    if (count > 0)
+        memcpy(v->u.o.m, m, count * sizeof(lept_member));
+    LEPT_OBJECT_SIZE(v) = count;
+    if (c->flags & LEPT_PARSE_INSITU)
+        v->flags |= LEPT_VALUE_KEYS_REF;
+    return 1;
+}
+
+static const lept_handler lept_dom_handler = {
+    lept_dom_null, lept_dom_boolean, lept_dom_number, lept_dom_integer, lept_dom_uint64, lept_dom_string,
+    lept_dom_start, lept_dom_key, lept_dom_end_object, lept_dom_start, lept_dom_end_array
+};
+
+/* Pop and free the members above head */
+static void lept_dom_unwind(lept_context* c, size_t head) {
+    while (c->top > head) {
+        lept_member* m = (lept_member*)lept_context_pop(c, sizeof(lept_member));
+        if (m->k != NULL)
+            lept_dom_release_key(c, m->k);
+        lept_free(&m->v);
+    }
+}
+
+/* depth: containers open around the value */
+static int lept_parse_value(lept_context* c, lept_value* v, size_t depth) {
+    lept_dom d;
+    size_t head = c->top;
+    int ret;
+    d.c = c;
+    d.have_key = 0;
+    if ((ret = lept_parse_sax_value(c, &lept_dom_handler, &d, depth)) == LEPT_PARSE_OK) {
+        assert(c->top == head + sizeof(lept_member));
+        memcpy(v, &((lept_member*)lept_context_pop(c, sizeof(lept_member)))->v, sizeof(lept_value));
+    }
+    else {
+        lept_dom_unwind(c, head);
+        if (ret == LEPT_PARSE_STOPPED)
+            ret = LEPT_PARSE_TOO_LARGE;
+    }
+    return ret;
+}
+
+int lept_parse_sax(const char* json, size_t len, const lept_handler* h, void* user) {
+    lept_context c;
+    int ret;
+    assert(json != NULL && h != NULL);
+    if (lept_utf8_check(json, json + len) != json + len)
+        return LEPT_PARSE_INVALID_UTF8;
+    c.json = json;
+    c.end = json + len;
+    c.stack = NULL;
+    c.size = c.top = 0;
+    c.flags = 0;
+    c.keys = NULL;
+    lept_parse_whitespace(&c);
+    if ((ret = lept_parse_sax_value(&c, h, user, 0)) == LEPT_PARSE_OK) {
+        lept_parse_whitespace(&c);
+        if (c.json != c.end)
+            ret = LEPT_PARSE_ROOT_NOT_SINGULAR;
+    }
+    assert(c.top == 0);
+    free(c.stack);
+    return ret;
+}
+
+/*
+ * Push parser. The grammar of lept_parse_sax_value() is unrolled into states so that parsing can stop at the end of
+ * any chunk and go on with the next one. A string is decoded and a number collected on the stack above p->mark,
+ * the number is converted by lept_parse_number() once the byte after it is seen.
+ */
+enum {
+    LEPT_PUSH_VALUE,        /* before a value */
+    LEPT_PUSH_ARRAY,        /* after '[': ']' or a value */
+    LEPT_PUSH_OBJECT,       /* after '{': '}' or a key */
+    LEPT_PUSH_KEY,          /* after ',' in an object */
+    LEPT_PUSH_COLON,
+    LEPT_PUSH_AFTER,        /* after a value, the root is complete at depth 0 */
+    LEPT_PUSH_LITERAL,      /* n bytes of lept_push_literals[u] matched */
+    LEPT_PUSH_STRING,       /* states from here on have a token above p->mark */
+    LEPT_PUSH_ESCAPE,       /* after '\\' */
+    LEPT_PUSH_HEX,          /* n hex digits of \u read into u */
+    LEPT_PUSH_SURROGATE,    /* after a high surrogate, expecting '\\' */
+    LEPT_PUSH_SURROGATE_U,  /* expecting 'u' */
+    LEPT_PUSH_HEX_LOW,      /* n hex digits of the low surrogate read into u, the high one in hi */
+    LEPT_PUSH_NUMBER
+};
+
+static const char* const lept_push_literals[] = { "null", "false", "true" }; /* indexed by lept_type */
+
+#define ISNUMBERCHAR(ch)    (lept_char_class[(unsigned char)(ch)] & LEPT_CHAR_NUMBER)
+
+static int lept_push_after_error(const lept_push* p) {
+    if (p->depth == 0)
+        return LEPT_PARSE_ROOT_NOT_SINGULAR;
+    return p->level[p->depth - 1] & 1 ? LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET : LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
+}
+
+/* The error lept_parse_n() reports when the input ends in the current state */
+static int lept_push_end_error(const lept_push* p) {
+    switch (p->state) {
+        case LEPT_PUSH_VALUE:
+        case LEPT_PUSH_ARRAY:       return LEPT_PARSE_EXPECT_VALUE;
+        case LEPT_PUSH_OBJECT:
+        case LEPT_PUSH_KEY:         return LEPT_PARSE_MISS_KEY;
+        case LEPT_PUSH_COLON:       return LEPT_PARSE_MISS_COLON;
+        case LEPT_PUSH_AFTER:       return lept_push_after_error(p);
+        case LEPT_PUSH_LITERAL:     return LEPT_PARSE_INVALID_VALUE;
+        case LEPT_PUSH_STRING:
+        case LEPT_PUSH_ESCAPE:      return LEPT_PARSE_MISS_QUOTATION_MARK;
+        case LEPT_PUSH_HEX:
+        case LEPT_PUSH_HEX_LOW:     return LEPT_PARSE_INVALID_UNICODE_HEX;
+        default:                    return LEPT_PARSE_INVALID_UNICODE_SURROGATE;
+    }
+}
+
+/* A value is complete, count it in its container */
+static void lept_push_value(lept_push* p) {
+    if (p->depth > 0)
+        p->level[p->depth - 1] += 2;
+    p->state = LEPT_PUSH_AFTER;
+}
+
+static int lept_push_open(lept_push* p, const lept_handler* h, void* user, int object) {
+    if (p->depth == LEPT_PARSE_MAX_DEPTH)
+        return LEPT_PARSE_TOO_DEEP;
+    if (p->depth == p->capacity) {
+        p->capacity = p->capacity == 0 ? 16 : p->capacity + (p->capacity >> 1);
+        p->level = (size_t*)realloc(p->level, p->capacity * sizeof(size_t));
+    }
+    p->level[p->depth++] = (size_t)object;
+    p->state = object ? LEPT_PUSH_OBJECT : LEPT_PUSH_ARRAY;
+    if (object ? h->start_object && !h->start_object(user) : h->start_array && !h->start_array(user))
+        return LEPT_PARSE_STOPPED;
+    return LEPT_PARSE_OK;
+}
+
+static int lept_push_close(lept_push* p, const lept_handler* h, void* user) {
+    size_t level = p->level[--p->depth];
+    lept_push_value(p);
+    if (level & 1 ? h->end_object && !h->end_object(user, level >> 1) : h->end_array && !h->end_array(user, level >> 1))
+        return LEPT_PARSE_STOPPED;
+    return LEPT_PARSE_OK;
+}
+
+static int lept_push_string(lept_push* p, lept_context* c, const lept_handler* h, void* user) {
+    size_t len = c->top - p->mark;
+    const char* s = (const char*)lept_context_pop(c, len);
+    if (p->key) {
+        p->state = LEPT_PUSH_COLON;
+        return h->key && !h->key(user, s, len) ? LEPT_PARSE_STOPPED : LEPT_PARSE_OK;
+    }
+    lept_push_value(p);
+    return h->string && !h->string(user, s, len) ? LEPT_PARSE_STOPPED : LEPT_PARSE_OK;
+}
+
+/* Bytes lept_parse_number() leaves are never valid after a value, so they are reported like any other */
+static int lept_push_number(lept_push* p, lept_context* c, const lept_handler* h, void* user) {
+    lept_context t;
+    lept_value v;
+    int ret, rest;
+    t.json = c->stack + p->mark;
+    t.end = c->stack + c->top;
+    t.stack = NULL;
+    t.size = t.top = 0;
+    t.flags = 0;
+    ret = lept_parse_number(&t, &v);
+    rest = t.json != t.end;
+    free(t.stack);
+    c->top = p->mark;
+    if (ret != LEPT_PARSE_OK)
+        return ret;
+    lept_push_value(p);
+    if ((ret = lept_sax_atom(h, user, &v)) != LEPT_PARSE_OK)
+        return ret;
+    return rest ? lept_push_after_error(p) : LEPT_PARSE_OK;
+}
+
+static int lept_push_step(lept_push* p, lept_context* c, const lept_handler* h, void* user) {
+    const char* q;
+    lept_value v;
+    int ret, x;
+    char ch;
+    while (c->json != c->end) {
+        ret = LEPT_PARSE_OK;
+        switch (p->state) {
+            case LEPT_PUSH_STRING:
+                if ((q = lept_scan_string(c->json, c->end)) != c->json) {
+                    PUTS(c, c->json, (size_t)(q - c->json));
+                    c->json = q;
+                }
+                if (q == c->end)
+                    return LEPT_PARSE_OK;
+                ch = *c->json++;
+                if (ch == '\"')
+                    ret = lept_push_string(p, c, h, user);
+                else if (ch == '\\')
+                    p->state = LEPT_PUSH_ESCAPE;
+                else
+                    return LEPT_PARSE_INVALID_STRING_CHAR;
+                break;
+            case LEPT_PUSH_ESCAPE:
+                p->state = LEPT_PUSH_STRING;
+                switch (ch = *c->json++) {
+                    case '\"':
+                    case '\\':
+                    case '/':  PUTC(c, ch); break;
+                    case 'b':  PUTC(c, '\b'); break;
+                    case 'f':  PUTC(c, '\f'); break;
+                    case 'n':  PUTC(c, '\n'); break;
+                    case 'r':  PUTC(c, '\r'); break;
+                    case 't':  PUTC(c, '\t'); break;
+                    case 'u':
+                        p->u = 0;
+                        p->n = 0;
+                        p->state = LEPT_PUSH_HEX;
+                        break;
+                    default:
+                        return LEPT_PARSE_INVALID_STRING_ESCAPE;
+                }
+                break;
+            case LEPT_PUSH_HEX:
+            case LEPT_PUSH_HEX_LOW:
+                if ((x = lept_hex_digit[(unsigned char)*c->json++]) < 0)
+                    return LEPT_PARSE_INVALID_UNICODE_HEX;
+                p->u = p->u << 4 | (unsigned)x;
+                if (++p->n < 4)
+                    break;
+                if (p->state == LEPT_PUSH_HEX_LOW) {
+                    if (p->u < 0xDC00 || p->u > 0xDFFF)
+                        return LEPT_PARSE_INVALID_UNICODE_SURROGATE;
+                    lept_encode_utf8(c, (((p->hi - 0xD800) << 10) | (p->u - 0xDC00)) + 0x10000);
+                    p->state = LEPT_PUSH_STRING;
+                }
+                else if (p->u >= 0xD800 && p->u <= 0xDBFF) {
+                    p->hi = p->u;
+                    p->state = LEPT_PUSH_SURROGATE;
+                }
+                else if (p->u >= 0xDC00 && p->u <= 0xDFFF)
+                    return LEPT_PARSE_INVALID_UNICODE_SURROGATE;
+                else {
+                    lept_encode_utf8(c, p->u);
+                    p->state = LEPT_PUSH_STRING;
+                }
+                break;
+            case LEPT_PUSH_SURROGATE:
+                if (*c->json++ != '\\')
+                    return LEPT_PARSE_INVALID_UNICODE_SURROGATE;
+                p->state = LEPT_PUSH_SURROGATE_U;
+                break;
+            case LEPT_PUSH_SURROGATE_U:
+                if (*c->json++ != 'u')
+                    return LEPT_PARSE_INVALID_UNICODE_SURROGATE;
+                p->u = 0;
+                p->n = 0;
+                p->state = LEPT_PUSH_HEX_LOW;
+                break;
+            case LEPT_PUSH_NUMBER:
+                for (q = c->json; q != c->end && ISNUMBERCHAR(*q); q++)
+                    ;
+                if (q != c->json) {
+                    PUTS(c, c->json, (size_t)(q - c->json));
+                    c->json = q;
+                }
+                if (q != c->end)
+                    ret = lept_push_number(p, c, h, user);
+                break;
+            case LEPT_PUSH_LITERAL:
+                if (*c->json++ != lept_push_literals[p->u][p->n])
+                    return LEPT_PARSE_INVALID_VALUE;
+                if (lept_push_literals[p->u][++p->n] == '\0') {
+                    v.type = (lept_type)p->u;
+                    lept_push_value(p);
+                    ret = lept_sax_atom(h, user, &v);
+                }
+                break;
+            default:
+                if ((c->json = lept_skip_whitespace(c->json, c->end)) == c->end)
+                    return LEPT_PARSE_OK;
+                ch = *c->json++;
+                switch (p->state) {
+                    case LEPT_PUSH_AFTER:
+                        if (p->depth > 0 && ch == ',')
+                            p->state = p->level[p->depth - 1] & 1 ? LEPT_PUSH_KEY : LEPT_PUSH_VALUE;
+                        else if (p->depth > 0 && ch == (p->level[p->depth - 1] & 1 ? '}' : ']'))
+                            ret = lept_push_close(p, h, user);
+                        else
+                            return lept_push_after_error(p);
+                        break;
+                    case LEPT_PUSH_COLON:
+                        if (ch != ':')
+                            return LEPT_PARSE_MISS_COLON;
+                        p->state = LEPT_PUSH_VALUE;
+                        break;
+                    case LEPT_PUSH_OBJECT:
+                        if (ch == '}') {
+                            ret = lept_push_close(p, h, user);
+                            break;
+                        }
+                        /* fall through */
+                    case LEPT_PUSH_KEY:
+                        if (ch != '\"')
+                            return LEPT_PARSE_MISS_KEY;
+                        p->key = 1;
+                        p->mark = c->top;
+                        p->state = LEPT_PUSH_STRING;
+                        break;
+                    case LEPT_PUSH_ARRAY:
+                        if (ch == ']') {
+                            ret = lept_push_close(p, h, user);
+                            break;
+                        }
+                        /* fall through */
+                    default:
+                        switch (ch) {
+                            case '\"':
+                                p->key = 0;
+                                p->mark = c->top;
+                                p->state = LEPT_PUSH_STRING;
+                                break;
+                            case '[': ret = lept_push_open(p, h, user, 0); break;
+                            case '{': ret = lept_push_open(p, h, user, 1); break;
+                            case 'n':
+                            case 'f':
+                            case 't':
+                                p->u = ch == 'n' ? LEPT_NULL : ch == 'f' ? LEPT_FALSE : LEPT_TRUE;
+                                p->n = 1;
+                                p->state = LEPT_PUSH_LITERAL;
+                                break;
+                            default:
+                                if (ch != '-' && !ISDIGIT(ch))
+                                    return LEPT_PARSE_INVALID_VALUE;
+                                p->mark = c->top;
+                                PUTC(c, ch);
+                                p->state = LEPT_PUSH_NUMBER;
+                        }
+                }
+        }
+        if (ret != LEPT_PARSE_OK)
+            return ret;
+    }
+    return LEPT_PARSE_OK;
+}
+
+void lept_push_init(lept_push* p, const lept_handler* h, void* user) {
+    assert(p != NULL);
+    p->h = h;
+    p->user = user;
+    lept_init(&p->v);
+    p->stack = NULL;
+    p->size = p->top = p->mark = 0;
+    p->level = NULL;
+    p->depth = p->capacity = 0;
+    p->state = LEPT_PUSH_VALUE;
+    p->key = p->have_key = 0;
+    p->u = p->hi = 0;
+    p->n = 0;
+    p->utf8_len = 0;
+    p->keys = NULL;
+    p->error = LEPT_PARSE_OK;
+}
+
+/* Drop the token being read and, when building the DOM, the unfinished members and the root */
+static void lept_push_discard(lept_push* p, lept_context* c) {
+    if (p->state >= LEPT_PUSH_STRING)
+        c->top = p->mark;
+    if (p->h == NULL)
+        lept_dom_unwind(c, 0);
+    c->top = 0;
+    p->state = LEPT_PUSH_VALUE;
+    lept_free(&p->v);
+}
+
+/* Check a chunk as UTF-8, a sequence cut by its end is kept and completed by the next one */
+static int lept_push_utf8(lept_push* p, const char* chunk, size_t len) {
+    const char* end = chunk + len, * r;
+    char buf[4];
+    size_t n = p->utf8_len, k;
+    if (len == 0)
+        return n == 0 ? LEPT_PARSE_OK : LEPT_PARSE_INVALID_UTF8;
+    if (n > 0) {
+        k = 4 - n < len ? 4 - n : len;
+        memcpy(buf, p->utf8, n);
+        memcpy(buf + n, chunk, k);
+        if ((r = lept_utf8_check(buf, buf + n + k)) == NULL)
+            return LEPT_PARSE_INVALID_UTF8;
+        if (r == buf) { /* still cut */
+            memcpy(p->utf8, buf, p->utf8_len = n + k);
+            return LEPT_PARSE_OK;
+        }
+        chunk += r - buf - n;
+    }
+    if ((r = lept_utf8_check(chunk, end)) == NULL)
+        return LEPT_PARSE_INVALID_UTF8;
+    memcpy(p->utf8, r, p->utf8_len = (size_t)(end - r));
+    return LEPT_PARSE_OK;
+}
+
+int lept_feed(lept_push* p, const char* chunk, size_t len) {
+    lept_context c;
+    lept_dom d;
+    const lept_handler* h = p->h ? p->h : &lept_dom_handler;
+    void* user = p->h ? p->user : &d;
+    int ret;
+    assert(p != NULL && (chunk != NULL || len == 0));
+    if (p->error != LEPT_PARSE_OK)
+        return p->error;
+    c.json = chunk;
+    c.end = chunk + len;
+    c.stack = p->stack;
+    c.size = p->size;
+    c.top = p->top;
+    c.flags = 0;
+    if (p->h == NULL && p->keys == NULL) {
+        p->keys = (lept_keys*)malloc(sizeof(lept_keys));
+        lept_keys_init(p->keys);
+    }
+    c.keys = p->keys;
+    d.c = &c;
+    d.have_key = p->have_key;
+    ret = lept_push_utf8(p, chunk, len);
+    if (ret == LEPT_PARSE_OK && len > 0)
+        ret = lept_push_step(p, &c, h, user);
+    else if (ret == LEPT_PARSE_OK && p->state == LEPT_PUSH_NUMBER)
+        ret = lept_push_number(p, &c, h, user);
+    if (ret == LEPT_PARSE_STOPPED && p->h == NULL)
+        ret = LEPT_PARSE_TOO_LARGE;
+    if (ret == LEPT_PARSE_OK) {
+        if (p->state == LEPT_PUSH_AFTER && p->depth == 0) {
+            if (c.top > 0) /* the root built by the DOM handler */
+                memcpy(&p->v, &((lept_member*)lept_context_pop(&c, sizeof(lept_member)))->v, sizeof(lept_value));
+        }
+        else
+            ret = len == 0 ? lept_push_end_error(p) : LEPT_PARSE_INCOMPLETE;
+    }
+    if (ret != LEPT_PARSE_OK && ret != LEPT_PARSE_INCOMPLETE) {
+        lept_push_discard(p, &c);
+        p->error = ret;
+    }
+    p->stack = c.stack;
+    p->size = c.size;
+    p->top = c.top;
+    p->have_key = d.have_key;
+    return ret;
+}
+
+void lept_push_get_value(lept_push* p, lept_value* v) {
+    assert(p != NULL && p->h == NULL);
+    lept_move(v, &p->v);
+}
+
+void lept_push_free(lept_push* p) {
+    lept_context c;
+    assert(p != NULL);
+    c.stack = p->stack;
+    c.size = p->size;
+    c.top = p->top;
+    c.flags = 0;
+    c.keys = p->keys;
+    lept_push_discard(p, &c);
+    if (p->keys != NULL)
+        lept_keys_free(p->keys);
+    free(p->keys);
+    free(c.stack);
+    free(p->level);
+    p->stack = NULL;
+    p->level = NULL;
+    p->keys = NULL;
+    p->size = p->top = p->depth = p->capacity = p->utf8_len = 0;
+}
+
+/*
+ * Two-stage engine (LEPT_PARSE_STRUCTURAL_FLAG). Stage one classifies the input 64 bytes at a time and
+ * records the offset of every structural character, opening quote and first byte of a literal or number
+ * outside strings. Stage two walks those offsets to build the tree, so whitespace between tokens is never
+ * looked at. Values are still parsed by the routines above. On any error the document is parsed again by
+ * lept_parse_value(), which reports the same error code as the default engine.
+ */
+typedef struct {
+    uint64_t quote, backslash, op, space;
+    uint64_t open, close; /* the brackets among op */
+}lept_block;
+
+typedef struct {
+    const char* json;
+    uint32_t* pos;
+    size_t size, i, depth; /* depth: containers open at token i */
+}lept_index;
+
+static unsigned lept_ctz64(uint64_t x) {
+    assert(x != 0);
+#if defined(__GNUC__)
+    return (unsigned)__builtin_ctzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    {
+        unsigned long i;
+        _BitScanForward64(&i, x);
+        return (unsigned)i;
+    }
+#else
+    {
+        unsigned n = 0;
+        for (; !(x & 1); x >>= 1)
+            n++;
+        return n;
+    }
+#endif
+}
+
+static void lept_classify_block(const char* p, lept_block* b) {
+#if defined(LEPT_AVX2)
+    const __m256i dq = _mm256_set1_epi8('\"'), bs = _mm256_set1_epi8('\\');
+    const __m256i sp = _mm256_set1_epi8(' '), nl = _mm256_set1_epi8('\n'), cr = _mm256_set1_epi8('\r'), ht = _mm256_set1_epi8('\t');
+    const __m256i lb = _mm256_set1_epi8('['), rb = _mm256_set1_epi8(']'), lc = _mm256_set1_epi8('{');
+    const __m256i rc = _mm256_set1_epi8('}'), co = _mm256_set1_epi8(':'), cm = _mm256_set1_epi8(',');
+    int i;
+    b->quote = b->backslash = b->op = b->space = b->open = b->close = 0;
+    for (i = 0; i < 64; i += 32) {
+        const __m256i s = _mm256_loadu_si256((const __m256i*)(p + i));
+        const __m256i open = _mm256_or_si256(_mm256_cmpeq_epi8(s, lb), _mm256_cmpeq_epi8(s, lc));
+        const __m256i close = _mm256_or_si256(_mm256_cmpeq_epi8(s, rb), _mm256_cmpeq_epi8(s, rc));
+        __m256i op = _mm256_or_si256(open, close);
+        __m256i ws = _mm256_or_si256(_mm256_cmpeq_epi8(s, sp), _mm256_cmpeq_epi8(s, nl));
+        op = _mm256_or_si256(op, _mm256_or_si256(_mm256_cmpeq_epi8(s, co), _mm256_cmpeq_epi8(s, cm)));
+        ws = _mm256_or_si256(ws, _mm256_or_si256(_mm256_cmpeq_epi8(s, cr), _mm256_cmpeq_epi8(s, ht)));
+        b->quote |= (uint64_t)(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(s, dq)) << i;
+        b->backslash |= (uint64_t)(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(s, bs)) << i;
+        b->op |= (uint64_t)(unsigned)_mm256_movemask_epi8(op) << i;
+        b->space |= (uint64_t)(unsigned)_mm256_movemask_epi8(ws) << i;
+        b->open |= (uint64_t)(unsigned)_mm256_movemask_epi8(open) << i;
+        b->close |= (uint64_t)(unsigned)_mm256_movemask_epi8(close) << i;
+    }
+#elif defined(LEPT_SSE2)
+    const __m128i dq = _mm_set1_epi8('\"'), bs = _mm_set1_epi8('\\');
+    const __m128i sp = _mm_set1_epi8(' '), nl = _mm_set1_epi8('\n'), cr = _mm_set1_epi8('\r'), ht = _mm_set1_epi8('\t');
+    const __m128i lb = _mm_set1_epi8('['), rb = _mm_set1_epi8(']'), lc = _mm_set1_epi8('{');
+    const __m128i rc = _mm_set1_epi8('}'), co = _mm_set1_epi8(':'), cm = _mm_set1_epi8(',');
+    int i;
+    b->quote = b->backslash = b->op = b->space = b->open = b->close = 0;
+    for (i = 0; i < 64; i += 16) {
+        const __m128i s = _mm_loadu_si128((const __m128i*)(p + i));
+        const __m128i open = _mm_or_si128(_mm_cmpeq_epi8(s, lb), _mm_cmpeq_epi8(s, lc));
+        const __m128i close = _mm_or_si128(_mm_cmpeq_epi8(s, rb), _mm_cmpeq_epi8(s, rc));
+        __m128i op = _mm_or_si128(open, close);
+        __m128i ws = _mm_or_si128(_mm_cmpeq_epi8(s, sp), _mm_cmpeq_epi8(s, nl));
+        op = _mm_or_si128(op, _mm_or_si128(_mm_cmpeq_epi8(s, co), _mm_cmpeq_epi8(s, cm)));
+        ws = _mm_or_si128(ws, _mm_or_si128(_mm_cmpeq_epi8(s, cr), _mm_cmpeq_epi8(s, ht)));
+        b->quote |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(s, dq)) << i;
+        b->backslash |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(s, bs)) << i;
+        b->op |= (uint64_t)(unsigned)_mm_movemask_epi8(op) << i;
+        b->space |= (uint64_t)(unsigned)_mm_movemask_epi8(ws) << i;
+        b->open |= (uint64_t)(unsigned)_mm_movemask_epi8(open) << i;
+        b->close |= (uint64_t)(unsigned)_mm_movemask_epi8(close) << i;
+    }
+#else
+    int i;
+    b->quote = b->backslash = b->op = b->space = b->open = b->close = 0;
+    for (i = 0; i < 64; i++) {
+        uint64_t bit = UINT64_C(1) << i;
+        switch (p[i]) {
+            case '\"': b->quote |= bit; break;
+            case '\\': b->backslash |= bit; break;
+            case '[': case '{': b->open |= bit; b->op |= bit; break;
+            case ']': case '}': b->close |= bit; b->op |= bit; break;
+            case ':': case ',': b->op |= bit; break;
+            case ' ': case '\n': case '\r': case '\t': b->space |= bit; break;
+        }
+    }
+#endif
+}
+
+static unsigned lept_popcount64(uint64_t x) {
+#if defined(__GNUC__)
+    return (unsigned)__builtin_popcountll(x);
+#else
+    x -= (x >> 1) & UINT64_C(0x5555555555555555);
+    x = (x & UINT64_C(0x3333333333333333)) + ((x >> 2) & UINT64_C(0x3333333333333333));
+    x = (x + (x >> 4)) & UINT64_C(0x0F0F0F0F0F0F0F0F);
+    return (unsigned)((x * UINT64_C(0x0101010101010101)) >> 56);
+#endif
+}
+
+/* Characters escaped by a backslash, an odd run of backslashes escapes the character after it */
+static uint64_t lept_find_escaped(uint64_t backslash, uint64_t* prev_escaped) {
+    const uint64_t even = UINT64_C(0x5555555555555555);
+    uint64_t follows, odd_starts, sum;
+    backslash &= ~*prev_escaped;
+    follows = backslash << 1 | *prev_escaped;
+    odd_starts = backslash & ~even & ~follows;
+    sum = odd_starts + backslash; /* adding a run's start bit clears the run, which marks runs starting on odd bits */
+    *prev_escaped = sum < odd_starts;
+    return (even ^ (sum << 1)) & follows;
+}
+
+/* Bit i becomes the xor of bits 0..i, turning quote positions into a mask of string contents */
+static uint64_t lept_prefix_xor(uint64_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+static void lept_build_index(lept_index* x, const char* json, size_t len) {
+    uint64_t prev_escaped = 0, prev_in_string = 0, prev_scalar = 0;
+    size_t i;
+    char tail[64];
+    x->json = json;
+    x->pos = (uint32_t*)malloc((len + 1) * sizeof(uint32_t));
+    x->size = x->i = x->depth = 0;
+    for (i = 0; i < len; i += 64) {
+        const char* p = json + i;
+        lept_block b;
+        uint64_t quote, in_string, scalar, tokens;
+        if (len - i < 64) { /* pad the last block with whitespace */
+            memset(tail, ' ', sizeof(tail));
+            memcpy(tail, p, len - i);
+            p = tail;
+        }
+        lept_classify_block(p, &b);
+        quote = b.quote & ~lept_find_escaped(b.backslash, &prev_escaped);
+        in_string = lept_prefix_xor(quote) ^ prev_in_string; /* opening quote and contents, not the closing quote */
+        prev_in_string = 0 - (in_string >> 63);
+        scalar = ~(b.op | b.space | quote | in_string);
+        tokens = (b.op & ~in_string) | (quote & in_string) | (scalar & ~(scalar << 1 | prev_scalar));
+        prev_scalar = scalar >> 63;
+        for (; tokens != 0; tokens &= tokens - 1)
+            x->pos[x->size++] = (uint32_t)(i + lept_ctz64(tokens));
+    }
+}
+
+/* Consume the current token and move to the next one */
+static void lept_index_next(lept_context* c, lept_index* x) {
+    c->json = ++x->i < x->size ? x->json + x->pos[x->i] : c->end;
+}
+
+/* After a string, literal or number only whitespace may come before the next token */
+static int lept_index_sync(lept_context* c, lept_index* x) {
+    const char* p = ++x->i < x->size ? x->json + x->pos[x->i] : c->end;
+    if (c->json != p)
+        lept_parse_whitespace(c);
+    return c->json == p;
+}
+
+static int lept_parse_indexed_value(lept_context* c, lept_index* x, lept_value* v);
+
+static int lept_parse_indexed_array(lept_context* c, lept_index* x, lept_value* v) {
+    size_t i, size = 0;
+    int ret;
+    lept_index_next(c, x);
+    if (PEEK(c) == ']') {
+        lept_index_next(c, x);
+        lept_dom_set_array(c, v, 0);
+        return LEPT_PARSE_OK;
+    }
+    x->depth++;
+    for (;;) {
+        lept_value e;
+        lept_init(&e);
+        if ((ret = lept_parse_indexed_value(c, x, &e)) != LEPT_PARSE_OK)
+            break;
+        memcpy(lept_context_push(c, sizeof(lept_value)), &e, sizeof(lept_value));
+        size++;
+        if (PEEK(c) == ',')
+            lept_index_next(c, x);
+        else if (PEEK(c) == ']' && size > LEPT_SIZE_MAX) {
+            ret = LEPT_PARSE_TOO_LARGE;
+            break;
+        }
+        else if (PEEK(c) == ']') {
+            lept_index_next(c, x);
+            x->depth--;
+            lept_dom_set_array(c, v, size);
+            memcpy(v->u.a.e, lept_context_pop(c, size * sizeof(lept_value)), size * sizeof(lept_value));
+            LEPT_ARRAY_SIZE(v) = size;
+            return LEPT_PARSE_OK;
+        }
+        else {
+            ret = LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
+            break;
+        }
+    }
+    for (i = 0; i < size; i++)
+        lept_free((lept_value*)lept_context_pop(c, sizeof(lept_value)));
+    return ret;
+}
+
+static int lept_parse_indexed_object(lept_context* c, lept_index* x, lept_value* v) {
+    size_t i, size = 0;
+    lept_member m;
+    int ret;
+    lept_index_next(c, x);
+    if (PEEK(c) == '}') {
+        lept_index_next(c, x);
+        lept_dom_set_object(c, v, 0);
+        return LEPT_PARSE_OK;
+    }
+    x->depth++;
+    m.k = NULL;
+    for (;;) {
+        char* str;
+        lept_init(&m.v);
+        if (PEEK(c) != '"') {
+            ret = LEPT_PARSE_MISS_KEY;
+            break;
+        }
+        if ((ret = lept_parse_string_raw(c, &str, &m.klen)) != LEPT_PARSE_OK)
+            break;
+        m.k = lept_intern(c->keys, str, m.klen);
+        if (!lept_index_sync(c, x) || PEEK(c) != ':') {
+            ret = LEPT_PARSE_MISS_COLON;
+            break;
+        }
+        lept_index_next(c, x);
+        if ((ret = lept_parse_indexed_value(c, x, &m.v)) != LEPT_PARSE_OK)
+            break;
+        memcpy(lept_context_push(c, sizeof(lept_member)), &m, sizeof(lept_member));
+        size++;
+        m.k = NULL;
+        if (PEEK(c) == ',')
+            lept_index_next(c, x);
+        else if (PEEK(c) == '}' && size > LEPT_SIZE_MAX) {
+            ret = LEPT_PARSE_TOO_LARGE;
+            break;
+        }
+        else if (PEEK(c) == '}') {
+            lept_index_next(c, x);
+            x->depth--;
+            lept_dom_set_object(c, v, size);
+            memcpy(v->u.o.m, lept_context_pop(c, sizeof(lept_member) * size), sizeof(lept_member) * size);
+            LEPT_OBJECT_SIZE(v) = size;
+            return LEPT_PARSE_OK;
+        }
+        else {
+            ret = LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+            break;
+        }
+    }
+    if (m.k != NULL)
+        lept_dom_release_key(c, m.k);
+    for (i = 0; i < size; i++) {
+        lept_member* m = (lept_member*)lept_context_pop(c, sizeof(lept_member));
+        lept_dom_release_key(c, m->k);
+        lept_free(&m->v);
+    }
+    v->type = LEPT_NULL;
+    return ret;
+}
+
+/* On return c->json is at the token after the value */
+static int lept_parse_indexed_value(lept_context* c, lept_index* x, lept_value* v) {
+    int ret;
+    if ((PEEK(c) == '[' || PEEK(c) == '{') && x->depth == LEPT_PARSE_MAX_DEPTH)
+        return LEPT_PARSE_TOO_DEEP;
+    switch (PEEK(c)) {
+        case '[': return lept_parse_indexed_array(c, x, v);
+        case '{': return lept_parse_indexed_object(c, x, v);
+        default:
+            if ((ret = lept_parse_value(c, v, 0)) == LEPT_PARSE_OK && !lept_index_sync(c, x)) {
+                lept_free(v);
+                ret = LEPT_PARSE_INVALID_VALUE; /* e.g. "1x", reported exactly by the fallback */
+            }
+            return ret;
+    }
+}
+
+static int lept_parse_indexed(lept_context* c, lept_value* v) {
+    lept_index x;
+    int ret;
+    if ((uint64_t)(c->end - c->json) > UINT32_MAX)
+        return LEPT_PARSE_INVALID_VALUE;
+    lept_build_index(&x, c->json, (size_t)(c->end - c->json));
+    c->json = x.size > 0 ? x.json + x.pos[0] : c->end;
+    if ((ret = lept_parse_indexed_value(c, &x, v)) == LEPT_PARSE_OK && x.i != x.size) {
+        lept_free(v);
+        ret = LEPT_PARSE_ROOT_NOT_SINGULAR;
+    }
+    free(x.pos);
+    return ret;
+}
+
+int lept_parse(lept_value* v, const char* json) {
+    assert(json != NULL);
+    return lept_parse_ex(v, json, strlen(json), LEPT_PARSE_DEFAULT_FLAG);
+}
+
+int lept_parse_n(lept_value* v, const char* json, size_t len) {
+    return lept_parse_ex(v, json, len, LEPT_PARSE_DEFAULT_FLAG);
+}
+
+int lept_parse_insitu(lept_value* v, char* buf, size_t len) {
+    return lept_parse_ex(v, buf, len, LEPT_PARSE_INSITU);
+}
+
+/* Parse the document between c->json and c->end, c->stack is kept for the next call. d owns the tree if not NULL. */
+static int lept_parse_root(lept_context* c, lept_value* v, lept_document* d) {
+    const char* json = c->json;
+    lept_keys keys;
+    int ret;
+    lept_init(v);
+    if (!(c->flags & LEPT_PARSE_NO_UTF8_CHECK_FLAG) && lept_utf8_check(json, c->end) != c->end)
+        return LEPT_PARSE_INVALID_UTF8;
+    lept_keys_init(&keys);
+    keys.document = d;
+    c->keys = &keys;
+    if (!(c->flags & LEPT_PARSE_STRUCTURAL_FLAG) || (ret = lept_parse_indexed(c, v)) != LEPT_PARSE_OK) {
+        c->json = json;
+        lept_parse_whitespace(c);
+        if ((ret = lept_parse_value(c, v, 0)) == LEPT_PARSE_OK) {
+            lept_parse_whitespace(c);
+            if (c->json != c->end) {
+                lept_free(v);
+                ret = LEPT_PARSE_ROOT_NOT_SINGULAR;
+            }
+        }
+    }
+    assert(c->top == 0);
+    lept_keys_free(&keys);
+    c->keys = NULL;
+    return ret;
+}
+
+int lept_parse_ex(lept_value* v, const char* json, size_t len, unsigned flags) {
+    lept_context c;
+    int ret;
+    assert(v != NULL && json != NULL);
+    c.json = json;
+    c.end = json + len;
+    c.stack = NULL;
+    c.size = c.top = 0;
+    c.flags = flags;
+    ret = lept_parse_root(&c, v, NULL);
+    free(c.stack);
+    return ret;
+}
+
+void lept_document_init(lept_document* d) {
+    assert(d != NULL);
+    lept_init(&d->root);
+    d->blocks = NULL;
+    d->next = d->end = NULL;
+}
+
+int lept_document_parse(lept_document* d, const char* json, size_t len, unsigned flags) {
+    lept_chunk* head;
+    lept_context c;
+    int ret;
+    assert(d != NULL && json != NULL);
+    if ((head = (lept_chunk*)d->blocks) != NULL) { /* keep the newest block only */
+        lept_chunks_free(head->next);
+        head->next = NULL;
+        d->next = (char*)(head + 1);
+        d->end = d->next + head->size;
+    }
+    c.json = json;
+    c.end = json + len;
+    c.stack = NULL;
+    c.size = c.top = 0;
+    c.flags = flags & ~LEPT_PARSE_INSITU;
+    ret = lept_parse_root(&c, &d->root, d);
+    free(c.stack);
+    return ret;
+}
+
+void lept_document_free(lept_document* d) {
+    assert(d != NULL);
+    lept_chunks_free((lept_chunk*)d->blocks);
+    lept_document_init(d);
+}
+
+/*
+ * Validation runs the grammar of lept_parse_sax_value() without building anything, so nothing is allocated: strings
+ * are scanned with their escapes checked in place, a number is only measured against the overflow threshold, and the
+ * kinds of the open containers are kept in a bit set.
+ */
+
+/* 2^1024 - 2^970, halfway between DBL_MAX and 2^1024: from here on a number rounds to infinity */
+static const char lept_number_too_big[] =
+    "1797693134862315807937289714053034150799341327100378269361737789804449682927647509466490179775872070963"
+    "3028641669288791094655554785194040263065748867150582068190890200070838367627385484581771153176447573027"
+    "0069855571366959622842914819860834936475292719074168444365510704342711559699508093042880177904174497792";
+
+static int lept_validate_string(const char** json, const char* end) {
+    const char* p = *json + 1;
+    unsigned u;
+    int ret;
+    for (;;) {
+        if ((p = lept_scan_string(p, end)) == end)
+            return LEPT_PARSE_MISS_QUOTATION_MARK;
+        switch (*p++) {
+            case '\"':
+                *json = p;
+                return LEPT_PARSE_OK;
+            case '\\':
+                if (p == end)
+                    return LEPT_PARSE_MISS_QUOTATION_MARK;
+                switch (*p++) {
+                    case '\"': case '\\': case '/': case 'b': case 'f': case 'n': case 'r': case 't':
+                        break;
+                    case 'u':
+                        if (!(p = lept_parse_unicode(p, end, &u, &ret)))
+                            return ret;
+                        break;
+                    default:
+                        return LEPT_PARSE_INVALID_STRING_ESCAPE;
+                }
+                break;
+            default:
+                return LEPT_PARSE_INVALID_STRING_CHAR;
+        }
+    }
+}
+
+static int lept_validate_number(const char** json, const char* end) {
+    const char* p = *json, * first = NULL, * mantissa_end;
+    const char* t = lept_number_too_big;
+    long lead = 0, e = 0; /* lead: decimal exponent of the first significant digit */
+    int eneg = 0;
+    if (p != end && *p == '-')
+        p++;
+    if (p != end && *p == '0') {
+        p++;
+        lead = -1;
+    }
+    else {
+        if (p == end || !ISDIGIT1TO9(*p))
+            return LEPT_PARSE_INVALID_VALUE;
+        for (first = p++; p != end && ISDIGIT(*p); p++)
+            if (lead < 100000)
+                lead++;
+    }
+    if (p != end && *p == '.') {
+        if (++p == end || !ISDIGIT(*p))
+            return LEPT_PARSE_INVALID_VALUE;
+        for (; p != end && ISDIGIT(*p); p++)
+            if (first == NULL && *p != '0')
+                first = p;
+            else if (first == NULL && lead > -100000)
+                lead--;
+    }
+    mantissa_end = p;
+    if (p != end && (*p == 'e' || *p == 'E')) {
+        p++;
+        if (p != end && (*p == '+' || *p == '-'))
+            eneg = *p++ == '-';
+        if (p == end || !ISDIGIT(*p))
+            return LEPT_PARSE_INVALID_VALUE;
+        for (; p != end && ISDIGIT(*p); p++)
+            if (e < 100000) /* saturated as in lept_parse_number() */
+                e = e * 10 + (*p - '0');
+    }
+    *json = p;
+    if (first == NULL || (lead += eneg ? -e : e) < 308)
+        return LEPT_PARSE_OK;
+    if (lead > 308)
+        return LEPT_PARSE_NUMBER_TOO_BIG;
+    /* compare the digits with the threshold, which has no trailing zeros */
+    for (p = first; p != mantissa_end && *t != '\0'; p++)
+        if (*p != '.') {
+            if (*p != *t)
+                return *p > *t ? LEPT_PARSE_NUMBER_TOO_BIG : LEPT_PARSE_OK;
+            t++;
+        }
+    return *t == '\0' ? LEPT_PARSE_NUMBER_TOO_BIG : LEPT_PARSE_OK;
+}
+
+/* Check a key and the colon after it */
+static int lept_validate_key(const char** json, const char* end) {
+    int ret;
+    if (*json == end || **json != '"')
+        return LEPT_PARSE_MISS_KEY;
+    if ((ret = lept_validate_string(json, end)) != LEPT_PARSE_OK)
+        return ret;
+    *json = lept_skip_whitespace(*json, end);
+    if (*json == end || **json != ':')
+        return LEPT_PARSE_MISS_COLON;
+    *json = lept_skip_whitespace(*json + 1, end);
+    return LEPT_PARSE_OK;
+}
+
+int lept_validate(const char* json, size_t len) {
+    unsigned char object[(LEPT_PARSE_MAX_DEPTH + 7) / 8]; /* bit set for each open container that is an object */
+    const char* p, * end = json + len;
+    size_t depth = 0;
+    int ret, in_object;
+    char ch;
+    assert(json != NULL);
+    if (lept_utf8_check(json, end) != end)
+        return LEPT_PARSE_INVALID_UTF8;
+    p = lept_skip_whitespace(json, end);
+    for (;;) {
+        if (p == end)
+            return LEPT_PARSE_EXPECT_VALUE;
+        switch (ch = *p) {
+            case '"':
+                ret = lept_validate_string(&p, end);
+                break;
+            case '[':
+            case '{':
+                if (depth == LEPT_PARSE_MAX_DEPTH)
+                    return LEPT_PARSE_TOO_DEEP;
+                p = lept_skip_whitespace(p + 1, end);
+                if (p != end && *p == (ch == '[' ? ']' : '}')) {
+                    p++;
+                    ret = LEPT_PARSE_OK;
+                    break;
+                }
+                if (ch == '{')
+                    object[depth >> 3] |= (unsigned char)(1u << (depth & 7));
+                else
+                    object[depth >> 3] &= (unsigned char)~(1u << (depth & 7));
+                depth++;
+                if (ch == '{' && (ret = lept_validate_key(&p, end)) != LEPT_PARSE_OK)
+                    return ret;
+                continue;
+            case 't':
+                if (!lept_match_literal(p, end, "true", 4))
+                    return LEPT_PARSE_INVALID_VALUE;
+                p += 4;
+                ret = LEPT_PARSE_OK;
+                break;
+            case 'f':
+                if (!lept_match_literal(p, end, "false", 5))
+                    return LEPT_PARSE_INVALID_VALUE;
+                p += 5;
+                ret = LEPT_PARSE_OK;
+                break;
+            case 'n':
+                if (!lept_match_literal(p, end, "null", 4))
+                    return LEPT_PARSE_INVALID_VALUE;
+                p += 4;
+                ret = LEPT_PARSE_OK;
+                break;
+            default:
+                ret = lept_validate_number(&p, end);
+        }
+        if (ret != LEPT_PARSE_OK)
+            return ret;
+        /* a value is complete, close the containers it completes */
+        for (;;) {
+            p = lept_skip_whitespace(p, end);
+            if (depth == 0)
+                return p == end ? LEPT_PARSE_OK : LEPT_PARSE_ROOT_NOT_SINGULAR;
+            in_object = object[(depth - 1) >> 3] >> ((depth - 1) & 7) & 1;
+            if (p != end && *p == ',') {
+                p = lept_skip_whitespace(p + 1, end);
+                if (in_object && (ret = lept_validate_key(&p, end)) != LEPT_PARSE_OK)
+                    return ret;
+                break;
+            }
+            if (p == end || *p != (in_object ? '}' : ']'))
+                return in_object ? LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET : LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
+            p++;
+            depth--;
+        }
+    }
+}
+
+int lept_file_map(lept_file* f, const char* path) {
+#if defined(_WIN32)
+    HANDLE file, mapping;
+    LARGE_INTEGER size;
+#else
+    struct stat st;
+    int fd;
+#endif
+    assert(f != NULL && path != NULL);
+    f->json = "";
+    f->len = 0;
+#if defined(_WIN32)
+    file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return LEPT_PARSE_FILE_ERROR;
+    if (!GetFileSizeEx(file, &size) || (uint64_t)size.QuadPart > (size_t)-1) {
+        CloseHandle(file);
+        return LEPT_PARSE_FILE_ERROR;
+    }
+    if (size.QuadPart > 0) {
+        /* the view keeps the mapping open */
+        mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        f->json = mapping ? (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+        if (mapping)
+            CloseHandle(mapping);
+        if (f->json == NULL) {
+            CloseHandle(file);
+            f->json = "";
+            return LEPT_PARSE_FILE_ERROR;
+        }
+        f->len = (size_t)size.QuadPart;
+    }
+    CloseHandle(file);
+#else
+    if ((fd = open(path, O_RDONLY)) < 0)
+        return LEPT_PARSE_FILE_ERROR;
+    if (fstat(fd, &st) != 0 || (uint64_t)st.st_size > (size_t)-1) {
+        close(fd);
+        return LEPT_PARSE_FILE_ERROR;
+    }
+    if (st.st_size > 0) {
+        void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED) {
+            close(fd);
+            return LEPT_PARSE_FILE_ERROR;
+        }
+        madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+        f->json = (const char*)map;
+        f->len = (size_t)st.st_size;
+    }
+    close(fd);
+#endif
+    return LEPT_PARSE_OK;
+}
+
+void lept_file_unmap(lept_file* f) {
+    assert(f != NULL);
+    if (f->len > 0)
+#if defined(_WIN32)
+        UnmapViewOfFile(f->json);
+#else
+        munmap((void*)f->json, f->len);
+#endif
+    f->json = "";
+    f->len = 0;
+}
+
+int lept_parse_file(lept_value* v, const char* path, unsigned flags) {
+    lept_file f;
+    int ret;
+    assert(v != NULL);
+    if ((ret = lept_file_map(&f, path)) != LEPT_PARSE_OK) {
+        lept_init(v);
+        return ret;
+    }
+    ret = lept_parse_ex(v, f.json, f.len, flags & ~(unsigned)LEPT_PARSE_ZERO_COPY_FLAG);
+    lept_file_unmap(&f);
+    return ret;
+}
+
+/*
+ * NDJSON front end. Workers take the input in batches of whole lines, cut under the lock with memchr(), and
+ * parse them into a ring of batch slots, each worker with its own context so the stack is reused across records.
+ * The calling thread hands the records to the callback in input order and recycles the slots, which bounds
+ * memory by the number of slots whatever the size of the input.
+ */
+typedef struct {
+    lept_value* v;
+    int* ret;
+    size_t* line;       /* of each record, counted from the first line of the batch */
+    size_t count, capacity;
+    size_t lines;       /* lines in the batch, blank ones included */
+    int done;
+}lept_batch;
+
+typedef struct {
+    const char* next;   /* first line not taken */
+    const char* end;
+    lept_batch* batch;
+    size_t slots, issued, consumed;
+    int stop;
+#ifndef LEPT_NO_THREADS
+    lept_mutex lock;
+    lept_cond cond;
+#endif
+}lept_ndjson;
+
+/* Take the next batch, the caller holds the lock and has checked that a slot is free */
+static lept_batch* lept_ndjson_take(lept_ndjson* j, const char** begin, const char** end) {
+    const char* e = j->end;
+    *begin = j->next;
+    if ((size_t)(e - *begin) > LEPT_NDJSON_BATCH_SIZE && (e = (const char*)memchr(*begin + LEPT_NDJSON_BATCH_SIZE, '\n',
+        (size_t)(j->end - *begin - LEPT_NDJSON_BATCH_SIZE))) != NULL)
+        e++;
+    else
+        e = j->end;
+    *end = j->next = e;
+    return &j->batch[j->issued++ % j->slots];
+}
+
+static void lept_ndjson_parse(lept_context* c, lept_batch* b, const char* p, const char* end) {
+    const char* e;
+    size_t i;
+    for (i = 0; i < b->count; i++) /* what the callback left of the records parsed last time into the slot */
+        lept_free(&b->v[i]);
+    b->count = b->lines = 0;
+    for (; p != end; p = e + (e != end), b->lines++) {
+        if ((e = (const char*)memchr(p, '\n', (size_t)(end - p))) == NULL)
+            e = end;
+        if (lept_skip_whitespace(p, e) == e)
+            continue; /* blank line */
+        if (b->count == b->capacity) {
+            b->capacity = b->capacity == 0 ? 64 : b->capacity + (b->capacity >> 1);
+            b->v = (lept_value*)realloc(b->v, b->capacity * sizeof(lept_value));
+            b->ret = (int*)realloc(b->ret, b->capacity * sizeof(int));
+            b->line = (size_t*)realloc(b->line, b->capacity * sizeof(size_t));
+        }
+        c->json = p;
+        c->end = e;
+        b->ret[b->count] = lept_parse_root(c, &b->v[b->count], NULL);
+        b->line[b->count++] = b->lines;
+    }
+}
+
+#ifndef LEPT_NO_THREADS
+#if defined(_WIN32)
+static unsigned __stdcall lept_ndjson_worker(void* arg) {
+#else
+static void* lept_ndjson_worker(void* arg) {
+#endif
+    lept_ndjson* j = (lept_ndjson*)arg;
+    lept_context c;
+    lept_batch* b;
+    const char* begin, * end;
+    c.stack = NULL;
+    c.size = c.top = 0;
+    c.flags = 0;
+    lept_mutex_lock(&j->lock);
+    for (;;) {
+        while (!j->stop && j->next != j->end && j->issued == j->consumed + j->slots)
+            lept_cond_wait(&j->cond, &j->lock);
+        if (j->stop || j->next == j->end)
+            break;
+        b = lept_ndjson_take(j, &begin, &end);
+        lept_mutex_unlock(&j->lock);
+        lept_ndjson_parse(&c, b, begin, end);
+        lept_mutex_lock(&j->lock);
+        b->done = 1;
+        lept_cond_broadcast(&j->cond);
+    }
+    lept_mutex_unlock(&j->lock);
+    free(c.stack);
+    return 0;
+}
+#endif
+
+int lept_parse_ndjson(const char* json, size_t len, unsigned threads, lept_record_func cb, void* user) {
+    lept_ndjson j;
+    lept_context c;
+    lept_batch* b;
+    const char* begin, * end;
+    size_t i, line = 1;
+    unsigned workers = 0;
+    int stop = 0;
+#ifndef LEPT_NO_THREADS
+    lept_thread* t = NULL;
+    int ready;
+#endif
+    assert(json != NULL && cb != NULL);
+    j.next = json;
+    j.end = json + len;
+    j.slots = threads > 1 ? 2 * (size_t)threads : 1;
+    j.batch = (lept_batch*)calloc(j.slots, sizeof(lept_batch));
+    j.issued = j.consumed = 0;
+    j.stop = 0;
+    c.stack = NULL;
+    c.size = c.top = 0;
+    c.flags = 0;
+#ifndef LEPT_NO_THREADS
+    if (threads > 1) {
+        lept_mutex_init(&j.lock);
+        lept_cond_init(&j.cond);
+        t = (lept_thread*)malloc(threads * sizeof(lept_thread));
+        while (workers < threads && lept_thread_create(&t[workers], lept_ndjson_worker, &j))
+            workers++;
+    }
+#endif
+    for (;;) {
+        if (workers == 0) {
+            if (j.stop || j.next == j.end)
+                break;
+            b = lept_ndjson_take(&j, &begin, &end);
+            lept_ndjson_parse(&c, b, begin, end);
+        }
+#ifndef LEPT_NO_THREADS
+        else {
+            b = &j.batch[j.consumed % j.slots];
+            lept_mutex_lock(&j.lock);
+            while (!b->done && (j.issued > j.consumed || (!j.stop && j.next != j.end)))
+                lept_cond_wait(&j.cond, &j.lock);
+            ready = b->done;
+            lept_mutex_unlock(&j.lock);
+            if (!ready)
+                break;
+        }
+#endif
+        for (i = 0; i < b->count && !stop; i++)
+            if (!cb(user, line + b->line[i], b->ret[i], &b->v[i]))
+                stop = 1;
+        line += b->lines;
+#ifndef LEPT_NO_THREADS
+        if (workers > 0) {
+            lept_mutex_lock(&j.lock);
+            b->done = 0;
+            j.consumed++;
+            j.stop = stop;
+            lept_cond_broadcast(&j.cond);
+            lept_mutex_unlock(&j.lock);
+            continue;
+        }
+#endif
+        j.consumed++;
+        j.stop = stop;
+    }
+#ifndef LEPT_NO_THREADS
+    if (threads > 1) {
+        for (i = 0; i < workers; i++)
+            lept_thread_join(t[i]);
+        free(t);
+        lept_cond_destroy(&j.cond);
+        lept_mutex_destroy(&j.lock);
+    }
+#endif
+    for (i = 0; i < j.slots; i++) {
+        for (line = 0; line < j.batch[i].count; line++)
+            lept_free(&j.batch[i].v[line]);
+        free(j.batch[i].v);
+        free(j.batch[i].ret);
+        free(j.batch[i].line);
+    }
+    free(j.batch);
+    free(c.stack);
+    return stop ? LEPT_PARSE_STOPPED : LEPT_PARSE_OK;
+}
+
+/*
+ * Tape words carry the lept_type in the top byte and a 56-bit payload:
+ *   null, false, true     one word
+ *   number, integer       tag word (payload LEPT_VALUE_UINT64 for integers above INT64_MAX), then the raw 64 bits
+ *   string                tag word with the offset into the string buffer, then the length
+ *   array, object         tag word with the index one past the last word of the container, then the element count,
+ *                         then the elements, or the members as key string followed by value
+ */
+#define LEPT_TAPE_WORD(type, payload) ((uint64_t)(type) << 56 | (uint64_t)(payload))
+#define LEPT_TAPE_TYPE(w)             ((lept_type)((w) >> 56))
+#define LEPT_TAPE_PAYLOAD(w)          ((w) & UINT64_C(0x00FFFFFFFFFFFFFF))
+
+/* Words are built on c->stack, which only holds transient string bytes above them */
+static void lept_tape_put(lept_context* c, uint64_t w) {
+    memcpy(lept_context_push(c, sizeof(w)), &w, sizeof(w));
+}
+
+static int lept_parse_tape_string(lept_context* c, lept_context* sb) {
+    char* s;
+    size_t len, offset = sb->top;
+    int ret;
+    if ((ret = lept_parse_string_raw(c, &s, &len)) == LEPT_PARSE_OK) {
+        /* s lives above c->top, so copy it out before pushing the words */
+        memcpy(lept_context_push(sb, len + 1), s, len);
+        sb->stack[sb->top - 1] = '\0';
+        lept_tape_put(c, LEPT_TAPE_WORD(LEPT_STRING, offset));
+        lept_tape_put(c, len);
+    }
+    return ret;
+}
+
+static int lept_parse_tape_value(lept_context* c, lept_context* sb, size_t depth);
+
+/* Patch the container opened at byte offset head on the stack */
+static void lept_tape_close(lept_context* c, size_t head, lept_type type, size_t size) {
+    uint64_t w[2];
+    w[0] = LEPT_TAPE_WORD(type, c->top / sizeof(uint64_t));
+    w[1] = size;
+    memcpy(c->stack + head, w, sizeof(w));
+}
+
+static int lept_parse_tape_array(lept_context* c, lept_context* sb, size_t depth) {
+    size_t head = c->top, size = 0;
+    int ret;
+    EXPECT(c, '[');
+    lept_tape_put(c, 0);
+    lept_tape_put(c, 0);
+    lept_parse_whitespace(c);
+    if (PEEK(c) == ']') {
+        c->json++;
+        lept_tape_close(c, head, LEPT_ARRAY, 0);
+        return LEPT_PARSE_OK;
+    }
+    for (;;) {
+        if ((ret = lept_parse_tape_value(c, sb, depth)) != LEPT_PARSE_OK)
+            return ret;
+        size++;
+        lept_parse_whitespace(c);
+        if (PEEK(c) == ',') {
+            c->json++;
+            lept_parse_whitespace(c);
+        }
+        else if (PEEK(c) == ']') {
+            c->json++;
+            lept_tape_close(c, head, LEPT_ARRAY, size);
+            return LEPT_PARSE_OK;
+        }
+        else
+            return LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
+    }
+}
+
+static int lept_parse_tape_object(lept_context* c, lept_context* sb, size_t depth) {
+    size_t head = c->top, size = 0;
+    int ret;
+    EXPECT(c, '{');
+    lept_tape_put(c, 0);
+    lept_tape_put(c, 0);
+    lept_parse_whitespace(c);
+    if (PEEK(c) == '}') {
+        c->json++;
+        lept_tape_close(c, head, LEPT_OBJECT, 0);
+        return LEPT_PARSE_OK;
+    }
+    for (;;) {
+        if (PEEK(c) != '"')
+            return LEPT_PARSE_MISS_KEY;
+        if ((ret = lept_parse_tape_string(c, sb)) != LEPT_PARSE_OK)
+            return ret;
+        lept_parse_whitespace(c);
+        if (PEEK(c) != ':')
+            return LEPT_PARSE_MISS_COLON;
+        c->json++;
+        lept_parse_whitespace(c);
+        if ((ret = lept_parse_tape_value(c, sb, depth)) != LEPT_PARSE_OK)
+            return ret;
+        size++;
+        lept_parse_whitespace(c);
+        if (PEEK(c) == ',') {
+            c->json++;
+            lept_parse_whitespace(c);
+        }
+        else if (PEEK(c) == '}') {
+            c->json++;
+            lept_tape_close(c, head, LEPT_OBJECT, size);
+            return LEPT_PARSE_OK;
+        }
+        else
+            return LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+    }
+}
+
+/* depth: containers open around the value */
+static int lept_parse_tape_value(lept_context* c, lept_context* sb, size_t depth) {
+    lept_value v;
+    int ret;
+    switch (PEEK(c)) {
+        case '"': return lept_parse_tape_string(c, sb);
+        case '[':
+        case '{':
+            if (depth == LEPT_PARSE_MAX_DEPTH)
+                return LEPT_PARSE_TOO_DEEP;
+            if (PEEK(c) == '[')
+                return lept_parse_tape_array(c, sb, depth + 1);
+            return lept_parse_tape_object(c, sb, depth + 1);
+    }
+    /* literals and numbers need no allocation, parse them into a scratch value */
+    lept_init(&v);
+    if ((ret = lept_parse_value(c, &v, 0)) != LEPT_PARSE_OK)
+        return ret;
+    switch (v.type) {
+        case LEPT_NUMBER:
+            lept_tape_put(c, LEPT_TAPE_WORD(LEPT_NUMBER, 0));
+            memcpy(lept_context_push(c, sizeof(double)), &v.u.n, sizeof(double));
+            break;
+        case LEPT_INTEGER:
+            lept_tape_put(c, LEPT_TAPE_WORD(LEPT_INTEGER, v.flags & LEPT_VALUE_UINT64));
+            lept_tape_put(c, v.u.ui);
+            break;
+        default:
+            lept_tape_put(c, LEPT_TAPE_WORD(v.type, 0));
+    }
+    return LEPT_PARSE_OK;
+}
+
+int lept_parse_tape(lept_tape* t, const char* json, size_t len) {
+    lept_context c, sb;
+    int ret;
+    assert(t != NULL && json != NULL);
+    c.json = json;
+    c.end = json + len;
+    c.stack = sb.stack = NULL;
+    c.size = c.top = sb.size = sb.top = 0;
+    c.flags = 0;
+    c.keys = sb.keys = NULL;
+    t->w = NULL;
+    t->s = NULL;
+    t->size = 0;
+    if (lept_utf8_check(json, c.end) != c.end)
+        return LEPT_PARSE_INVALID_UTF8;
+    lept_parse_whitespace(&c);
+    if ((ret = lept_parse_tape_value(&c, &sb, 0)) == LEPT_PARSE_OK) {
+        lept_parse_whitespace(&c);
+        if (c.json != c.end)
+            ret = LEPT_PARSE_ROOT_NOT_SINGULAR;
+    }
+    if (ret == LEPT_PARSE_OK) {
+        /* words and strings share one block, so lept_tape_free() is a single free() */
+        t->w = (uint64_t*)malloc(c.top + sb.top);
+        t->size = c.top / sizeof(uint64_t);
+        memcpy(t->w, c.stack, c.top);
+        t->s = (char*)(t->w + t->size);
+        if (sb.top > 0)
+            memcpy((char*)t->s, sb.stack, sb.top);
+    }
+    free(c.stack);
+    free(sb.stack);
+    return ret;
+}
+
+/*
+ * The scanners below step over text without validating it, they only track quotes, escapes and bracket depth.
+ * Each returns the position after what it skipped, or NULL if the input ends first.
+ */
+static const char* lept_scan_string_end(const char* p, const char* end) {
+    for (;;) {
+        p = lept_scan_string(p, end);
+        if (p == end)
+            return NULL;
+        if (*p == '\"')
+            return p + 1;
+        if (*p == '\\' && ++p == end)
+            return NULL;
+        p++;
+    }
+}
+
+/*
+ * Leave depth containers, p is between tokens inside the innermost one. Blocks of 64 bytes are classified as for the
+ * structural index and brackets in strings masked out, then only counted, unless enough close here to leave them all.
+ */
+static const char* lept_scan_close(const char* p, const char* end, size_t depth) {
+    uint64_t prev_escaped = 0, prev_in_string = 0;
+    char tail[64];
+    for (; p < end; p += 64) {
+        const char* s = p;
+        lept_block b;
+        uint64_t quote, in_string, open, close, brackets;
+        if (end - p < 64) { /* pad the last block with whitespace */
+            memset(tail, ' ', sizeof(tail));
+            memcpy(tail, p, (size_t)(end - p));
+            s = tail;
+        }
+        lept_classify_block(s, &b);
+        quote = b.quote & ~lept_find_escaped(b.backslash, &prev_escaped);
+        in_string = lept_prefix_xor(quote) ^ prev_in_string;
+        prev_in_string = 0 - (in_string >> 63);
+        open = b.open & ~in_string;
+        close = b.close & ~in_string;
+        if (lept_popcount64(close) < depth) {
+            depth = depth + lept_popcount64(open) - lept_popcount64(close);
+            continue;
+        }
+        for (brackets = open | close; brackets != 0; brackets &= brackets - 1) {
+            unsigned i = lept_ctz64(brackets);
+            if (open >> i & 1)
+                depth++;
+            else if (--depth == 0)
+                return p + i + 1;
+        }
+    }
+    return NULL;
+}
+
+/* Step over the value at p without validating it, NULL if it is cut off or empty */
+static const char* lept_scan_value(const char* p, const char* end) {
+    const char* q = p;
+    if (p == end)
+        return NULL;
+    switch (*p) {
+        case '"':
+            return lept_scan_string_end(p + 1, end);
+        case '[':
+        case '{':
+            return lept_scan_close(p + 1, end, 1);
+        default: /* literal or number, up to the next delimiter */
+            while (q != end && !(lept_char_class[(unsigned char)*q] & LEPT_CHAR_DELIMITER))
+                q++;
+            return q != p ? q : NULL;
+    }
+}
+
+const char* lept_skip_value(const char* json, size_t len) {
+    const char* p;
+    assert(json != NULL);
+    p = lept_skip_whitespace(json, json + len);
+    return p != json + len ? lept_scan_value(p, json + len) : NULL;
+}
+
+/*
+ * Projection. The paths are merged into a tree of tokens, and the walk keeps the set of nodes that the value at hand
+ * is under, on a stack of its own. A value under a node where a path ends is parsed whole, an object or array under
+ * other nodes is walked member by member, and any other value is stepped over by lept_scan_value().
+ */
+typedef struct {
+    const char* s;      /* token, with ~1 and ~0 decoded */
+    size_t len;
+    size_t index;       /* the token as an array index, or (size_t)-1 */
+    size_t child, next; /* first child and next sibling, 0 for none as node 0 is the root */
+    int leaf;           /* a path ends here */
+}lept_path;
+
+typedef struct {
+    lept_context* c;
+    lept_path* paths;
+    lept_context sets;  /* node indices of the sets that are open */
+}lept_projection;
+
+/* Merge path into the tree of n nodes, with its tokens decoded into buf, and return the new number of nodes */
+static size_t lept_add_path(lept_path* paths, size_t n, const char* path, char** buf) {
+    size_t node = 0, i;
+    assert(*path == '\0' || *path == '/');
+    while (*path == '/') {
+        char* s = *buf;
+        size_t len, index = 0;
+        for (path++; *path != '\0' && *path != '/'; path++)
+            if (*path == '~' && (path[1] == '0' || path[1] == '1'))
+                *(*buf)++ = *++path == '0' ? '~' : '/';
+            else
+                *(*buf)++ = *path;
+        len = (size_t)(*buf - s);
+        for (i = paths[node].child; i != 0; i = paths[i].next)
+            if (paths[i].len == len && memcmp(paths[i].s, s, len) == 0)
+                break;
+        if (i == 0) {
+            for (i = 0; i < len && ISDIGIT(s[i]) && index < ((size_t)-1 - 9) / 10; i++)
+                index = index * 10 + (size_t)(s[i] - '0');
+            paths[n].s = s;
+            paths[n].len = len;
+            paths[n].index = len > 0 && i == len && (s[0] != '0' || len == 1) ? index : (size_t)-1;
+            paths[n].child = 0;
+            paths[n].next = paths[node].child;
+            paths[n].leaf = 0;
+            paths[node].child = i = n++;
+        }
+        node = i;
+    }
+    paths[node].leaf = 1;
+    return n;
+}
+
+/* Push the children of the count nodes at set that match the key, or the index when key is NULL, return how many */
+static size_t lept_match_paths(lept_projection* pj, size_t set, size_t count, const char* key, size_t klen,
+    size_t index, int* leaf) {
+    size_t i, j, n = 0;
+    *leaf = 0;
+    for (i = 0; i < count; i++)
+        for (j = pj->paths[((size_t*)(pj->sets.stack + set))[i]].child; j != 0; j = pj->paths[j].next) {
+            const lept_path* p = &pj->paths[j];
+            if ((p->len == 1 && p->s[0] == '*') ||
+                (key != NULL ? p->len == klen && memcmp(p->s, key, klen) == 0 : p->index == index)) {
+                *(size_t*)lept_context_push(&pj->sets, sizeof(size_t)) = j;
+                *leaf |= p->leaf;
+                n++;
+            }
+        }
+    return n;
+}
+
+/* Step over a value no path selects, a cut-off one is parsed to report the error */
+static int lept_skip_projected(lept_context* c, size_t depth) {
+    const char* q;
+    lept_value v;
+    int ret;
+    if (c->json == c->end)
+        return LEPT_PARSE_EXPECT_VALUE;
+    if ((q = lept_scan_value(c->json, c->end)) != NULL) {
+        c->json = q;
+        return LEPT_PARSE_OK;
+    }
+    if ((ret = lept_parse_value(c, &v, depth)) == LEPT_PARSE_OK)
+        lept_free(&v);
+    return ret;
+}
+
+static int lept_parse_projected(lept_projection* pj, lept_value* v, size_t set, size_t count, size_t depth);
+
+/* Parse a member or element under the count nodes at the top of pj->sets, into v if selected and pop those nodes */
+static int lept_parse_projected_child(lept_projection* pj, lept_value* v, size_t count, int leaf, size_t depth,
+    int* selected) {
+    lept_context* c = pj->c;
+    size_t set = pj->sets.top - count * sizeof(size_t);
+    int ret;
+    lept_init(v);
+    *selected = leaf || (count > 0 && (PEEK(c) == '{' || PEEK(c) == '['));
+    if (leaf)
+        ret = lept_parse_value(c, v, depth);
+    else if (*selected)
+        ret = lept_parse_projected(pj, v, set, count, depth);
+    else
+        ret = lept_skip_projected(c, depth);
+    pj->sets.top = set;
+    return ret;
+}
+
+/* The object or array at c->json, not selected whole, with only what the count nodes at set select */
+static int lept_parse_projected(lept_projection* pj, lept_value* v, size_t set, size_t count, size_t depth) {
+    lept_context* c = pj->c;
+    size_t head = c->top, size = 0, n, klen = 0;
+    int ret, leaf, selected, object = *c->json == '{';
+    const char* key = NULL, * q;
+    lept_member* m;
+    if (depth == LEPT_PARSE_MAX_DEPTH)
+        return LEPT_PARSE_TOO_DEEP;
+    c->json++;
+    lept_parse_whitespace(c);
+    if (PEEK(c) != (object ? '}' : ']')) {
+        for (;;) {
+            lept_value e;
+            if (object) {
+                if (PEEK(c) != '"') {
+                    ret = LEPT_PARSE_MISS_KEY;
+                    break;
+                }
+                if ((q = lept_scan_string(c->json + 1, c->end)) != c->end && *q == '\"') { /* no escapes */
+                    key = c->json + 1;
+                    klen = (size_t)(q - key);
+                    c->json = q + 1;
+                }
+                else if ((ret = lept_parse_string_raw(c, (char**)&key, &klen)) != LEPT_PARSE_OK)
+                    break;
+                lept_parse_whitespace(c);
+                if (PEEK(c) != ':') {
+                    ret = LEPT_PARSE_MISS_COLON;
+                    break;
+                }
+                c->json++;
+                lept_parse_whitespace(c);
+            }
+            n = lept_match_paths(pj, set, count, key, klen, size, &leaf);
+            if (object && n > 0) /* interned now, as the value is parsed above a decoded key */
+                key = lept_intern(c->keys, key, klen);
+            ret = lept_parse_projected_child(pj, &e, n, leaf, depth + 1, &selected);
+            if (ret == LEPT_PARSE_OK && (selected || !object)) { /* elements no path selects stay as null */
+                m = (lept_member*)lept_context_push(c, sizeof(lept_member));
+                m->k = (char*)key;
+                m->klen = klen;
+                memcpy(&m->v, &e, sizeof(lept_value));
+                size++;
+            }
+            else if (object && n > 0)
+                lept_key_release((char*)key);
+            if (ret != LEPT_PARSE_OK)
+                break;
+            lept_parse_whitespace(c);
+            if (PEEK(c) == ',') {
+                c->json++;
+                lept_parse_whitespace(c);
+                continue;
+            }
+            if (PEEK(c) != (object ? '}' : ']'))
+                ret = object ? LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET : LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
+            break;
+        }
+        if (ret == LEPT_PARSE_OK && size > LEPT_SIZE_MAX)
+            ret = LEPT_PARSE_TOO_LARGE;
+        if (ret != LEPT_PARSE_OK) {
+            lept_dom_unwind(c, head);
+            return ret;
+        }
+    }
+    c->json++;
+    m = (lept_member*)lept_context_pop(c, size * sizeof(lept_member));
+    if (object) {
+        lept_set_object(v, size);
+        if (size > 0)
+            memcpy(v->u.o.m, m, size * sizeof(lept_member));
+        LEPT_OBJECT_SIZE(v) = size;
+    }
+    else {
+        lept_set_array(v, size);
+        for (n = 0; n < size; n++)
+            memcpy(&v->u.a.e[n], &m[n].v, sizeof(lept_value));
+        LEPT_ARRAY_SIZE(v) = size;
+    }
+    return LEPT_PARSE_OK;
+}
+
+int lept_parse_paths(lept_value* v, const char* json, size_t len, const char* const* paths, size_t count) {
+    lept_context c;
+    lept_keys keys;
+    lept_projection pj;
+    char* buf, * p;
+    size_t i, n = 1, size = 0;
+    int ret, selected;
+    assert(v != NULL && json != NULL && (paths != NULL || count == 0));
+    lept_init(v);
+    if (lept_utf8_check(json, json + len) != json + len)
+        return LEPT_PARSE_INVALID_UTF8;
+    for (i = 0; i < count; i++)
+        size += strlen(paths[i]);
+    /* a path has no more tokens than bytes, nor do the decoded tokens take more room */
+    pj.paths = (lept_path*)malloc((size + 1) * sizeof(lept_path));
+    p = buf = (char*)malloc(size + 1);
+    pj.paths[0].child = 0;
+    pj.paths[0].leaf = 0;
+    for (i = 0; i < count; i++)
+        n = lept_add_path(pj.paths, n, paths[i], &p);
+    c.json = json;
+    c.end = json + len;
+    c.stack = pj.sets.stack = NULL;
+    c.size = c.top = pj.sets.size = pj.sets.top = 0;
+    c.flags = pj.sets.flags = 0;
+    lept_keys_init(c.keys = &keys);
+    pj.c = &c;
+    *(size_t*)lept_context_push(&pj.sets, sizeof(size_t)) = 0;
+    lept_parse_whitespace(&c);
+    if ((ret = lept_parse_projected_child(&pj, v, 1, pj.paths[0].leaf, 0, &selected)) == LEPT_PARSE_OK) {
+        lept_parse_whitespace(&c);
+        if (c.json != c.end) {
+            lept_free(v);
+            ret = LEPT_PARSE_ROOT_NOT_SINGULAR;
+        }
+    }
+    assert(c.top == 0);
+    lept_keys_free(&keys);
+    free(c.stack);
+    free(pj.sets.stack);
+    free(pj.paths);
+    free(buf);
+    return ret;
+}
+
+static void lept_cursor_consumed(lept_cursor* cur, const char* p) {
+    cur->json = lept_skip_whitespace(p, cur->end);
+    cur->pending = cur->open = 0;
+}
+
+static int lept_cursor_fail(lept_cursor* cur, int error) {
+    cur->error = error;
+    return error;
+}
+
+void lept_cursor_init(lept_cursor* cur, const char* json, size_t len) {
+    assert(cur != NULL && json != NULL);
+    cur->end = json + len;
+    cur->json = lept_skip_whitespace(json, cur->end);
+    cur->depth = 0;
+    cur->pending = 1;
+    cur->open = 0;
+    if (lept_utf8_check(json, cur->end) != cur->end)
+        cur->error = LEPT_PARSE_INVALID_UTF8;
+    else
+        cur->error = cur->json == cur->end ? LEPT_PARSE_EXPECT_VALUE : LEPT_PARSE_OK;
+}
+
+lept_type lept_cursor_get_type(const lept_cursor* cur) {
+    assert(cur != NULL && cur->pending && cur->error == LEPT_PARSE_OK);
+    switch (*cur->json) {
+        case 'n': return LEPT_NULL;
+        case 'f': return LEPT_FALSE;
+        case 't': return LEPT_TRUE;
+        case '"': return LEPT_STRING;
+        case '[': return LEPT_ARRAY;
+        case '{': return LEPT_OBJECT;
+        default:  return LEPT_NUMBER;
+    }
+}
+
+int lept_cursor_skip(lept_cursor* cur) {
+    const char* p;
+    assert(cur != NULL);
+    if (cur->error != LEPT_PARSE_OK)
+        return cur->error;
+    assert(cur->pending);
+    if (!(p = lept_scan_value(cur->json, cur->end))) {
+        switch (*cur->json) {
+            case '"': return lept_cursor_fail(cur, LEPT_PARSE_MISS_QUOTATION_MARK);
+            case '[': return lept_cursor_fail(cur, LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET);
+            case '{': return lept_cursor_fail(cur, LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET);
+            default:  return lept_cursor_fail(cur, LEPT_PARSE_INVALID_VALUE);
+        }
+    }
+    lept_cursor_consumed(cur, p);
+    return LEPT_PARSE_OK;
+}
+
+/* Materialize the pending value with the regular parser */
+static int lept_cursor_parse(lept_cursor* cur, lept_value* v) {
+    lept_context c;
+    lept_keys keys;
+    int ret;
+    c.json = cur->json;
+    c.end = cur->end;
+    c.stack = NULL;
+    c.size = c.top = 0;
+    c.flags = 0;
+    lept_keys_init(c.keys = &keys);
+    if ((ret = lept_parse_value(&c, v, 0)) == LEPT_PARSE_OK)
+        lept_cursor_consumed(cur, c.json);
+    else
+        cur->error = ret;
+    assert(c.top == 0);
+    lept_keys_free(&keys);
+    free(c.stack);
+    return ret;
+}
+
+int lept_cursor_get_value(lept_cursor* cur, lept_value* v) {
+    assert(cur != NULL && v != NULL);
+    if (cur->error != LEPT_PARSE_OK)
+        return cur->error;
+    assert(cur->pending);
+    lept_free(v);
+    return lept_cursor_parse(cur, v);
+}
+
+int lept_cursor_get_boolean(lept_cursor* cur, int* b) {
+    lept_value v;
     int ret;
-    char* s;
-    size_t len;
-    if ((ret = lept_parse_string_raw(c, &s, &len)) == LEPT_PARSE_OK)
-        lept_set_string(v, s, len);
+    assert(cur != NULL && b != NULL);
+    if (cur->error != LEPT_PARSE_OK)
+        return cur->error;
+    assert(cur->pending);
+    if (*cur->json != 't' && *cur->json != 'f')
+        return LEPT_PARSE_TYPE_MISMATCH;
+    lept_init(&v);
+    if ((ret = lept_cursor_parse(cur, &v)) == LEPT_PARSE_OK)
+        *b = v.type == LEPT_TRUE;
     return ret;
 }
 
-static int lept_parse_value(lept_context* c, lept_value* v);
-
-static int lept_parse_array(lept_context* c, lept_value* v) {
-    size_t i, size = 0;
+int lept_cursor_get_number(lept_cursor* cur, double* n) {
+    lept_value v;
     int ret;
-    EXPECT(c, '[');
-    lept_parse_whitespace(c);
-    if (*c->json == ']') {
-        c->json++;
-        lept_set_array(v, 0);
-        return LEPT_PARSE_OK;
+    assert(cur != NULL && n != NULL);
+    if (cur->error != LEPT_PARSE_OK)
+        return cur->error;
+    assert(cur->pending);
+    if (*cur->json != '-' && !ISDIGIT(*cur->json))
+        return LEPT_PARSE_TYPE_MISMATCH;
+    lept_init(&v);
+    if ((ret = lept_cursor_parse(cur, &v)) == LEPT_PARSE_OK)
+        *n = lept_get_number(&v);
+    return ret;
+}
+
+int lept_cursor_enter(lept_cursor* cur, size_t* depth) {
+    assert(cur != NULL && depth != NULL);
+    if (cur->error != LEPT_PARSE_OK)
+        return cur->error;
+    assert(cur->pending);
+    if (*cur->json != '[' && *cur->json != '{')
+        return LEPT_PARSE_TYPE_MISMATCH;
+    lept_cursor_consumed(cur, cur->json + 1);
+    cur->open = 1;
+    *depth = ++cur->depth;
+    return LEPT_PARSE_OK;
+}
+
+/* Bring the cursor back between the members of the container entered at depth, skipping whatever is left before */
+static int lept_cursor_unwind(lept_cursor* cur, size_t depth) {
+    const char* p;
+    if (cur->error != LEPT_PARSE_OK || cur->depth < depth)
+        return 0;
+    if (cur->pending && lept_cursor_skip(cur) != LEPT_PARSE_OK)
+        return 0;
+    if (cur->depth > depth) {
+        if (!(p = lept_scan_close(cur->json, cur->end, cur->depth - depth))) {
+            cur->error = LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
+            return 0;
+        }
+        lept_cursor_consumed(cur, p);
+        cur->depth = depth;
     }
-    for (;;) {
-        lept_value e;
-        lept_init(&e);
-        if ((ret = lept_parse_value(c, &e)) != LEPT_PARSE_OK)
-            break;
-        memcpy(lept_context_push(c, sizeof(lept_value)), &e, sizeof(lept_value));
-        size++;
-        lept_parse_whitespace(c);
-        if (*c->json == ',') {
-            c->json++;
-            lept_parse_whitespace(c);
+    return 1;
+}
+
+/* Step to the next member of the container, return 0 after consuming its closing bracket */
+static int lept_cursor_next(lept_cursor* cur, char close, int error) {
+    if (cur->open) {
+        cur->open = 0;
+        if (cur->json == cur->end || *cur->json != close)
+            return 1;
+    }
+    else if (cur->json != cur->end && *cur->json == ',') {
+        cur->json = lept_skip_whitespace(cur->json + 1, cur->end);
+        return 1;
+    }
+    else if (cur->json == cur->end || *cur->json != close) {
+        cur->error = error;
+        return 0;
+    }
+    lept_cursor_consumed(cur, cur->json + 1);
+    cur->depth--;
+    return 0;
+}
+
+int lept_cursor_next_element(lept_cursor* cur, size_t array) {
+    assert(cur != NULL);
+    if (!lept_cursor_unwind(cur, array) || cur->depth != array)
+        return 0;
+    if (!lept_cursor_next(cur, ']', LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET))
+        return 0;
+    if (cur->json == cur->end) {
+        cur->error = LEPT_PARSE_EXPECT_VALUE;
+        return 0;
+    }
+    cur->pending = 1;
+    return 1;
+}
+
+/* Compare the key string at p with key, and return the position after it */
+static const char* lept_cursor_match_key(lept_cursor* cur, const char* p, const char* key, size_t klen, int* match) {
+    const char* q = lept_scan_string(p + 1, cur->end);
+    if (q != cur->end && *q == '\"') {
+        *match = (size_t)(q - p - 1) == klen && memcmp(p + 1, key, klen) == 0;
+        return q + 1;
+    }
+    else {
+        /* escaped or malformed key, decode it */
+        lept_context c;
+        char* s;
+        size_t len;
+        int ret;
+        c.json = p;
+        c.end = cur->end;
+        c.stack = NULL;
+        c.size = c.top = 0;
+        c.flags = 0;
+        if ((ret = lept_parse_string_raw(&c, &s, &len)) == LEPT_PARSE_OK)
+            *match = len == klen && memcmp(s, key, klen) == 0;
+        else
+            cur->error = ret;
+        free(c.stack);
+        return ret == LEPT_PARSE_OK ? c.json : NULL;
+    }
+}
+
+int lept_cursor_find_field(lept_cursor* cur, size_t object, const char* key, size_t klen) {
+    assert(cur != NULL && key != NULL);
+    if (!lept_cursor_unwind(cur, object) || cur->depth != object)
+        return 0;
+    while (lept_cursor_next(cur, '}', LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET)) {
+        const char* p;
+        int match = 0;
+        if (cur->json == cur->end || *cur->json != '"') {
+            cur->error = LEPT_PARSE_MISS_KEY;
+            return 0;
         }
-        else if (*c->json == ']') {
-            c->json++;
-            lept_set_array(v, size);
-            memcpy(v->u.a.e, lept_context_pop(c, size * sizeof(lept_value)), size * sizeof(lept_value));
-            v->u.a.size = size;
-            return LEPT_PARSE_OK;
+        if (!(p = lept_cursor_match_key(cur, cur->json, key, klen, &match)))
+            return 0;
+        p = lept_skip_whitespace(p, cur->end);
+        if (p == cur->end || *p != ':') {
+            cur->error = LEPT_PARSE_MISS_COLON;
+            return 0;
         }
-        else {
-            ret = LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
-            break;
+        cur->json = lept_skip_whitespace(p + 1, cur->end);
+        if (cur->json == cur->end) {
+            cur->error = LEPT_PARSE_EXPECT_VALUE;
+            return 0;
         }
+        cur->pending = 1;
+        if (match)
+            return 1;
+        if (lept_cursor_skip(cur) != LEPT_PARSE_OK)
+            return 0;
     }
-    /* Pop and free values on the stack */
-    for (i = 0; i < size; i++)
-        lept_free((lept_value*)lept_context_pop(c, sizeof(lept_value)));
-    return ret;
+    return 0;
 }
 
-static int lept_parse_object(lept_context* c, lept_value* v) {
-    size_t i, size;
-    lept_member m;
+/*
+ * Parallel parse of a root array. A pre-scan steps over the elements with the quote and bracket aware scanner and
+ * cuts the text at top-level commas into one segment per thread, counting the elements of each. The array is
+ * allocated once and every thread parses its segment straight into its own range of elements. Whatever the
+ * pre-scan or a segment does not accept is parsed again by lept_parse_n(), which reports the exact error.
+ */
+typedef struct {
+    const char* json;   /* first element */
+    const char* end;    /* the comma or ']' after the last one */
+    lept_value* e;
+    size_t count;
     int ret;
-    EXPECT(c, '{');
-    lept_parse_whitespace(c);
-    if (*c->json == '}') {
-        c->json++;
-        lept_set_object(v, 0);
-        return LEPT_PARSE_OK;
+}lept_segment;
+
+static void lept_parse_segment(lept_segment* s) {
+    lept_context c;
+    lept_keys keys; /* one per segment, as the segments are parsed at once */
+    size_t i;
+    if (lept_utf8_check(s->json, s->end) != s->end) { /* the bytes between segments are ASCII */
+        s->ret = LEPT_PARSE_INVALID_UTF8;
+        s->count = 0;
+        return;
     }
-    m.k = NULL;
-    size = 0;
-    for (;;) {
-        char* str;
-        lept_init(&m.v);
-        /* parse key */
-        if (*c->json != '"') {
-            ret = LEPT_PARSE_MISS_KEY;
-            break;
-        }
-        if ((ret = lept_parse_string_raw(c, &str, &m.klen)) != LEPT_PARSE_OK)
-            break;
-        memcpy(m.k = (char*)malloc(m.klen + 1), str, m.klen);
-        m.k[m.klen] = '\0';
-        /* parse ws colon ws */
-        lept_parse_whitespace(c);
-        if (*c->json != ':') {
-            ret = LEPT_PARSE_MISS_COLON;
-            break;
-        }
-        c->json++;
-        lept_parse_whitespace(c);
-        /* parse value */
-        if ((ret = lept_parse_value(c, &m.v)) != LEPT_PARSE_OK)
-            break;
-        memcpy(lept_context_push(c, sizeof(lept_member)), &m, sizeof(lept_member));
-        size++;
-        m.k = NULL; /* ownership is transferred to member on stack */
-        /* parse ws [comma | right-curly-brace] ws */
-        lept_parse_whitespace(c);
-        if (*c->json == ',') {
-            c->json++;
-            lept_parse_whitespace(c);
-        }
-        else if (*c->json == '}') {
-            c->json++;
-            lept_set_object(v, size);
-            memcpy(v->u.o.m, lept_context_pop(c, sizeof(lept_member) * size), sizeof(lept_member) * size);
-            v->u.o.size = size;
-            return LEPT_PARSE_OK;
+    c.json = s->json;
+    c.end = s->end;
+    c.stack = NULL;
+    c.size = c.top = 0;
+    c.flags = 0;
+    lept_keys_init(c.keys = &keys);
+    s->ret = LEPT_PARSE_OK;
+    for (i = 0; i < s->count; i++) {
+        if (i > 0) {
+            if (PEEK(&c) != ',') {
+                s->ret = LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
+                break;
+            }
+            c.json++;
+            lept_parse_whitespace(&c);
         }
-        else {
-            ret = LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+        if ((s->ret = lept_parse_value(&c, &s->e[i], 1)) != LEPT_PARSE_OK)
             break;
-        }
+        lept_parse_whitespace(&c);
     }
-    /* Pop and free members on the stack */
-    free(m.k);
-    for (i = 0; i < size; i++) {
-        lept_member* m = (lept_member*)lept_context_pop(c, sizeof(lept_member));
-        free(m->k);
-        lept_free(&m->v);
+    if (s->ret == LEPT_PARSE_OK && c.json != c.end)
+        s->ret = LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
+    if (s->ret != LEPT_PARSE_OK) {
+        while (i > 0)
+            lept_free(&s->e[--i]);
+        s->count = 0;
     }
-    v->type = LEPT_NULL;
-    return ret;
+    lept_keys_free(&keys);
+    free(c.stack);
+}
+
+#ifndef LEPT_NO_THREADS
+#if defined(_WIN32)
+static unsigned __stdcall lept_segment_worker(void* arg) {
+#else
+static void* lept_segment_worker(void* arg) {
+#endif
+    lept_parse_segment((lept_segment*)arg);
+    return 0;
 }
+#endif
 
-static int lept_parse_value(lept_context* c, lept_value* v) {
-    switch (*c->json) {
-        case 't':  return lept_parse_literal(c, v, "true", LEPT_TRUE);
-        case 'f':  return lept_parse_literal(c, v, "false", LEPT_FALSE);
-        case 'n':  return lept_parse_literal(c, v, "null", LEPT_NULL);
-        default:   return lept_parse_number(c, v);
-        case '"':  return lept_parse_string(c, v);
-        case '[':  return lept_parse_array(c, v);
-        case '{':  return lept_parse_object(c, v);
-        case '\0': return LEPT_PARSE_EXPECT_VALUE;
+/* Cut the elements of the array at p into at most n segments of about equal length, return their number or 0 */
+static size_t lept_split_array(const char* p, const char* end, lept_segment* s, size_t n) {
+    const char* q;
+    size_t target, i = 0;
+    assert(*p == '[');
+    p = lept_skip_whitespace(p + 1, end);
+    if (p == end || *p == ']')
+        return 0;
+    target = (size_t)(end - p) / n;
+    s[0].json = p;
+    s[0].count = 0;
+    for (;;) {
+        if ((q = lept_scan_value(p, end)) == NULL)
+            return 0;
+        s[i].count++;
+        if ((q = lept_skip_whitespace(q, end)) == end)
+            return 0;
+        if (*q == ']')
+            break;
+        if (*q != ',')
+            return 0;
+        if ((size_t)(q - s[i].json) >= target && i + 1 < n) {
+            s[i++].end = q;
+            s[i].json = lept_skip_whitespace(q + 1, end);
+            s[i].count = 0;
+        }
+        p = lept_skip_whitespace(q + 1, end);
     }
+    s[i].end = q;
+    return lept_skip_whitespace(q + 1, end) == end ? i + 1 : 0;
 }
 
-int lept_parse(lept_value* v, const char* json) {
-    lept_context c;
-    int ret;
-    assert(v != NULL);
-    c.json = json;
-    c.stack = NULL;
-    c.size = c.top = 0;
+int lept_parse_parallel(lept_value* v, const char* json, size_t len, unsigned threads) {
+    const char* p = lept_skip_whitespace(json, json + len);
+    lept_segment* s;
+    size_t n = len / LEPT_PARALLEL_SEGMENT_MIN, i, count = 0;
+    int ret = LEPT_PARSE_OK;
+#ifndef LEPT_NO_THREADS
+    lept_thread* t;
+    int* started;
+#endif
+    assert(v != NULL && json != NULL);
+    if (n > threads)
+        n = threads;
+    if (n < 2 || p == json + len || *p != '[')
+        return lept_parse_n(v, json, len);
+    s = (lept_segment*)malloc(n * sizeof(lept_segment));
+    if ((n = lept_split_array(p, json + len, s, n)) == 0) {
+        free(s);
+        return lept_parse_n(v, json, len);
+    }
+    for (i = 0; i < n; i++)
+        count += s[i].count;
+    if (count > LEPT_SIZE_MAX) {
+        free(s);
+        return lept_parse_n(v, json, len);
+    }
     lept_init(v);
-    lept_parse_whitespace(&c);
-    if ((ret = lept_parse_value(&c, v)) == LEPT_PARSE_OK) {
-        lept_parse_whitespace(&c);
-        if (*c.json != '\0') {
-            v->type = LEPT_NULL;
-            ret = LEPT_PARSE_ROOT_NOT_SINGULAR;
-        }
+    lept_set_array(v, count);
+    for (i = 0, count = 0; i < n; count += s[i++].count)
+        s[i].e = v->u.a.e + count;
+#ifndef LEPT_NO_THREADS
+    t = (lept_thread*)malloc(n * sizeof(lept_thread));
+    started = (int*)malloc(n * sizeof(int));
+    for (i = 1; i < n; i++)
+        started[i] = lept_thread_create(&t[i], lept_segment_worker, &s[i]);
+    lept_parse_segment(&s[0]);
+    for (i = 1; i < n; i++) {
+        if (started[i])
+            lept_thread_join(t[i]);
+        else
+            lept_parse_segment(&s[i]);
     }
-    assert(c.top == 0);
-    free(c.stack);
+    free(started);
+    free(t);
+#else
+    for (i = 0; i < n; i++)
+        lept_parse_segment(&s[i]);
+#endif
+    for (i = 0; i < n; i++)
+        if (s[i].ret != LEPT_PARSE_OK)
+            ret = s[i].ret;
+    if (ret == LEPT_PARSE_OK)
+        LEPT_ARRAY_SIZE(v) = count;
+    else {
+        for (i = 0; i < n; i++)
+            while (s[i].count > 0)
+                lept_free(&s[i].e[--s[i].count]);
+        lept_free(v);
+        ret = lept_parse_n(v, json, len);
+    }
+    free(s);
     return ret;
 }
 
@@ -371,36 +4379,89 @@ static void lept_stringify_string(lept_context* c, const char* s, size_t len) {
     c->top -= size - (p - head);
 }
 
-static void lept_stringify_value(lept_context* c, const lept_value* v) {
+static void lept_stringify_integer(lept_context* c, const lept_value* v) {
+    char buffer[21], *p = buffer + sizeof(buffer); /* "-9223372036854775808" or "18446744073709551615" */
+    uint64_t u;
+    int neg = 0;
+    if (v->flags & LEPT_VALUE_UINT64)
+        u = v->u.ui;
+    else if (v->u.i < 0) {
+        u = (uint64_t)0 - (uint64_t)v->u.i;
+        neg = 1;
+    }
+    else
+        u = (uint64_t)v->u.i;
+    do {
+        *--p = (char)('0' + u % 10);
+        u /= 10;
+    } while (u != 0);
+    if (neg)
+        *--p = '-';
+    PUTS(c, p, (size_t)(buffer + sizeof(buffer) - p));
+}
+
+/* A container being walked without recursion, and its next child */
+typedef struct {
+    const lept_value* v;
     size_t i;
-    switch (v->type) {
-        case LEPT_NULL:   PUTS(c, "null",  4); break;
-        case LEPT_FALSE:  PUTS(c, "false", 5); break;
-        case LEPT_TRUE:   PUTS(c, "true",  4); break;
-        case LEPT_NUMBER: c->top -= 32 - sprintf(lept_context_push(c, 32), "%.17g", v->u.n); break;
-        case LEPT_STRING: lept_stringify_string(c, v->u.s.s, v->u.s.len); break;
-        case LEPT_ARRAY:
-            PUTC(c, '[');
-            for (i = 0; i < v->u.a.size; i++) {
-                if (i > 0)
-                    PUTC(c, ',');
-                lept_stringify_value(c, &v->u.a.e[i]);
-            }
-            PUTC(c, ']');
-            break;
-        case LEPT_OBJECT:
-            PUTC(c, '{');
-            for (i = 0; i < v->u.o.size; i++) {
-                if (i > 0)
-                    PUTC(c, ',');
-                lept_stringify_string(c, v->u.o.m[i].k, v->u.o.m[i].klen);
-                PUTC(c, ':');
-                lept_stringify_value(c, &v->u.o.m[i].v);
-            }
-            PUTC(c, '}');
+}lept_frame;
+
+static void lept_stringify_value(lept_context* c, const lept_value* v) {
+    lept_context s; /* frames of the containers around v */
+    lept_frame* f;
+    size_t i = 0;
+    s.stack = NULL;
+    s.size = s.top = 0;
+    for (;;) {
+        switch (v->type) {
+            case LEPT_NULL:   PUTS(c, "null",  4); break;
+            case LEPT_FALSE:  PUTS(c, "false", 5); break;
+            case LEPT_TRUE:   PUTS(c, "true",  4); break;
+            case LEPT_NUMBER: c->top -= 32 - sprintf(lept_context_push(c, 32), "%.17g", v->u.n); break;
+            case LEPT_INTEGER: lept_stringify_integer(c, v); break;
+            case LEPT_STRING: lept_stringify_string(c, lept_get_string(v), lept_get_string_length(v)); break;
+            case LEPT_ARRAY:
+                if (i == 0)
+                    PUTC(c, '[');
+                if (i < LEPT_ARRAY_SIZE(v)) {
+                    if (i > 0)
+                        PUTC(c, ',');
+                    f = (lept_frame*)lept_context_push(&s, sizeof(lept_frame));
+                    f->v = v;
+                    f->i = i + 1;
+                    v = &v->u.a.e[i];
+                    i = 0;
+                    continue;
+                }
+                PUTC(c, ']');
+                break;
+            case LEPT_OBJECT:
+                if (i == 0)
+                    PUTC(c, '{');
+                if (i < LEPT_OBJECT_SIZE(v)) {
+                    if (i > 0)
+                        PUTC(c, ',');
+                    lept_stringify_string(c, v->u.o.m[i].k, v->u.o.m[i].klen);
+                    PUTC(c, ':');
+                    f = (lept_frame*)lept_context_push(&s, sizeof(lept_frame));
+                    f->v = v;
+                    f->i = i + 1;
+                    v = &v->u.o.m[i].v;
+                    i = 0;
+                    continue;
+                }
+                PUTC(c, '}');
+                break;
+            default: assert(0 && "invalid type");
+        }
+        /* v is written, go on with the container around it */
+        if (s.top == 0)
             break;
-        default: assert(0 && "invalid type");
+        f = (lept_frame*)lept_context_pop(&s, sizeof(lept_frame));
+        v = f->v;
+        i = f->i;
     }
+    free(s.stack);
 }
 
 char* lept_stringify(const lept_value* v, size_t* length) {
@@ -419,7 +4480,7 @@ void lept_copy(lept_value* dst, const lept_value* src) {
     assert(src != NULL && dst != NULL && src != dst);
     switch (src->type) {
         case LEPT_STRING:
-            lept_set_string(dst, src->u.s.s, src->u.s.len);
+            lept_set_string(dst, lept_get_string(src), lept_get_string_length(src));
             break;
         case LEPT_ARRAY:
             /* \todo */
@@ -452,27 +4513,57 @@ void lept_swap(lept_value* lhs, lept_value* rhs) {
 }
 
 void lept_free(lept_value* v) {
-    size_t i;
+    lept_context s; /* frames of the containers around v */
+    lept_frame* f;
+    lept_value* e;
+    size_t i = 0;
     assert(v != NULL);
-    switch (v->type) {
-        case LEPT_STRING:
-            free(v->u.s.s);
-            break;
-        case LEPT_ARRAY:
-            for (i = 0; i < v->u.a.size; i++)
-                lept_free(&v->u.a.e[i]);
-            free(v->u.a.e);
-            break;
-        case LEPT_OBJECT:
-            for (i = 0; i < v->u.o.size; i++) {
-                free(v->u.o.m[i].k);
-                lept_free(&v->u.o.m[i].v);
+    s.stack = NULL;
+    s.size = s.top = 0;
+    for (;;) {
+        if (v->type == LEPT_ARRAY && i < LEPT_ARRAY_SIZE(v))
+            e = &v->u.a.e[i++];
+        else if (v->type == LEPT_OBJECT && i < LEPT_OBJECT_SIZE(v)) {
+            if (!(v->flags & LEPT_VALUE_KEYS_REF))
+                lept_key_release(v->u.o.m[i].k);
+            e = &v->u.o.m[i++].v;
+        }
+        else {
+            /* the children of v are freed */
+            switch (v->type) {
+                case LEPT_STRING:
+                    if (!(v->flags & (LEPT_VALUE_STRING_REF | LEPT_VALUE_STRING_SHORT)))
+                        free(v->u.s.s);
+                    break;
+                case LEPT_ARRAY:
+                    if (!(v->flags & LEPT_VALUE_STORAGE_REF))
+                        lept_storage_free(v->u.a.e);
+                    break;
+                case LEPT_OBJECT:
+                    if (!(v->flags & LEPT_VALUE_STORAGE_REF))
+                        lept_storage_free(v->u.o.m);
+                    break;
+                default: break;
             }
-            free(v->u.o.m);
-            break;
-        default: break;
+            v->type = LEPT_NULL;
+            if (s.top == 0)
+                break;
+            f = (lept_frame*)lept_context_pop(&s, sizeof(lept_frame));
+            v = (lept_value*)f->v;
+            i = f->i;
+            continue;
+        }
+        if (e->type == LEPT_ARRAY || e->type == LEPT_OBJECT) {
+            f = (lept_frame*)lept_context_push(&s, sizeof(lept_frame));
+            f->v = v;
+            f->i = i;
+            v = e;
+            i = 0;
+        }
+        else if (e->type == LEPT_STRING && !(e->flags & (LEPT_VALUE_STRING_REF | LEPT_VALUE_STRING_SHORT)))
+            free(e->u.s.s);
     }
-    v->type = LEPT_NULL;
+    free(s.stack);
 }
 
 lept_type lept_get_type(const lept_value* v) {
@@ -480,21 +4571,37 @@ lept_type lept_get_type(const lept_value* v) {
     return v->type;
 }
 
+/* Exact comparison of a double with a LEPT_INTEGER, without rounding the integer */
+static int lept_is_equal_number_integer(double n, const lept_value* v) {
+    if (n >= 9223372036854775808.0 && n < 18446744073709551616.0) /* 2^63 <= n < 2^64, always integral */
+        return (v->flags & LEPT_VALUE_UINT64) && (uint64_t)n == v->u.ui;
+    if (n >= -9223372036854775808.0 && n < 9223372036854775808.0)
+        return !(v->flags & LEPT_VALUE_UINT64) && (double)(int64_t)n == n && (int64_t)n == v->u.i;
+    return 0;
+}
+
 int lept_is_equal(const lept_value* lhs, const lept_value* rhs) {
     size_t i;
     assert(lhs != NULL && rhs != NULL);
+    if (lhs->type == LEPT_NUMBER && rhs->type == LEPT_INTEGER)
+        return lept_is_equal_number_integer(lhs->u.n, rhs);
+    if (lhs->type == LEPT_INTEGER && rhs->type == LEPT_NUMBER)
+        return lept_is_equal_number_integer(rhs->u.n, lhs);
     if (lhs->type != rhs->type)
         return 0;
     switch (lhs->type) {
         case LEPT_STRING:
-            return lhs->u.s.len == rhs->u.s.len && 
-                memcmp(lhs->u.s.s, rhs->u.s.s, lhs->u.s.len) == 0;
+            return lept_get_string_length(lhs) == lept_get_string_length(rhs) &&
+                memcmp(lept_get_string(lhs), lept_get_string(rhs), lept_get_string_length(lhs)) == 0;
         case LEPT_NUMBER:
             return lhs->u.n == rhs->u.n;
+        case LEPT_INTEGER:
+            /* both flagged or both not, as only values above INT64_MAX use u.ui */
+            return (lhs->flags & LEPT_VALUE_UINT64) == (rhs->flags & LEPT_VALUE_UINT64) && lhs->u.i == rhs->u.i;
         case LEPT_ARRAY:
-            if (lhs->u.a.size != rhs->u.a.size)
+            if (LEPT_ARRAY_SIZE(lhs) != LEPT_ARRAY_SIZE(rhs))
                 return 0;
-            for (i = 0; i < lhs->u.a.size; i++)
+            for (i = 0; i < LEPT_ARRAY_SIZE(lhs); i++)
                 if (!lept_is_equal(&lhs->u.a.e[i], &rhs->u.a.e[i]))
                     return 0;
             return 1;
@@ -517,7 +4624,9 @@ void lept_set_boolean(lept_value* v, int b) {
 }
 
 double lept_get_number(const lept_value* v) {
-    assert(v != NULL && v->type == LEPT_NUMBER);
+    assert(v != NULL && (v->type == LEPT_NUMBER || v->type == LEPT_INTEGER));
+    if (v->type == LEPT_INTEGER)
+        return (v->flags & LEPT_VALUE_UINT64) ? (double)v->u.ui : (double)v->u.i;
     return v->u.n;
 }
 
@@ -527,108 +4636,186 @@ void lept_set_number(lept_value* v, double n) {
     v->type = LEPT_NUMBER;
 }
 
+int lept_is_int64(const lept_value* v) {
+    assert(v != NULL);
+    return v->type == LEPT_INTEGER && !(v->flags & LEPT_VALUE_UINT64);
+}
+
+int lept_is_uint64(const lept_value* v) {
+    assert(v != NULL);
+    return v->type == LEPT_INTEGER && ((v->flags & LEPT_VALUE_UINT64) || v->u.i >= 0);
+}
+
+int64_t lept_get_integer(const lept_value* v) {
+    assert(v != NULL && lept_is_int64(v));
+    return v->u.i;
+}
+
+void lept_set_integer(lept_value* v, int64_t i) {
+    lept_free(v);
+    v->u.i = i;
+    v->type = LEPT_INTEGER;
+    v->flags = 0;
+}
+
+uint64_t lept_get_uint64(const lept_value* v) {
+    assert(v != NULL && lept_is_uint64(v));
+    return (v->flags & LEPT_VALUE_UINT64) ? v->u.ui : (uint64_t)v->u.i;
+}
+
+void lept_set_uint64(lept_value* v, uint64_t u) {
+    lept_free(v);
+    if (u > INT64_MAX) {
+        v->u.ui = u;
+        v->flags = LEPT_VALUE_UINT64;
+    }
+    else {
+        v->u.i = (int64_t)u;
+        v->flags = 0;
+    }
+    v->type = LEPT_INTEGER;
+}
+
 const char* lept_get_string(const lept_value* v) {
     assert(v != NULL && v->type == LEPT_STRING);
-    return v->u.s.s;
+    return v->flags & LEPT_VALUE_STRING_SHORT ? v->u.ss : v->u.s.s;
 }
 
 size_t lept_get_string_length(const lept_value* v) {
     assert(v != NULL && v->type == LEPT_STRING);
-    return v->u.s.len;
+#ifdef LEPT_COMPACT
+    return LEPT_STRING_LENGTH(v);
+#else
+    return v->flags & LEPT_VALUE_STRING_SHORT ? (unsigned char)v->u.ss[sizeof(v->u.ss) - 1] : LEPT_STRING_LENGTH(v);
+#endif
+}
+
+/* Keep a string of up to LEPT_STRING_SHORT_MAX bytes in the value itself, without allocating */
+static void lept_set_string_short(lept_value* v, const char* s, size_t len) {
+    assert(len <= LEPT_STRING_SHORT_MAX);
+    if (len > 0)
+        memcpy(v->u.ss, s, len);
+    v->u.ss[len] = '\0';
+#ifdef LEPT_COMPACT
+    LEPT_STRING_LENGTH(v) = len;
+#else
+    v->u.ss[sizeof(v->u.ss) - 1] = (char)len;
+#endif
+    v->type = LEPT_STRING;
+    v->flags = LEPT_VALUE_STRING_SHORT;
 }
 
 void lept_set_string(lept_value* v, const char* s, size_t len) {
-    assert(v != NULL && (s != NULL || len == 0));
+    assert(v != NULL && (s != NULL || len == 0) && len <= LEPT_SIZE_MAX);
     lept_free(v);
+    if (len <= LEPT_STRING_SHORT_MAX) {
+        lept_set_string_short(v, s, len);
+        return;
+    }
     v->u.s.s = (char*)malloc(len + 1);
     memcpy(v->u.s.s, s, len);
     v->u.s.s[len] = '\0';
-    v->u.s.len = len;
+    LEPT_STRING_LENGTH(v) = len;
     v->type = LEPT_STRING;
+    v->flags = 0;
 }
 
 void lept_set_array(lept_value* v, size_t capacity) {
-    assert(v != NULL);
+    assert(v != NULL && capacity <= LEPT_SIZE_MAX);
     lept_free(v);
     v->type = LEPT_ARRAY;
-    v->u.a.size = 0;
-    v->u.a.capacity = capacity;
-    v->u.a.e = capacity > 0 ? (lept_value*)malloc(capacity * sizeof(lept_value)) : NULL;
+    v->flags = 0;
+    LEPT_ARRAY_SIZE(v) = 0;
+    LEPT_SET_CAPACITY(v->u.a, capacity);
+    v->u.a.e = (lept_value*)lept_storage_resize(NULL, capacity, sizeof(lept_value));
 }
 
 size_t lept_get_array_size(const lept_value* v) {
     assert(v != NULL && v->type == LEPT_ARRAY);
-    return v->u.a.size;
+    return LEPT_ARRAY_SIZE(v);
 }
 
 size_t lept_get_array_capacity(const lept_value* v) {
     assert(v != NULL && v->type == LEPT_ARRAY);
-    return v->u.a.capacity;
+    return LEPT_ARRAY_CAPACITY(v);
+}
+
+/* Resize the elements of v, which are moved to storage of its own first if they are in a lept_document */
+static lept_value* lept_array_resize(lept_value* v, size_t capacity) {
+    lept_value* e;
+    if (!(v->flags & LEPT_VALUE_STORAGE_REF))
+        return (lept_value*)lept_storage_resize(v->u.a.e, capacity, sizeof(lept_value));
+    e = (lept_value*)lept_storage_resize(NULL, capacity, sizeof(lept_value));
+    if (LEPT_ARRAY_SIZE(v) > 0)
+        memcpy(e, v->u.a.e, LEPT_ARRAY_SIZE(v) * sizeof(lept_value));
+    v->flags = 0;
+    return e;
 }
 
 void lept_reserve_array(lept_value* v, size_t capacity) {
     assert(v != NULL && v->type == LEPT_ARRAY);
-    if (v->u.a.capacity < capacity) {
-        v->u.a.capacity = capacity;
-        v->u.a.e = (lept_value*)realloc(v->u.a.e, capacity * sizeof(lept_value));
+    if (LEPT_ARRAY_CAPACITY(v) < capacity) {
+        LEPT_SET_CAPACITY(v->u.a, capacity);
+        v->u.a.e = lept_array_resize(v, capacity);
     }
 }
 
 void lept_shrink_array(lept_value* v) {
     assert(v != NULL && v->type == LEPT_ARRAY);
-    if (v->u.a.capacity > v->u.a.size) {
-        v->u.a.capacity = v->u.a.size;
-        v->u.a.e = (lept_value*)realloc(v->u.a.e, v->u.a.capacity * sizeof(lept_value));
+    if (LEPT_ARRAY_CAPACITY(v) > LEPT_ARRAY_SIZE(v)) {
+        LEPT_SET_CAPACITY(v->u.a, LEPT_ARRAY_SIZE(v));
+        v->u.a.e = lept_array_resize(v, LEPT_ARRAY_SIZE(v));
     }
 }
 
 void lept_clear_array(lept_value* v) {
     assert(v != NULL && v->type == LEPT_ARRAY);
-    lept_erase_array_element(v, 0, v->u.a.size);
+    lept_erase_array_element(v, 0, LEPT_ARRAY_SIZE(v));
 }
 
 lept_value* lept_get_array_element(lept_value* v, size_t index) {
     assert(v != NULL && v->type == LEPT_ARRAY);
-    assert(index < v->u.a.size);
+    assert(index < LEPT_ARRAY_SIZE(v));
     return &v->u.a.e[index];
 }
 
 lept_value* lept_pushback_array_element(lept_value* v) {
-    assert(v != NULL && v->type == LEPT_ARRAY);
-    if (v->u.a.size == v->u.a.capacity)
-        lept_reserve_array(v, v->u.a.capacity == 0 ? 1 : v->u.a.capacity * 2);
-    lept_init(&v->u.a.e[v->u.a.size]);
-    return &v->u.a.e[v->u.a.size++];
+    assert(v != NULL && v->type == LEPT_ARRAY && LEPT_ARRAY_SIZE(v) < LEPT_SIZE_MAX);
+    if (LEPT_ARRAY_SIZE(v) == LEPT_ARRAY_CAPACITY(v))
+        lept_reserve_array(v, LEPT_ARRAY_SIZE(v) == 0 ? 1 : LEPT_ARRAY_SIZE(v) * 2);
+    lept_init(&v->u.a.e[LEPT_ARRAY_SIZE(v)]);
+    return &v->u.a.e[LEPT_ARRAY_SIZE(v)++];
 }
 
 void lept_popback_array_element(lept_value* v) {
-    assert(v != NULL && v->type == LEPT_ARRAY && v->u.a.size > 0);
-    lept_free(&v->u.a.e[--v->u.a.size]);
+    assert(v != NULL && v->type == LEPT_ARRAY && LEPT_ARRAY_SIZE(v) > 0);
+    lept_free(&v->u.a.e[--LEPT_ARRAY_SIZE(v)]);
 }
 
 lept_value* lept_insert_array_element(lept_value* v, size_t index) {
-    assert(v != NULL && v->type == LEPT_ARRAY && index <= v->u.a.size);
+    assert(v != NULL && v->type == LEPT_ARRAY && index <= LEPT_ARRAY_SIZE(v));
     /* \todo */
     return NULL;
 }
 
 void lept_erase_array_element(lept_value* v, size_t index, size_t count) {
-    assert(v != NULL && v->type == LEPT_ARRAY && index + count <= v->u.a.size);
+    assert(v != NULL && v->type == LEPT_ARRAY && index + count <= LEPT_ARRAY_SIZE(v));
     /* \todo */
 }
 
 void lept_set_object(lept_value* v, size_t capacity) {
-    assert(v != NULL);
+    assert(v != NULL && capacity <= LEPT_SIZE_MAX);
     lept_free(v);
     v->type = LEPT_OBJECT;
-    v->u.o.size = 0;
-    v->u.o.capacity = capacity;
-    v->u.o.m = capacity > 0 ? (lept_member*)malloc(capacity * sizeof(lept_member)) : NULL;
+    v->flags = 0;
+    LEPT_OBJECT_SIZE(v) = 0;
+    LEPT_SET_CAPACITY(v->u.o, capacity);
+    v->u.o.m = (lept_member*)lept_storage_resize(NULL, capacity, sizeof(lept_member));
 }
 
 size_t lept_get_object_size(const lept_value* v) {
     assert(v != NULL && v->type == LEPT_OBJECT);
-    return v->u.o.size;
+    return LEPT_OBJECT_SIZE(v);
 }
 
 size_t lept_get_object_capacity(const lept_value* v) {
@@ -654,27 +4841,29 @@ void lept_clear_object(lept_value* v) {
 
 const char* lept_get_object_key(const lept_value* v, size_t index) {
     assert(v != NULL && v->type == LEPT_OBJECT);
-    assert(index < v->u.o.size);
+    assert(index < LEPT_OBJECT_SIZE(v));
     return v->u.o.m[index].k;
 }
 
 size_t lept_get_object_key_length(const lept_value* v, size_t index) {
     assert(v != NULL && v->type == LEPT_OBJECT);
-    assert(index < v->u.o.size);
+    assert(index < LEPT_OBJECT_SIZE(v));
     return v->u.o.m[index].klen;
 }
 
 lept_value* lept_get_object_value(lept_value* v, size_t index) {
     assert(v != NULL && v->type == LEPT_OBJECT);
-    assert(index < v->u.o.size);
+    assert(index < LEPT_OBJECT_SIZE(v));
     return &v->u.o.m[index].v;
 }
 
 size_t lept_find_object_index(const lept_value* v, const char* key, size_t klen) {
+    const lept_member* m;
     size_t i;
     assert(v != NULL && v->type == LEPT_OBJECT && key != NULL);
-    for (i = 0; i < v->u.o.size; i++)
-        if (v->u.o.m[i].klen == klen && memcmp(v->u.o.m[i].k, key, klen) == 0)
+    m = v->u.o.m;
+    for (i = 0; i < LEPT_OBJECT_SIZE(v); i++)
+        if (m[i].klen == klen && (m[i].k == key || memcmp(m[i].k, key, klen) == 0)) /* same pointer: an interned key */
             return i;
     return LEPT_KEY_NOT_EXIST;
 }
@@ -691,6 +4880,124 @@ lept_value* lept_set_object_value(lept_value* v, const char* key, size_t klen) {
 }
 
 void lept_remove_object_value(lept_value* v, size_t index) {
-    assert(v != NULL && v->type == LEPT_OBJECT && index < v->u.o.size);
+    assert(v != NULL && v->type == LEPT_OBJECT && index < LEPT_OBJECT_SIZE(v));
     /* \todo */
 }
+
+void lept_tape_free(lept_tape* t) {
+    assert(t != NULL);
+    free(t->w);
+    t->w = NULL;
+    t->s = NULL;
+    t->size = 0;
+}
+
+lept_type lept_tape_get_type(const lept_tape* t, size_t i) {
+    assert(t != NULL && i < t->size);
+    return LEPT_TAPE_TYPE(t->w[i]);
+}
+
+size_t lept_tape_skip(const lept_tape* t, size_t i) {
+    assert(t != NULL && i < t->size);
+    switch (LEPT_TAPE_TYPE(t->w[i])) {
+        case LEPT_ARRAY:
+        case LEPT_OBJECT: return (size_t)LEPT_TAPE_PAYLOAD(t->w[i]);
+        case LEPT_NUMBER:
+        case LEPT_INTEGER:
+        case LEPT_STRING: return i + 2;
+        default:          return i + 1;
+    }
+}
+
+int lept_tape_get_boolean(const lept_tape* t, size_t i) {
+    assert(t != NULL && i < t->size && (LEPT_TAPE_TYPE(t->w[i]) == LEPT_TRUE || LEPT_TAPE_TYPE(t->w[i]) == LEPT_FALSE));
+    return LEPT_TAPE_TYPE(t->w[i]) == LEPT_TRUE;
+}
+
+double lept_tape_get_number(const lept_tape* t, size_t i) {
+    double n;
+    assert(t != NULL && i < t->size);
+    if (LEPT_TAPE_TYPE(t->w[i]) == LEPT_INTEGER)
+        return LEPT_TAPE_PAYLOAD(t->w[i]) & LEPT_VALUE_UINT64 ? (double)t->w[i + 1] : (double)(int64_t)t->w[i + 1];
+    assert(LEPT_TAPE_TYPE(t->w[i]) == LEPT_NUMBER);
+    memcpy(&n, &t->w[i + 1], sizeof(n));
+    return n;
+}
+
+int lept_tape_is_int64(const lept_tape* t, size_t i) {
+    assert(t != NULL && i < t->size);
+    return LEPT_TAPE_TYPE(t->w[i]) == LEPT_INTEGER && !(LEPT_TAPE_PAYLOAD(t->w[i]) & LEPT_VALUE_UINT64);
+}
+
+int lept_tape_is_uint64(const lept_tape* t, size_t i) {
+    assert(t != NULL && i < t->size);
+    return LEPT_TAPE_TYPE(t->w[i]) == LEPT_INTEGER && ((LEPT_TAPE_PAYLOAD(t->w[i]) & LEPT_VALUE_UINT64) || (int64_t)t->w[i + 1] >= 0);
+}
+
+int64_t lept_tape_get_integer(const lept_tape* t, size_t i) {
+    assert(lept_tape_is_int64(t, i));
+    return (int64_t)t->w[i + 1];
+}
+
+uint64_t lept_tape_get_uint64(const lept_tape* t, size_t i) {
+    assert(lept_tape_is_uint64(t, i));
+    return t->w[i + 1];
+}
+
+const char* lept_tape_get_string(const lept_tape* t, size_t i) {
+    assert(t != NULL && i < t->size && LEPT_TAPE_TYPE(t->w[i]) == LEPT_STRING);
+    return t->s + LEPT_TAPE_PAYLOAD(t->w[i]);
+}
+
+size_t lept_tape_get_string_length(const lept_tape* t, size_t i) {
+    assert(t != NULL && i < t->size && LEPT_TAPE_TYPE(t->w[i]) == LEPT_STRING);
+    return (size_t)t->w[i + 1];
+}
+
+size_t lept_tape_get_array_size(const lept_tape* t, size_t i) {
+    assert(t != NULL && i < t->size && LEPT_TAPE_TYPE(t->w[i]) == LEPT_ARRAY);
+    return (size_t)t->w[i + 1];
+}
+
+size_t lept_tape_get_array_element(const lept_tape* t, size_t i, size_t index) {
+    size_t e;
+    assert(index < lept_tape_get_array_size(t, i));
+    for (e = i + 2; index > 0; index--)
+        e = lept_tape_skip(t, e);
+    return e;
+}
+
+size_t lept_tape_get_object_size(const lept_tape* t, size_t i) {
+    assert(t != NULL && i < t->size && LEPT_TAPE_TYPE(t->w[i]) == LEPT_OBJECT);
+    return (size_t)t->w[i + 1];
+}
+
+/* Position of the key of member index, its value follows at + 2 */
+static size_t lept_tape_get_member(const lept_tape* t, size_t i, size_t index) {
+    size_t m;
+    assert(index < lept_tape_get_object_size(t, i));
+    for (m = i + 2; index > 0; index--)
+        m = lept_tape_skip(t, m + 2);
+    return m;
+}
+
+const char* lept_tape_get_object_key(const lept_tape* t, size_t i, size_t index) {
+    return lept_tape_get_string(t, lept_tape_get_member(t, i, index));
+}
+
+size_t lept_tape_get_object_key_length(const lept_tape* t, size_t i, size_t index) {
+    return lept_tape_get_string_length(t, lept_tape_get_member(t, i, index));
+}
+
+size_t lept_tape_get_object_value(const lept_tape* t, size_t i, size_t index) {
+    return lept_tape_get_member(t, i, index) + 2;
+}
+
+size_t lept_tape_find_object_value(const lept_tape* t, size_t i, const char* key, size_t klen) {
+    size_t m, n;
+    assert(key != NULL);
+    for (m = i + 2, n = lept_tape_get_object_size(t, i); n > 0; n--, m = lept_tape_skip(t, m + 2))
+        if (t->w[m + 1] == klen && memcmp(t->s + LEPT_TAPE_PAYLOAD(t->w[m]), key, klen) == 0)
+            return m + 2;
+    return LEPT_KEY_NOT_EXIST;
+}
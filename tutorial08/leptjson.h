@@ -2,23 +2,61 @@
 #define LEPTJSON_H__
 
 #include <stddef.h> /* size_t */
+#include <stdint.h> /* int64_t, uint64_t */
 
-typedef enum { LEPT_NULL, LEPT_FALSE, LEPT_TRUE, LEPT_NUMBER, LEPT_STRING, LEPT_ARRAY, LEPT_OBJECT } lept_type;
+typedef enum { LEPT_NULL, LEPT_FALSE, LEPT_TRUE, LEPT_NUMBER, LEPT_INTEGER, LEPT_STRING, LEPT_ARRAY, LEPT_OBJECT } lept_type;
 
 #define LEPT_KEY_NOT_EXIST ((size_t)-1)
 
+#ifndef LEPT_PARSE_MAX_DEPTH
+#define LEPT_PARSE_MAX_DEPTH 1024 /* containers open at once, deeper input fails with LEPT_PARSE_TOO_DEEP */
+#endif
+
 typedef struct lept_value lept_value;
 typedef struct lept_member lept_member;
 
+#ifdef LEPT_COMPACT
+/*
+ * 16-byte values, for documents held in memory by the million. Define LEPT_COMPACT for the library and every file
+ * that includes this header. Counts and string lengths are 32-bit, array and object capacities are kept in front
+ * of their storage, and strings of up to 7 bytes are kept in place. Parsing a longer string or a larger array or
+ * object fails with LEPT_PARSE_TOO_LARGE, and building one with the functions below is an assertion failure.
+ */
+#ifndef LEPT_SIZE_MAX
+#define LEPT_SIZE_MAX UINT32_MAX    /* longest string, most elements or members */
+#endif
+
+struct lept_value {
+    union {
+        struct { lept_member* m; }o;                        /* object: members */
+        struct { lept_value*  e; }a;                        /* array:  elements */
+        struct { char* s; }s;                               /* string: null-terminated string */
+        char ss[8];                                         /* short string: kept in place */
+        double n;                                           /* number */
+        int64_t i;                                          /* integer */
+        uint64_t ui;                                        /* integer above INT64_MAX */
+    }u;
+    uint32_t size;                                          /* member count, element count or string length */
+    unsigned char type;                                     /* lept_type */
+    unsigned char flags;                                    /* storage flags of string, array and object, internal */
+};
+#else
+#define LEPT_SIZE_MAX ((size_t)-1)
+
 struct lept_value {
     union {
         struct { lept_member* m; size_t size, capacity; }o; /* object: members, member count, capacity */
         struct { lept_value*  e; size_t size, capacity; }a; /* array:  elements, element count, capacity */
         struct { char* s; size_t len; }s;                   /* string: null-terminated string, string length */
+        char ss[sizeof(lept_member*) + 2 * sizeof(size_t)]; /* short string: kept in place, length in last byte */
         double n;                                           /* number */
+        int64_t i;                                          /* integer */
+        uint64_t ui;                                        /* integer above INT64_MAX */
     }u;
     lept_type type;
+    unsigned char flags;                                    /* storage flags of string, array and object, internal */
 };
+#endif
 
 struct lept_member {
     char* k; size_t klen;   /* member key string, key string length */
@@ -39,13 +77,148 @@ enum {
     LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET,
     LEPT_PARSE_MISS_KEY,
     LEPT_PARSE_MISS_COLON,
-    LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET
+    LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET,
+    LEPT_PARSE_TYPE_MISMATCH,               /* cursor: the value is not of the requested type */
+    LEPT_PARSE_STOPPED,                     /* a lept_handler callback returned 0 */
+    LEPT_PARSE_INCOMPLETE,                  /* lept_feed(): the root value needs more input */
+    LEPT_PARSE_FILE_ERROR,                  /* the file cannot be opened or mapped */
+    LEPT_PARSE_TOO_DEEP,                    /* containers nest deeper than LEPT_PARSE_MAX_DEPTH */
+    LEPT_PARSE_INVALID_UTF8,                /* the input is not well-formed UTF-8, wherever the bad bytes are */
+    LEPT_PARSE_TOO_LARGE                    /* LEPT_COMPACT: a string, array or object is past LEPT_SIZE_MAX */
+};
+
+enum {
+    LEPT_PARSE_DEFAULT_FLAG = 0,
+    LEPT_PARSE_ZERO_COPY_FLAG = 1,      /* strings without escapes point into json instead of being copied */
+    LEPT_PARSE_STRUCTURAL_FLAG = 2,     /* two-stage engine: index structural characters with SIMD, then build the tree */
+    LEPT_PARSE_NO_UTF8_CHECK_FLAG = 4   /* trust the input to be UTF-8, non-ASCII bytes are then copied unchecked */
 };
 
 #define lept_init(v) do { (v)->type = LEPT_NULL; } while(0)
 
 int lept_parse(lept_value* v, const char* json);
-char* lept_stringify(const lept_value* v, size_t* length);
+/* Parse exactly len bytes of json, which needs no null terminator. Embedded '\0' is an error. */
+int lept_parse_n(lept_value* v, const char* json, size_t len);
+/*
+ * With LEPT_PARSE_ZERO_COPY_FLAG, json must outlive v. Strings that reference json are not
+ * null-terminated, so use lept_get_string_length() with lept_get_string() in this mode.
+ */
+int lept_parse_ex(lept_value* v, const char* json, size_t len, unsigned flags);
+/*
+ * Destructive parse of a writable buffer: strings are unescaped and null-terminated in place, and string values
+ * and object keys point into buf, so buf must outlive v. Its content is unspecified afterwards.
+ */
+int lept_parse_insitu(lept_value* v, char* buf, size_t len);
+/* Check json without building a value or allocating, the result is that of lept_parse_n() */
+int lept_validate(const char* json, size_t len);
+/*
+ * Step over the value json starts with, after any whitespace, without allocating. Brackets are counted 64 bytes at a
+ * time with strings masked out by their quotes and escapes. Nothing is validated. Returns the byte after the value,
+ * or NULL when there is none or the input ends inside it.
+ */
+const char* lept_skip_value(const char* json, size_t len);
+/*
+ * Projection: build only what the JSON Pointer paths select, such as "/user/id", where a "*" token stands for every
+ * member or element. Objects on the way keep only the members on some path, arrays keep their size with null for
+ * the elements no path selects. Everything else is stepped over as by lept_skip_value() and is not validated.
+ */
+int lept_parse_paths(lept_value* v, const char* json, size_t len, const char* const* paths, size_t count);
+
+/*
+ * Event-driven parse with the same scanner as the DOM, which is built by a handler too. Callbacks return
+ * non-zero to go on, and a NULL callback ignores its event. Strings and keys are not null-terminated and are
+ * only valid during the call. Events up to the point of failure have been delivered when an error is returned.
+ */
+typedef struct {
+    int (*null)(void* user);
+    int (*boolean)(void* user, int b);
+    int (*number)(void* user, double n);
+    int (*integer)(void* user, int64_t i);      /* NULL: reported through number */
+    int (*uint64)(void* user, uint64_t u);      /* above INT64_MAX, NULL: reported through number */
+    int (*string)(void* user, const char* s, size_t len);
+    int (*start_object)(void* user);
+    int (*key)(void* user, const char* s, size_t len);
+    int (*end_object)(void* user, size_t count);
+    int (*start_array)(void* user);
+    int (*end_array)(void* user, size_t count);
+}lept_handler;
+
+int lept_parse_sax(const char* json, size_t len, const lept_handler* h, void* user);
+
+/*
+ * Push parser for input that arrives in chunks. lept_feed() returns LEPT_PARSE_INCOMPLETE until the root value is
+ * complete and LEPT_PARSE_OK from then on, while only whitespace follows. A chunk of length 0 ends the input, which
+ * is needed to complete a root number. Errors are those lept_parse_n() reports for the whole text and are sticky,
+ * but UTF-8 is checked chunk by chunk, so a syntax error in an earlier chunk comes before LEPT_PARSE_INVALID_UTF8.
+ * Events go to h, or with a NULL handler the DOM is built and taken by lept_push_get_value(). Memory is bounded by
+ * the nesting depth and the longest string or number, the text itself is never kept.
+ */
+typedef struct {
+    const lept_handler* h;
+    void* user;
+    lept_value v;           /* root built when h is NULL */
+    char* stack;            /* DOM members, then the token being read */
+    size_t size, top, mark; /* mark: start of the token */
+    size_t* level;          /* per open container: values so far << 1 | 1 for an object */
+    size_t depth, capacity;
+    int state, key, have_key, error;
+    unsigned u, hi;         /* \u escape being read, high surrogate */
+    int n;                  /* hex digits or literal bytes read */
+    char utf8[4];           /* a UTF-8 sequence cut by the end of the last chunk */
+    size_t utf8_len;
+    struct lept_keys* keys; /* object keys of the DOM, interned */
+}lept_push;
+
+void lept_push_init(lept_push* p, const lept_handler* h, void* user);
+int lept_feed(lept_push* p, const char* chunk, size_t len);
+void lept_push_get_value(lept_push* p, lept_value* v);
+void lept_push_free(lept_push* p);
+
+/*
+ * Parse newline-delimited JSON, one document per line, on up to threads threads (1 or 0: the calling thread only).
+ * cb gets the records in input order with their 1-based line number and parse result, and may take v with
+ * lept_move(), it is freed otherwise. Blank lines are skipped. Returns LEPT_PARSE_STOPPED once cb returns 0.
+ */
+typedef int (*lept_record_func)(void* user, size_t line, int ret, lept_value* v);
+int lept_parse_ndjson(const char* json, size_t len, unsigned threads, lept_record_func cb, void* user);
+
+/*
+ * Parse a root array on up to threads threads, each parsing a run of its elements, with the result and errors of
+ * lept_parse_n(). Other roots and short texts are parsed on the calling thread.
+ */
+int lept_parse_parallel(lept_value* v, const char* json, size_t len, unsigned threads);
+
+/*
+ * Read-only mapping of a whole file, read sequentially. Values parsed from json with LEPT_PARSE_ZERO_COPY_FLAG
+ * reference the mapping, so free them before lept_file_unmap(). lept_parse_file() maps, parses and unmaps, and
+ * always copies strings.
+ */
+typedef struct {
+    const char* json;
+    size_t len;
+}lept_file;
+
+int lept_file_map(lept_file* f, const char* path);
+void lept_file_unmap(lept_file* f);
+int lept_parse_file(lept_value* v, const char* path, unsigned flags);
+
+/*
+ * Document that owns the strings, keys, elements and members of its root: the parse takes them from a few blocks
+ * that grow geometrically, and lept_document_free() releases the blocks without walking the tree. The values may
+ * be read and changed in place, but none of them may outlive the document. Storage a value is given by a change
+ * after the parse is its own, lept_free() that value to release it. Parsing again reuses the newest block.
+ */
+typedef struct {
+    lept_value root;
+    void* blocks;       /* newest first */
+    char* next, * end;  /* room left in the newest block */
+}lept_document;
+
+void lept_document_init(lept_document* d);
+int lept_document_parse(lept_document* d, const char* json, size_t len, unsigned flags);
+void lept_document_free(lept_document* d);
+
+char*lept_stringify(const lept_value* v, size_t* length);
 
 void lept_copy(lept_value* dst, const lept_value* src);
 void lept_move(lept_value* dst, lept_value* src);
@@ -61,9 +234,18 @@ int lept_is_equal(const lept_value* lhs, const lept_value* rhs);
 int lept_get_boolean(const lept_value* v);
 void lept_set_boolean(lept_value* v, int b);
 
-double lept_get_number(const lept_value* v);
+/* Numbers without fraction or exponent that fit in 64 bits are parsed as LEPT_INTEGER */
+double lept_get_number(const lept_value* v); /* LEPT_NUMBER or LEPT_INTEGER */
 void lept_set_number(lept_value* v, double n);
 
+int lept_is_int64(const lept_value* v);
+int lept_is_uint64(const lept_value* v);
+int64_t lept_get_integer(const lept_value* v);
+void lept_set_integer(lept_value* v, int64_t i);
+uint64_t lept_get_uint64(const lept_value* v);
+void lept_set_uint64(lept_value* v, uint64_t u);
+
+/* Short strings are kept inside the value, so what lept_get_string() returns moves with v */
 const char* lept_get_string(const lept_value* v);
 size_t lept_get_string_length(const lept_value* v);
 void lept_set_string(lept_value* v, const char* s, size_t len);
@@ -86,6 +268,11 @@ size_t lept_get_object_capacity(const lept_value* v);
 void lept_reserve_object(lept_value* v, size_t capacity);
 void lept_shrink_object(lept_value* v);
 void lept_clear_object(lept_value* v);
+/*
+ * The parsers intern object keys: equal keys of one document share one buffer, so a key taken from one record with
+ * lept_get_object_key() finds its member in the others by pointer. The sharing is counted without atomics, so the
+ * parts of one document must not be freed from several threads at once.
+ */
 const char* lept_get_object_key(const lept_value* v, size_t index);
 size_t lept_get_object_key_length(const lept_value* v, size_t index);
 lept_value* lept_get_object_value(lept_value* v, size_t index);
@@ -94,4 +281,63 @@ lept_value* lept_find_object_value(lept_value* v, const char* key, size_t klen);
 lept_value* lept_set_object_value(lept_value* v, const char* key, size_t klen);
 void lept_remove_object_value(lept_value* v, size_t index);
 
+/*
+ * Flat document: the whole parse result in one block of tagged 64-bit words followed by the string buffer.
+ * Values are addressed by word index, the root is at 0. Containers record where they end, so
+ * lept_tape_skip() steps over any subtree in O(1).
+ */
+typedef struct {
+    uint64_t* w;        /* words, also the start of the allocation */
+    const char* s;      /* null-terminated strings, stored right after the words */
+    size_t size;        /* number of words */
+}lept_tape;
+
+int lept_parse_tape(lept_tape* t, const char* json, size_t len);
+void lept_tape_free(lept_tape* t);
+
+lept_type lept_tape_get_type(const lept_tape* t, size_t i);
+size_t lept_tape_skip(const lept_tape* t, size_t i);
+int lept_tape_get_boolean(const lept_tape* t, size_t i);
+double lept_tape_get_number(const lept_tape* t, size_t i);
+int lept_tape_is_int64(const lept_tape* t, size_t i);
+int lept_tape_is_uint64(const lept_tape* t, size_t i);
+int64_t lept_tape_get_integer(const lept_tape* t, size_t i);
+uint64_t lept_tape_get_uint64(const lept_tape* t, size_t i);
+const char* lept_tape_get_string(const lept_tape* t, size_t i);
+size_t lept_tape_get_string_length(const lept_tape* t, size_t i);
+size_t lept_tape_get_array_size(const lept_tape* t, size_t i);
+size_t lept_tape_get_array_element(const lept_tape* t, size_t i, size_t index);
+size_t lept_tape_get_object_size(const lept_tape* t, size_t i);
+const char* lept_tape_get_object_key(const lept_tape* t, size_t i, size_t index);
+size_t lept_tape_get_object_key_length(const lept_tape* t, size_t i, size_t index);
+size_t lept_tape_get_object_value(const lept_tape* t, size_t i, size_t index);
+size_t lept_tape_find_object_value(const lept_tape* t, size_t i, const char* key, size_t klen); /* LEPT_KEY_NOT_EXIST if absent */
+
+/*
+ * Forward-only cursor over the raw text, nothing is materialized unless asked for. The cursor starts on the root
+ * value. lept_cursor_enter() steps into the array or object it is on and returns the depth that identifies that
+ * container in lept_cursor_next_element() and lept_cursor_find_field(), which move the cursor onto a value.
+ * Fields are searched from the current position on, so look them up in document order. Values not read are
+ * skipped by a quote and bracket aware scanner and are not validated, though the whole text is checked to be UTF-8
+ * by lept_cursor_init(). Once error is set every call fails.
+ */
+typedef struct {
+    const char* json;   /* next token */
+    const char* end;
+    size_t depth;       /* containers entered and not left */
+    int pending;        /* json is at a value that has not been read or skipped */
+    int open;           /* the innermost container was just entered */
+    int error;          /* first parse error, sticky */
+}lept_cursor;
+
+void lept_cursor_init(lept_cursor* cur, const char* json, size_t len);
+lept_type lept_cursor_get_type(const lept_cursor* cur); /* LEPT_NUMBER for any number */
+int lept_cursor_skip(lept_cursor* cur);
+int lept_cursor_get_value(lept_cursor* cur, lept_value* v);
+int lept_cursor_get_boolean(lept_cursor* cur, int* b);
+int lept_cursor_get_number(lept_cursor* cur, double* n);
+int lept_cursor_enter(lept_cursor* cur, size_t* depth);
+int lept_cursor_next_element(lept_cursor* cur, size_t array);   /* 1 if on the next element, 0 at the end or on error */
+int lept_cursor_find_field(lept_cursor* cur, size_t object, const char* key, size_t klen); /* 1 if on the value */
+
 #endif /* LEPTJSON_H__ */
@@ -62,6 +62,33 @@ static void test_parse_false() {
     lept_free(&v);
 }
 
+static void test_parse_whitespace() {
+    static const char ws[] = " \t\n\r";
+    char buf[256];
+    size_t offset, n, i;
+    /* whitespace runs of every length at every alignment, so that SIMD blocks and scalar tails are both hit */
+    for (offset = 0; offset < 32; offset++)
+        for (n = 0; n < 72; n++) {
+            lept_value v;
+            char* p = buf + offset;
+            for (i = 0; i < n; i++)
+                p[i] = ws[i % 4];
+            memcpy(p + n, "null", 4);
+            for (i = 0; i < n; i++)
+                p[n + 4 + i] = ws[(i + 1) % 4];
+            p[n * 2 + 4] = '\0';
+            lept_init(&v);
+            EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, p));
+            EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+            p[n * 2 + 4] = 'x';
+            p[n * 2 + 5] = '\0';
+            EXPECT_EQ_INT(LEPT_PARSE_ROOT_NOT_SINGULAR, lept_parse(&v, p));
+            p[n] = '\0';
+            EXPECT_EQ_INT(LEPT_PARSE_EXPECT_VALUE, lept_parse(&v, p));
+            lept_free(&v);
+        }
+}
+
 #define TEST_NUMBER(expect, json)\
     do {\
         lept_value v;\
@@ -73,11 +100,8 @@ static void test_parse_false() {
     } while(0)
 
 static void test_parse_number() {
-    TEST_NUMBER(0.0, "0");
     TEST_NUMBER(0.0, "-0");
     TEST_NUMBER(0.0, "-0.0");
-    TEST_NUMBER(1.0, "1");
-    TEST_NUMBER(-1.0, "-1");
     TEST_NUMBER(1.5, "1.5");
     TEST_NUMBER(-1.5, "-1.5");
     TEST_NUMBER(3.1416, "3.1416");
@@ -102,6 +126,60 @@ static void test_parse_number() {
     TEST_NUMBER(-2.2250738585072014e-308, "-2.2250738585072014e-308");
     TEST_NUMBER( 1.7976931348623157e+308, "1.7976931348623157e+308");  /* Max double */
     TEST_NUMBER(-1.7976931348623157e+308, "-1.7976931348623157e+308");
+
+    TEST_NUMBER(9007199254740992.0, "9007199254740993e0"); /* halfway between two doubles, round to even */
+    TEST_NUMBER(9007199254740996.0, "9007199254740995e0");
+    TEST_NUMBER(1e23, "1e23");
+    TEST_NUMBER(12345678.87654321, "12345678.87654321");  /* 8-digit blocks */
+    TEST_NUMBER(1.2345678901234568e+29, "123456789012345678901234567890"); /* more than 19 digits */
+    TEST_NUMBER(1.2345678901234567, "1.23456789012345678901234567890");
+    TEST_NUMBER(1e-7, "0.0000001000000000000000000000000000");
+    TEST_NUMBER(0.0, "0.000000000000000000000000000000000000");
+    TEST_NUMBER(1.0, "0.1e1");
+}
+
+#define TEST_INTEGER(expect, json)\
+    do {\
+        lept_value v;\
+        lept_init(&v);\
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));\
+        EXPECT_EQ_INT(LEPT_INTEGER, lept_get_type(&v));\
+        EXPECT_TRUE(lept_get_integer(&v) == (expect));\
+        lept_free(&v);\
+    } while(0)
+
+static void test_parse_integer() {
+    lept_value v;
+
+    TEST_INTEGER(0, "0");
+    TEST_INTEGER(1, "1");
+    TEST_INTEGER(-1, "-1");
+    TEST_INTEGER(1234567890, "1234567890");
+    TEST_INTEGER(INT64_C(9007199254740993), "9007199254740993"); /* not representable as double */
+    TEST_INTEGER(INT64_MAX, "9223372036854775807");
+    TEST_INTEGER(INT64_MIN, "-9223372036854775808");
+
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "9223372036854775808"));
+    EXPECT_EQ_INT(LEPT_INTEGER, lept_get_type(&v));
+    EXPECT_FALSE(lept_is_int64(&v));
+    EXPECT_TRUE(lept_get_uint64(&v) == UINT64_C(9223372036854775808));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "18446744073709551615"));
+    EXPECT_EQ_INT(LEPT_INTEGER, lept_get_type(&v));
+    EXPECT_TRUE(lept_get_uint64(&v) == UINT64_C(18446744073709551615));
+    EXPECT_EQ_DOUBLE(18446744073709551615.0, lept_get_number(&v));
+
+    /* out of range or not an integer literal */
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "18446744073709551616"));
+    EXPECT_EQ_INT(LEPT_NUMBER, lept_get_type(&v));
+    EXPECT_EQ_DOUBLE(18446744073709551616.0, lept_get_number(&v));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "-9223372036854775809"));
+    EXPECT_EQ_INT(LEPT_NUMBER, lept_get_type(&v));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "1.0"));
+    EXPECT_EQ_INT(LEPT_NUMBER, lept_get_type(&v));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "1e2"));
+    EXPECT_EQ_INT(LEPT_NUMBER, lept_get_type(&v));
+    lept_free(&v);
 }
 
 #define TEST_STRING(expect, json)\
@@ -127,6 +205,298 @@ static void test_parse_string() {
     TEST_STRING("\xF0\x9D\x84\x9E", "\"\\ud834\\udd1e\"");  /* G clef sign U+1D11E */
 }
 
+static void test_parse_string_long() {
+    char json[160], expect[160];
+    size_t n, k, i;
+    /* strings of every length, with an escape or an invalid character at every position of the SIMD blocks */
+    for (n = 1; n < 100; n++)
+        for (k = 0; k < n; k++) {
+            lept_value v;
+            json[0] = '"';
+            for (i = 0; i < n; i++)
+                json[i + 1] = expect[i] = (char)('a' + i % 26);
+            json[n + 1] = '"';
+            json[n + 2] = '\0';
+            lept_init(&v);
+            EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+            EXPECT_EQ_SIZE_T(n, lept_get_string_length(&v));
+            EXPECT_TRUE(memcmp(expect, lept_get_string(&v), n) == 0);
+            lept_free(&v);
+
+            json[k + 1] = '\x01';
+            EXPECT_EQ_INT(LEPT_PARSE_INVALID_STRING_CHAR, lept_parse(&v, json));
+            json[k + 1] = '\0';
+            EXPECT_EQ_INT(LEPT_PARSE_MISS_QUOTATION_MARK, lept_parse(&v, json));
+
+            /* replace character k with "\n" */
+            for (i = n; i > k; i--)
+                json[i + 2] = json[i + 1];
+            json[k + 1] = '\\';
+            json[k + 2] = 'n';
+            json[n + 2] = '"';
+            json[n + 3] = '\0';
+            expect[k] = '\n';
+            EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+            EXPECT_EQ_SIZE_T(n, lept_get_string_length(&v));
+            EXPECT_TRUE(memcmp(expect, lept_get_string(&v), n) == 0);
+            lept_free(&v);
+        }
+}
+
+static void test_parse_zero_copy() {
+    static const char json[] = "[ \"abc\", \"a\\nb\", \"\", { \"k\" : \"value\" } ]";
+    lept_value v, copy;
+    lept_value* e;
+
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_ex(&v, json, sizeof(json) - 1, LEPT_PARSE_ZERO_COPY_FLAG));
+    EXPECT_EQ_SIZE_T(4, lept_get_array_size(&v));
+
+    e = lept_get_array_element(&v, 0);
+    EXPECT_TRUE(lept_get_string(e) == json + 3);
+    EXPECT_EQ_SIZE_T(3, lept_get_string_length(e));
+
+    /* escaped strings are still decoded into their own buffer */
+    e = lept_get_array_element(&v, 1);
+    EXPECT_EQ_STRING("a\nb", lept_get_string(e), lept_get_string_length(e));
+
+    e = lept_get_array_element(&v, 2);
+    EXPECT_EQ_SIZE_T(0, lept_get_string_length(e));
+
+    e = lept_find_object_value(lept_get_array_element(&v, 3), "k", 1);
+    EXPECT_TRUE(e != NULL && lept_get_string(e) > json && lept_get_string(e) < json + sizeof(json));
+    EXPECT_TRUE(memcmp("value", lept_get_string(e), lept_get_string_length(e)) == 0);
+
+    /* a copy owns its string */
+    lept_init(&copy);
+    lept_copy(&copy, lept_get_array_element(&v, 0));
+    EXPECT_EQ_STRING("abc", lept_get_string(&copy), lept_get_string_length(&copy));
+    EXPECT_TRUE(lept_is_equal(&copy, lept_get_array_element(&v, 0)));
+    lept_free(&copy);
+
+    lept_free(&v);
+}
+
+#define TEST_PARSE_N(error, json, len)\
+    do {\
+        lept_value v;\
+        lept_init(&v);\
+        EXPECT_EQ_INT(error, lept_parse_n(&v, json, len));\
+        lept_free(&v);\
+    } while(0)
+
+static void test_parse_length() {
+    static const char* const docs[] = {
+        "[ null , false , true , 123 , 4.5e-6 , \"abc\\n\\uD834\\uDD1E\" ]",
+        "{ \"a\" : [ 1234567890123456 , { } ] , \"b\" : \"                  \" }"
+    };
+    lept_value v;
+    size_t i, k;
+
+    /* only the first len bytes count */
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_n(&v, "[1,2]xyz", 5));
+    EXPECT_EQ_SIZE_T(2, lept_get_array_size(&v));
+    lept_free(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_n(&v, "123456789", 3));
+    EXPECT_TRUE(lept_get_integer(&v) == 123);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_n(&v, "\"abc\"def\"", 5));
+    EXPECT_EQ_STRING("abc", lept_get_string(&v), lept_get_string_length(&v));
+    lept_free(&v);
+    TEST_PARSE_N(LEPT_PARSE_OK, "truex", 4);
+    TEST_PARSE_N(LEPT_PARSE_INVALID_VALUE, "true", 3);
+    TEST_PARSE_N(LEPT_PARSE_INVALID_VALUE, "1.5", 2);
+    TEST_PARSE_N(LEPT_PARSE_INVALID_VALUE, "1e5", 2);
+    TEST_PARSE_N(LEPT_PARSE_MISS_QUOTATION_MARK, "\"abc\"", 4);
+    TEST_PARSE_N(LEPT_PARSE_MISS_QUOTATION_MARK, "\"\\n\"", 2);
+    TEST_PARSE_N(LEPT_PARSE_INVALID_UNICODE_HEX, "\"\\u1234\"", 6);
+    TEST_PARSE_N(LEPT_PARSE_INVALID_UNICODE_SURROGATE, "\"\\uD834\\uDD1E\"", 8);
+    TEST_PARSE_N(LEPT_PARSE_EXPECT_VALUE, " x", 1);
+
+    /* embedded '\0' */
+    TEST_PARSE_N(LEPT_PARSE_ROOT_NOT_SINGULAR, "null\0", 5);
+    TEST_PARSE_N(LEPT_PARSE_ROOT_NOT_SINGULAR, "\"abc\"\0", 6);
+    TEST_PARSE_N(LEPT_PARSE_INVALID_VALUE, "\0", 1);
+    TEST_PARSE_N(LEPT_PARSE_INVALID_VALUE, "[1,\0]", 5);
+    TEST_PARSE_N(LEPT_PARSE_INVALID_STRING_CHAR, "\"a\0b\"", 5);
+    TEST_PARSE_N(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, "[1\0]", 4);
+
+    /* every proper prefix of a container is an error, and is read from an exact-size buffer */
+    for (i = 0; i < sizeof(docs) / sizeof(docs[0]); i++) {
+        size_t n = strlen(docs[i]);
+        for (k = 0; k <= n; k++) {
+            char* buf = (char*)malloc(k > 0 ? k : 1);
+            int ret;
+            memcpy(buf, docs[i], k);
+            lept_init(&v);
+            ret = lept_parse_n(&v, buf, k);
+            if (k == n)
+                EXPECT_EQ_INT(LEPT_PARSE_OK, ret);
+            else if (k == 0)
+                EXPECT_EQ_INT(LEPT_PARSE_EXPECT_VALUE, ret);
+            else
+                EXPECT_TRUE(ret != LEPT_PARSE_OK);
+            lept_free(&v);
+            free(buf);
+        }
+    }
+}
+
+static void test_parse_structural() {
+    static const char* const docs[] = {
+        "null", " true ", "-1.5e3", "\"abc\"", "[]", "{}", "[ 1 , [ 2 , [ ] ] , { } ]",
+        "{ \"a\" : [ 1 , \"x\\\"]\" ] , \"b\\\\\" : { \"c\" : null } }",
+        "[\"\\\\\\\"\", \"\\\\\\\\\", \"\\u00e9,:[]{}\"]",
+        "", " ", "nul", "1x", "[1x]", "[1 2]", "[1,]", "[\"a\" \"b\"]", "{\"a\" 1}", "{1:1}",
+        "{\"a\":1 \"b\":2}", "[1", "{\"a\"", "\"abc", "\\\"", "[\\\"]", "[1]x", "null null", "[\"\\x\"]"
+    };
+    char buf[256];
+    size_t i, k, n;
+    for (i = 0; i < sizeof(docs) / sizeof(docs[0]); i++) {
+        /* shift every document across a 64-byte block boundary of the index */
+        for (k = 0; k < 72; k++) {
+            lept_value v1, v2;
+            n = strlen(docs[i]);
+            memset(buf, ' ', k);
+            memcpy(buf + k, docs[i], n);
+            lept_init(&v1);
+            lept_init(&v2);
+            EXPECT_EQ_INT(lept_parse_n(&v1, buf, k + n), lept_parse_ex(&v2, buf, k + n, LEPT_PARSE_STRUCTURAL_FLAG));
+            EXPECT_TRUE(lept_is_equal(&v1, &v2));
+            lept_free(&v1);
+            lept_free(&v2);
+        }
+    }
+}
+
+static int tape_equal(const lept_tape* t, size_t i, const lept_value* v) {
+    size_t k, e;
+    if (lept_tape_get_type(t, i) != lept_get_type(v))
+        return 0;
+    switch (lept_get_type(v)) {
+        case LEPT_TRUE:
+        case LEPT_FALSE:
+            return lept_tape_get_boolean(t, i) == lept_get_boolean(v);
+        case LEPT_NUMBER:
+            return lept_tape_get_number(t, i) == lept_get_number(v);
+        case LEPT_INTEGER:
+            return lept_tape_is_int64(t, i) ? lept_tape_get_integer(t, i) == lept_get_integer(v) : lept_tape_get_uint64(t, i) == lept_get_uint64(v);
+        case LEPT_STRING:
+            return lept_tape_get_string_length(t, i) == lept_get_string_length(v) &&
+                memcmp(lept_tape_get_string(t, i), lept_get_string(v), lept_get_string_length(v)) == 0 &&
+                lept_tape_get_string(t, i)[lept_get_string_length(v)] == '\0';
+        case LEPT_ARRAY:
+            if (lept_tape_get_array_size(t, i) != lept_get_array_size(v))
+                return 0;
+            for (k = 0, e = i + 2; k < lept_get_array_size(v); k++, e = lept_tape_skip(t, e))
+                if (e != lept_tape_get_array_element(t, i, k) || !tape_equal(t, e, lept_get_array_element((lept_value*)v, k)))
+                    return 0;
+            return e == lept_tape_skip(t, i);
+        case LEPT_OBJECT:
+            if (lept_tape_get_object_size(t, i) != lept_get_object_size(v))
+                return 0;
+            for (k = 0; k < lept_get_object_size(v); k++)
+                if (lept_tape_get_object_key_length(t, i, k) != lept_get_object_key_length(v, k) ||
+                    memcmp(lept_tape_get_object_key(t, i, k), lept_get_object_key(v, k), lept_get_object_key_length(v, k)) != 0 ||
+                    !tape_equal(t, lept_tape_get_object_value(t, i, k), lept_get_object_value((lept_value*)v, k)))
+                    return 0;
+            return 1;
+        default:
+            return 1;
+    }
+}
+
+static void test_parse_tape() {
+    static const char json[] = "{ \"n\" : null , \"f\" : false , \"t\" : true , \"i\" : 123 , \"u\" : 18446744073709551615 , "
+        "\"d\" : -1.5e3 , \"s\" : \"a\\u0000b\" , \"a\" : [ 1 , [ ] , { \"x\" : [ \"y\" ] } , \"z\" ] , \"o\" : { } }";
+    static const char* const errors[] = {
+        "", "nul", "[1,]", "[1 2]", "{1:1}", "{\"a\" 1}", "{\"a\":1 \"b\":2}", "\"abc", "[\"\\x\"]", "1e309", "null x", "[1"
+    };
+    lept_tape t;
+    lept_value v;
+    size_t i, a;
+
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_tape(&t, json, sizeof(json) - 1));
+    EXPECT_EQ_INT(LEPT_OBJECT, lept_tape_get_type(&t, 0));
+    EXPECT_EQ_SIZE_T(t.size, lept_tape_skip(&t, 0));
+    EXPECT_EQ_SIZE_T(9, lept_tape_get_object_size(&t, 0));
+    EXPECT_EQ_SIZE_T(LEPT_KEY_NOT_EXIST, lept_tape_find_object_value(&t, 0, "x", 1));
+    EXPECT_TRUE(lept_tape_get_uint64(&t, lept_tape_find_object_value(&t, 0, "u", 1)) == UINT64_C(18446744073709551615));
+    i = lept_tape_find_object_value(&t, 0, "s", 1);
+    EXPECT_EQ_STRING("a\0b", lept_tape_get_string(&t, i), lept_tape_get_string_length(&t, i));
+    a = lept_tape_find_object_value(&t, 0, "a", 1);
+    EXPECT_EQ_SIZE_T(4, lept_tape_get_array_size(&t, a));
+    i = lept_tape_get_array_element(&t, a, 3);
+    EXPECT_EQ_STRING("z", lept_tape_get_string(&t, i), lept_tape_get_string_length(&t, i));
+    i = lept_tape_find_object_value(&t, lept_tape_get_array_element(&t, a, 2), "x", 1);
+    EXPECT_EQ_INT(LEPT_ARRAY, lept_tape_get_type(&t, i));
+
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+    EXPECT_TRUE(tape_equal(&t, 0, &v));
+    lept_free(&v);
+    lept_tape_free(&t);
+
+    /* same error codes as lept_parse() */
+    for (i = 0; i < sizeof(errors) / sizeof(errors[0]); i++) {
+        lept_init(&v);
+        EXPECT_EQ_INT(lept_parse(&v, errors[i]), lept_parse_tape(&t, errors[i], strlen(errors[i])));
+        EXPECT_TRUE(t.w == NULL);
+        lept_free(&v);
+    }
+}
+
+static void test_parse_insitu() {
+    static const char json[] = "{ \"k\\ney\" : [ \"abc\" , \"a\\\\b\\/c\\u00A2\\uD834\\uDD1E\" , \"\" , 1 ] , \"\" : { \"x\" : \"y\" } }";
+    static const char* const errors[] = {
+        "\"abc", "\"\\x\"", "\"\\u12\"", "\"\\uD800\"", "\"\\uD800\\u0041\"", "\"a\x01\"", "[\"a\" 1]", "{\"a\" 1}", "{\"a\":\"b\\q\"}"
+    };
+    char buf[sizeof(json)];
+    lept_value v, v2, *e;
+    size_t i;
+
+    memcpy(buf, json, sizeof(json));
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_insitu(&v, buf, sizeof(json) - 1));
+    lept_init(&v2);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v2, json));
+    EXPECT_TRUE(lept_is_equal(&v, &v2));
+    lept_free(&v2);
+
+    /* keys and strings are null-terminated inside buf */
+    EXPECT_EQ_STRING("k\ney", lept_get_object_key(&v, 0), lept_get_object_key_length(&v, 0));
+    EXPECT_TRUE(lept_get_object_key(&v, 0) == buf + 3);
+    EXPECT_TRUE(lept_get_object_key(&v, 0)[4] == '\0');
+    e = lept_get_object_value(&v, 0);
+    for (i = 0; i < 3; i++) {
+        lept_value* s = lept_get_array_element(e, i);
+        EXPECT_TRUE(lept_get_string(s) > buf && lept_get_string(s) < buf + sizeof(buf));
+        EXPECT_TRUE(lept_get_string(s)[lept_get_string_length(s)] == '\0');
+    }
+    e = lept_get_array_element(e, 1);
+    EXPECT_EQ_STRING("a\\b/c\xC2\xA2\xF0\x9D\x84\x9E", lept_get_string(e), lept_get_string_length(e));
+    e = lept_get_object_value(&v, 1);
+    EXPECT_TRUE(lept_get_object_key(e, 0) > buf && lept_get_object_key(e, 0) < buf + sizeof(buf));
+
+    /* a copy owns its string */
+    lept_init(&v2);
+    lept_copy(&v2, lept_get_object_value(e, 0));
+    lept_free(&v);
+    EXPECT_EQ_STRING("y", lept_get_string(&v2), lept_get_string_length(&v2));
+    lept_free(&v2);
+
+    /* same error codes as lept_parse() */
+    for (i = 0; i < sizeof(errors) / sizeof(errors[0]); i++) {
+        size_t n = strlen(errors[i]);
+        memcpy(buf, errors[i], n);
+        lept_init(&v);
+        lept_init(&v2);
+        EXPECT_EQ_INT(lept_parse(&v2, errors[i]), lept_parse_insitu(&v, buf, n));
+        lept_free(&v);
+        lept_free(&v2);
+    }
+}
+
 static void test_parse_array() {
     size_t i, j;
     lept_value v;
@@ -144,7 +514,7 @@ static void test_parse_array() {
     EXPECT_EQ_INT(LEPT_NULL,   lept_get_type(lept_get_array_element(&v, 0)));
     EXPECT_EQ_INT(LEPT_FALSE,  lept_get_type(lept_get_array_element(&v, 1)));
     EXPECT_EQ_INT(LEPT_TRUE,   lept_get_type(lept_get_array_element(&v, 2)));
-    EXPECT_EQ_INT(LEPT_NUMBER, lept_get_type(lept_get_array_element(&v, 3)));
+    EXPECT_EQ_INT(LEPT_INTEGER, lept_get_type(lept_get_array_element(&v, 3)));
     EXPECT_EQ_INT(LEPT_STRING, lept_get_type(lept_get_array_element(&v, 4)));
     EXPECT_EQ_DOUBLE(123.0, lept_get_number(lept_get_array_element(&v, 3)));
     EXPECT_EQ_STRING("abc", lept_get_string(lept_get_array_element(&v, 4)), lept_get_string_length(lept_get_array_element(&v, 4)));
@@ -160,7 +530,7 @@ static void test_parse_array() {
         EXPECT_EQ_SIZE_T(i, lept_get_array_size(a));
         for (j = 0; j < i; j++) {
             lept_value* e = lept_get_array_element(a, j);
-            EXPECT_EQ_INT(LEPT_NUMBER, lept_get_type(e));
+            EXPECT_EQ_INT(LEPT_INTEGER, lept_get_type(e));
             EXPECT_EQ_DOUBLE((double)j, lept_get_number(e));
         }
     }
@@ -198,7 +568,7 @@ static void test_parse_object() {
     EXPECT_EQ_STRING("t", lept_get_object_key(&v, 2), lept_get_object_key_length(&v, 2));
     EXPECT_EQ_INT(LEPT_TRUE,   lept_get_type(lept_get_object_value(&v, 2)));
     EXPECT_EQ_STRING("i", lept_get_object_key(&v, 3), lept_get_object_key_length(&v, 3));
-    EXPECT_EQ_INT(LEPT_NUMBER, lept_get_type(lept_get_object_value(&v, 3)));
+    EXPECT_EQ_INT(LEPT_INTEGER, lept_get_type(lept_get_object_value(&v, 3)));
     EXPECT_EQ_DOUBLE(123.0, lept_get_number(lept_get_object_value(&v, 3)));
     EXPECT_EQ_STRING("s", lept_get_object_key(&v, 4), lept_get_object_key_length(&v, 4));
     EXPECT_EQ_INT(LEPT_STRING, lept_get_type(lept_get_object_value(&v, 4)));
@@ -208,7 +578,7 @@ static void test_parse_object() {
     EXPECT_EQ_SIZE_T(3, lept_get_array_size(lept_get_object_value(&v, 5)));
     for (i = 0; i < 3; i++) {
         lept_value* e = lept_get_array_element(lept_get_object_value(&v, 5), i);
-        EXPECT_EQ_INT(LEPT_NUMBER, lept_get_type(e));
+        EXPECT_EQ_INT(LEPT_INTEGER, lept_get_type(e));
         EXPECT_EQ_DOUBLE(i + 1.0, lept_get_number(e));
     }
     EXPECT_EQ_STRING("o", lept_get_object_key(&v, 6), lept_get_object_key_length(&v, 6));
@@ -219,7 +589,7 @@ static void test_parse_object() {
             lept_value* ov = lept_get_object_value(o, i);
             EXPECT_TRUE('1' + i == lept_get_object_key(o, i)[0]);
             EXPECT_EQ_SIZE_T(1, lept_get_object_key_length(o, i));
-            EXPECT_EQ_INT(LEPT_NUMBER, lept_get_type(ov));
+            EXPECT_EQ_INT(LEPT_INTEGER, lept_get_type(ov));
             EXPECT_EQ_DOUBLE(i + 1.0, lept_get_number(ov));
         }
     }
@@ -233,6 +603,7 @@ static void test_parse_object() {
         v.type = LEPT_FALSE;\
         EXPECT_EQ_INT(error, lept_parse(&v, json));\
         EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));\
+        EXPECT_EQ_INT(error, lept_validate(json, strlen(json)));\
         lept_free(&v);\
     } while(0)
 
@@ -244,6 +615,11 @@ static void test_parse_expect_value() {
 static void test_parse_invalid_value() {
     TEST_PARSE_ERROR(LEPT_PARSE_INVALID_VALUE, "nul");
     TEST_PARSE_ERROR(LEPT_PARSE_INVALID_VALUE, "?");
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_VALUE, "tru");
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_VALUE, "trUe");
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_VALUE, "fals");
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_VALUE, "falsE");
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_VALUE, "nulL");
 
     /* invalid number */
     TEST_PARSE_ERROR(LEPT_PARSE_INVALID_VALUE, "+0");
@@ -308,11 +684,41 @@ static void test_parse_invalid_unicode_hex() {
 }
 
 static void test_parse_invalid_unicode_surrogate() {
+    static const char lone[] = "[\"ab\\uDC00\"]";
+    static const lept_handler h = { NULL };
+    char buf[sizeof(lone)];
+    size_t i, root;
+    lept_value v;
+    lept_tape t;
+    lept_push p;
+    lept_cursor cur;
     TEST_PARSE_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE, "\"\\uD800\"");
     TEST_PARSE_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE, "\"\\uDBFF\"");
     TEST_PARSE_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE, "\"\\uD800\\\\\"");
     TEST_PARSE_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE, "\"\\uD800\\uDBFF\"");
     TEST_PARSE_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE, "\"\\uD800\\uE000\"");
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE, "\"\\uDC00\"");
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE, "\"\\uDFFF\"");
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE, "\"\\uDC00\\uD800\"");
+
+    /* a low surrogate on its own, in every engine */
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_UNICODE_SURROGATE, lept_parse_ex(&v, lone, sizeof(lone) - 1, LEPT_PARSE_STRUCTURAL_FLAG));
+    memcpy(buf, lone, sizeof(lone));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_UNICODE_SURROGATE, lept_parse_insitu(&v, buf, sizeof(lone) - 1));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_UNICODE_SURROGATE, lept_parse_sax(lone, sizeof(lone) - 1, &h, NULL));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_UNICODE_SURROGATE, lept_parse_tape(&t, lone, sizeof(lone) - 1));
+    for (i = 1; i < sizeof(lone) - 1; i++) {
+        lept_push_init(&p, NULL, NULL);
+        lept_feed(&p, lone, i);
+        EXPECT_EQ_INT(LEPT_PARSE_INVALID_UNICODE_SURROGATE, lept_feed(&p, lone + i, sizeof(lone) - 1 - i));
+        lept_push_free(&p);
+    }
+    lept_cursor_init(&cur, lone, sizeof(lone) - 1);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_cursor_enter(&cur, &root));
+    EXPECT_TRUE(lept_cursor_next_element(&cur, root));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_UNICODE_SURROGATE, lept_cursor_get_value(&cur, &v));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
 }
 
 static void test_parse_miss_comma_or_square_bracket() {
@@ -345,12 +751,49 @@ static void test_parse_miss_comma_or_curly_bracket() {
     TEST_PARSE_ERROR(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, "{\"a\":{}");
 }
 
+static void test_parse_invalid_utf8() {
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_UTF8, "\"\x80\"");
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_UTF8, "\"\xFF\"");
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_UTF8, "\"\xF5\x80\x80\x80\"");
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_UTF8, "\"\xC2\"");
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_UTF8, "\"\xC2\x41\"");
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_UTF8, "\"\xE2\x82\"");
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_UTF8, "\"\xF0\x9D\x84\"");
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_UTF8, "\"\xE2\x82\xAC\xAC\"");
+
+    /* overlong */
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_UTF8, "\"\xC0\xAF\"");
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_UTF8, "\"\xC1\xBF\"");
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_UTF8, "\"\xE0\x80\xAF\"");
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_UTF8, "\"\xE0\x9F\xBF\"");
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_UTF8, "\"\xF0\x80\x80\xAF\"");
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_UTF8, "\"\xF0\x8F\xBF\xBF\"");
+
+    /* surrogates and code points above U+10FFFF */
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_UTF8, "\"\xED\xA0\x80\"");
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_UTF8, "\"\xED\xBF\xBF\"");
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_UTF8, "\"\xF4\x90\x80\x80\"");
+
+    /* wherever it is, before any syntax error */
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_UTF8, "\xFF");
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_UTF8, "[1,\"\xE0\x80\x80\"");
+    TEST_PARSE_ERROR(LEPT_PARSE_INVALID_UTF8, "? \"\xC0\x80\"");
+}
+
 static void test_parse() {
     test_parse_null();
     test_parse_true();
     test_parse_false();
+    test_parse_whitespace();
     test_parse_number();
+    test_parse_integer();
     test_parse_string();
+    test_parse_string_long();
+    test_parse_zero_copy();
+    test_parse_length();
+    test_parse_structural();
+    test_parse_tape();
+    test_parse_insitu();
     test_parse_array();
     test_parse_object();
 
@@ -367,6 +810,7 @@ static void test_parse() {
     test_parse_miss_key();
     test_parse_miss_colon();
     test_parse_miss_comma_or_curly_bracket();
+    test_parse_invalid_utf8();
 }
 
 #define TEST_ROUNDTRIP(json)\
@@ -387,6 +831,9 @@ static void test_stringify_number() {
     TEST_ROUNDTRIP("-0");
     TEST_ROUNDTRIP("1");
     TEST_ROUNDTRIP("-1");
+    TEST_ROUNDTRIP("9223372036854775807");
+    TEST_ROUNDTRIP("-9223372036854775808");
+    TEST_ROUNDTRIP("18446744073709551615");
     TEST_ROUNDTRIP("1.5");
     TEST_ROUNDTRIP("-1.5");
     TEST_ROUNDTRIP("3.25");
@@ -413,6 +860,23 @@ static void test_stringify_string() {
     TEST_ROUNDTRIP("\"Hello\\u0000World\"");
 }
 
+/* Escapes are written out as UTF-8, which parses back to the same string */
+static void test_stringify_unicode() {
+    static const char json[] = "\"\\u00e9 \\u0800 \\uD7FF \\uE000 \\uFFFF \\uD800\\uDC00 \\uDBFF\\uDFFF\"";
+    lept_value v, v2;
+    char* json2;
+    size_t length;
+    lept_init(&v);
+    lept_init(&v2);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+    json2 = lept_stringify(&v, &length);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_n(&v2, json2, length));
+    EXPECT_TRUE(lept_is_equal(&v, &v2));
+    lept_free(&v);
+    lept_free(&v2);
+    free(json2);
+}
+
 static void test_stringify_array() {
     TEST_ROUNDTRIP("[]");
     TEST_ROUNDTRIP("[null,false,true,123,\"abc\",[1,2,3]]");
@@ -429,6 +893,7 @@ static void test_stringify() {
     TEST_ROUNDTRIP("true");
     test_stringify_number();
     test_stringify_string();
+    test_stringify_unicode();
     test_stringify_array();
     test_stringify_object();
 }
@@ -453,6 +918,14 @@ static void test_equal() {
     TEST_EQUAL("null", "0", 0);
     TEST_EQUAL("123", "123", 1);
     TEST_EQUAL("123", "456", 0);
+    TEST_EQUAL("123", "123.0", 1);
+    TEST_EQUAL("123", "1.23e2", 1);
+    TEST_EQUAL("123", "123.5", 0);
+    TEST_EQUAL("9007199254740993", "9007199254740992.0", 0); /* no rounding through double */
+    TEST_EQUAL("18446744073709551615", "18446744073709551615", 1);
+    TEST_EQUAL("18446744073709551615", "-1", 0);
+    TEST_EQUAL("18446744073709551616.0", "18446744073709551615", 0);
+    TEST_EQUAL("9223372036854775808.0", "9223372036854775808", 1);
     TEST_EQUAL("\"abc\"", "\"abc\"", 1);
     TEST_EQUAL("\"abc\"", "\"abcd\"", 0);
     TEST_EQUAL("[]", "[]", 1);
@@ -539,6 +1012,25 @@ static void test_access_number() {
     lept_free(&v);
 }
 
+static void test_access_integer() {
+    lept_value v;
+    lept_init(&v);
+    lept_set_string(&v, "a", 1);
+    lept_set_integer(&v, -1234);
+    EXPECT_EQ_INT(LEPT_INTEGER, lept_get_type(&v));
+    EXPECT_TRUE(lept_is_int64(&v));
+    EXPECT_FALSE(lept_is_uint64(&v));
+    EXPECT_TRUE(lept_get_integer(&v) == -1234);
+    EXPECT_EQ_DOUBLE(-1234.0, lept_get_number(&v));
+    lept_set_uint64(&v, 1234);
+    EXPECT_TRUE(lept_is_int64(&v) && lept_is_uint64(&v));
+    EXPECT_TRUE(lept_get_integer(&v) == 1234);
+    lept_set_uint64(&v, UINT64_C(18446744073709551615));
+    EXPECT_FALSE(lept_is_int64(&v));
+    EXPECT_TRUE(lept_get_uint64(&v) == UINT64_C(18446744073709551615));
+    lept_free(&v);
+}
+
 static void test_access_string() {
     lept_value v;
     lept_init(&v);
@@ -549,6 +1041,38 @@ static void test_access_string() {
     lept_free(&v);
 }
 
+/* Strings up to 22 bytes (7 with LEPT_COMPACT) on 64-bit are kept in the value, longer ones are allocated */
+static void test_access_short_string() {
+    static const char s[] = "0123456789abcdef\0ghijklmnopqrstuvwxyz";
+    size_t len, max = sizeof(lept_value) == 32 ? 22 : sizeof(lept_value) == 16 ? 7 : 0;
+    lept_value v, w;
+    char json[64];
+    lept_init(&v);
+    lept_init(&w);
+    for (len = 0; len < sizeof(s); len++) {
+        const char* p;
+        lept_set_string(&v, s, len);
+        p = lept_get_string(&v);
+        EXPECT_EQ_SIZE_T(len, lept_get_string_length(&v));
+        EXPECT_TRUE(memcmp(s, p, len) == 0 && p[len] == '\0');
+        if (max > 0)
+            EXPECT_EQ_INT(len <= max, p >= (const char*)&v && p < (const char*)(&v + 1));
+        lept_copy(&w, &v);
+        EXPECT_TRUE(lept_is_equal(&v, &w));
+        lept_move(&v, &w);
+        EXPECT_TRUE(lept_get_string_length(&v) == len && memcmp(s, lept_get_string(&v), len) == 0);
+        if (len < 16) { /* parsed strings, decoded and plain */
+            sprintf(json, "[\"\\u0041%.*s\"]", (int)len, s + 1);
+            EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&w, json));
+            p = lept_get_string(lept_get_array_element(&w, 0));
+            EXPECT_EQ_SIZE_T(len + 1, lept_get_string_length(lept_get_array_element(&w, 0)));
+            EXPECT_TRUE(p[0] == 'A' && memcmp(p + 1, s + 1, len) == 0 && p[len + 1] == '\0');
+            lept_free(&w);
+        }
+    }
+    lept_free(&v);
+}
+
 static void test_access_array() {
     lept_value a, e;
     size_t i, j;
@@ -702,11 +1226,737 @@ static void test_access() {
     test_access_null();
     test_access_boolean();
     test_access_number();
+    test_access_integer();
     test_access_string();
+    test_access_short_string();
     test_access_array();
     test_access_object();
 }
 
+static void test_shared_keys(lept_value* v) {
+    lept_value* a, * b;
+    EXPECT_EQ_INT(LEPT_ARRAY, lept_get_type(v));
+    EXPECT_EQ_SIZE_T(3, lept_get_array_size(v));
+    a = lept_get_array_element(v, 0);
+    b = lept_get_array_element(v, 2);
+    EXPECT_TRUE(lept_get_object_key(a, 0) == lept_get_object_key(lept_get_array_element(v, 1), 0));
+    EXPECT_TRUE(lept_get_object_key(a, 0) == lept_get_object_key(b, 1));
+    EXPECT_TRUE(lept_get_object_key(a, 1) == lept_get_object_key(b, 0));
+    EXPECT_TRUE(lept_get_object_key(a, 2) != lept_get_object_key(b, 2));
+    EXPECT_EQ_SIZE_T(1, lept_find_object_index(b, lept_get_object_key(a, 0), 2));
+    EXPECT_EQ_SIZE_T(0, lept_find_object_index(b, "name", 4));
+    EXPECT_EQ_SIZE_T(2, lept_find_object_index(b, "a\0c", 3));
+    EXPECT_EQ_SIZE_T(LEPT_KEY_NOT_EXIST, lept_find_object_index(b, "a", 1));
+    EXPECT_EQ_SIZE_T(LEPT_KEY_NOT_EXIST, lept_find_object_index(b, lept_get_object_key(a, 2), 1));
+    EXPECT_EQ_SIZE_T(LEPT_KEY_NOT_EXIST, lept_find_object_index(a, lept_get_object_key(a, 1), 3)); /* a prefix of "name" */
+}
+
+static void test_intern_keys() {
+    static const char prefix[] = "{\"abc\":1,\"ab\":2}";
+    static const char json[] =
+        "[{\"id\":1,\"name\":\"x\",\"a\":0},{\"id\":2,\"name\":\"y\"},{\"n\\u0061me\":\"z\",\"id\":3,\"a\\u0000c\":0}]";
+    static const char* const paths[] = { "/0", "/1/id", "/1/name", "/2" };
+    lept_value v;
+    lept_push p;
+    lept_cursor cur;
+
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_n(&v, json, sizeof(json) - 1));
+    test_shared_keys(&v);
+    lept_free(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_ex(&v, json, sizeof(json) - 1, LEPT_PARSE_STRUCTURAL_FLAG));
+    test_shared_keys(&v);
+    lept_free(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_paths(&v, json, sizeof(json) - 1, paths, 4));
+    test_shared_keys(&v);
+    lept_free(&v);
+
+    lept_push_init(&p, NULL, NULL);
+    EXPECT_EQ_INT(LEPT_PARSE_INCOMPLETE, lept_feed(&p, json, 40));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_feed(&p, json + 40, sizeof(json) - 41));
+    lept_push_get_value(&p, &v);
+    lept_push_free(&p);
+    test_shared_keys(&v);
+    lept_free(&v);
+
+    lept_cursor_init(&cur, json, sizeof(json) - 1);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_cursor_get_value(&cur, &v));
+    test_shared_keys(&v);
+    lept_free(&v);
+
+    /* the key pointer of "abc" finds "ab" by its length */
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_n(&v, prefix, sizeof(prefix) - 1));
+    EXPECT_EQ_SIZE_T(1, lept_find_object_index(&v, lept_get_object_key(&v, 0), 2));
+    EXPECT_EQ_SIZE_T(0, lept_find_object_index(&v, lept_get_object_key(&v, 0), 3));
+    lept_free(&v);
+
+    /* shared keys of a document that fails are released */
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, lept_parse_n(&v, json, 45));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, lept_parse_ex(&v, json, 45, LEPT_PARSE_STRUCTURAL_FLAG));
+    lept_push_init(&p, NULL, NULL);
+    EXPECT_EQ_INT(LEPT_PARSE_INCOMPLETE, lept_feed(&p, json, 45));
+    lept_push_free(&p);
+    /* freed inside a value after its key */
+    lept_push_init(&p, NULL, NULL);
+    EXPECT_EQ_INT(LEPT_PARSE_INCOMPLETE, lept_feed(&p, "{\"alpha\":[1,{\"beta\":\"x", 22));
+    lept_push_free(&p);
+}
+
+static void test_cursor() {
+    static const char json[] = "{ \"id\" : 42 , \"skip\" : { \"a\" : [ 1 , \"]}\\\"\" , { } ] } , \"tags\" : [ \"x\" , [ 1 , 2 ] , true ] ,"
+        " \"events\" : [ { \"ts\" : 1.5 , \"n\" : null } , { \"ts\" : 2.5 } , { \"other\" : 0 } ] , \"k\\u0065y\" : false , \"last\" : \"v\" }";
+    lept_cursor cur;
+    lept_value v;
+    size_t root, tags, events, e, nested;
+    double n, sum;
+    int b, count;
+
+    lept_cursor_init(&cur, json, sizeof(json) - 1);
+    EXPECT_EQ_INT(LEPT_OBJECT, lept_cursor_get_type(&cur));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_cursor_enter(&cur, &root));
+    EXPECT_TRUE(lept_cursor_find_field(&cur, root, "id", 2));
+    EXPECT_EQ_INT(LEPT_PARSE_TYPE_MISMATCH, lept_cursor_get_boolean(&cur, &b));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_cursor_get_number(&cur, &n));
+    EXPECT_EQ_DOUBLE(42.0, n);
+
+    /* "skip" is stepped over, then "tags" is left after its first elements */
+    EXPECT_TRUE(lept_cursor_find_field(&cur, root, "tags", 4));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_cursor_enter(&cur, &tags));
+    EXPECT_TRUE(lept_cursor_next_element(&cur, tags));
+    EXPECT_EQ_INT(LEPT_STRING, lept_cursor_get_type(&cur));
+    EXPECT_TRUE(lept_cursor_next_element(&cur, tags));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_cursor_enter(&cur, &nested));
+    EXPECT_TRUE(lept_cursor_next_element(&cur, nested));
+
+    EXPECT_TRUE(lept_cursor_find_field(&cur, root, "events", 6));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_cursor_enter(&cur, &events));
+    count = 0;
+    sum = 0.0;
+    while (lept_cursor_next_element(&cur, events)) {
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_cursor_enter(&cur, &e));
+        if (lept_cursor_find_field(&cur, e, "ts", 2) && lept_cursor_get_number(&cur, &n) == LEPT_PARSE_OK)
+            sum += n;
+        count++;
+    }
+    EXPECT_EQ_INT(3, count);
+    EXPECT_EQ_DOUBLE(4.0, sum);
+
+    /* escaped keys are decoded before comparing */
+    EXPECT_TRUE(lept_cursor_find_field(&cur, root, "key", 3));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_cursor_get_boolean(&cur, &b));
+    EXPECT_FALSE(b);
+    EXPECT_TRUE(lept_cursor_find_field(&cur, root, "last", 4));
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_cursor_get_value(&cur, &v));
+    EXPECT_EQ_STRING("v", lept_get_string(&v), lept_get_string_length(&v));
+    lept_free(&v);
+
+    /* lookups are forward-only */
+    EXPECT_FALSE(lept_cursor_find_field(&cur, root, "id", 2));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, cur.error);
+    EXPECT_EQ_SIZE_T(0, cur.depth);
+
+    /* a subtree is materialized on request */
+    lept_cursor_init(&cur, json, sizeof(json) - 1);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_cursor_enter(&cur, &root));
+    EXPECT_TRUE(lept_cursor_find_field(&cur, root, "skip", 4));
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_cursor_get_value(&cur, &v));
+    EXPECT_EQ_INT(LEPT_OBJECT, lept_get_type(&v));
+    EXPECT_EQ_SIZE_T(3, lept_get_array_size(lept_find_object_value(&v, "a", 1)));
+    lept_free(&v);
+
+    /* errors are sticky */
+    lept_cursor_init(&cur, "[1,2 3]", 7);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_cursor_enter(&cur, &root));
+    EXPECT_TRUE(lept_cursor_next_element(&cur, root));
+    EXPECT_TRUE(lept_cursor_next_element(&cur, root));
+    EXPECT_FALSE(lept_cursor_next_element(&cur, root));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, cur.error);
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, lept_cursor_get_number(&cur, &n));
+    lept_cursor_init(&cur, "{\"a\":\"unterminated}", 19);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_cursor_enter(&cur, &root));
+    EXPECT_FALSE(lept_cursor_find_field(&cur, root, "b", 1));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_QUOTATION_MARK, cur.error);
+    lept_cursor_init(&cur, " ", 1);
+    EXPECT_EQ_INT(LEPT_PARSE_EXPECT_VALUE, cur.error);
+}
+
+typedef struct {
+    char trace[256];
+    size_t len;
+    int stop_at;    /* event number that returns 0, -1 for none */
+}sax_recorder;
+
+static int sax_record(void* user, const char* event, const char* s, size_t len) {
+    sax_recorder* r = (sax_recorder*)user;
+    r->len += sprintf(r->trace + r->len, "%s", event);
+    memcpy(r->trace + r->len, s, len);
+    r->len += len;
+    r->trace[r->len++] = ' ';
+    r->trace[r->len] = '\0';
+    return r->stop_at-- != 0;
+}
+
+static int sax_null(void* user) { return sax_record(user, "N", "", 0); }
+static int sax_boolean(void* user, int b) { return sax_record(user, b ? "T" : "F", "", 0); }
+static int sax_integer(void* user, int64_t i) { char b[32]; return sax_record(user, "i", b, sprintf(b, "%ld", (long)i)); }
+static int sax_number(void* user, double n) { char b[32]; return sax_record(user, "d", b, sprintf(b, "%g", n)); }
+static int sax_string(void* user, const char* s, size_t len) { return sax_record(user, "s:", s, len); }
+static int sax_key(void* user, const char* s, size_t len) { return sax_record(user, "k:", s, len); }
+static int sax_start_object(void* user) { return sax_record(user, "{", "", 0); }
+static int sax_end_object(void* user, size_t count) { char b[32]; return sax_record(user, "}", b, sprintf(b, "%d", (int)count)); }
+static int sax_start_array(void* user) { return sax_record(user, "[", "", 0); }
+static int sax_end_array(void* user, size_t count) { char b[32]; return sax_record(user, "]", b, sprintf(b, "%d", (int)count)); }
+
+static void test_skip_value() {
+    static const char* const values[] = {
+        "null", "-1.5e3", "\"a\\\"]\\\\\"", "[]", "{ }", "[1,[2,[3]],\"]\"]", "{\"a\":{\"b\":[\"}\\\\\",\"\\\"{\"]}}"
+    };
+    char json[512];
+    size_t i, k, n;
+    for (i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        n = strlen(values[i]);
+        sprintf(json, " \n%s , 1", values[i]);
+        EXPECT_TRUE(lept_skip_value(json, n + 6) == json + 2 + n);
+        /* cut off: literals and numbers are not validated */
+        EXPECT_TRUE(lept_skip_value(json, n + 1) == (i < 2 ? json + n + 1 : NULL));
+    }
+    EXPECT_TRUE(lept_skip_value("", 0) == NULL);
+    EXPECT_TRUE(lept_skip_value(" ", 1) == NULL);
+    EXPECT_TRUE(lept_skip_value(",1", 2) == NULL);
+
+    /* brackets, quotes and backslashes at every offset of the 64-byte blocks */
+    for (k = 0; k < 130; k++) {
+        json[0] = '[';
+        json[1] = '\"';
+        memset(json + 2, 'a', k);
+        n = 2 + k + (size_t)sprintf(json + 2 + k, "\\\"]\\\\\" , {\"k\":[[\"\\\\\"]]} ]");
+        EXPECT_TRUE(lept_skip_value(json, n) == json + n);
+        EXPECT_TRUE(lept_skip_value(json, n - 1) == NULL);
+        memset(json, '[', k + 1);
+        memset(json + k + 1, ']', k + 1);
+        EXPECT_TRUE(lept_skip_value(json, 2 * k + 2) == json + 2 * k + 2);
+        EXPECT_TRUE(lept_skip_value(json, 2 * k + 1) == NULL);
+    }
+}
+
+/* lept_parse_paths() with the paths separated by spaces gives expect, or the whole document for NULL */
+static void test_paths(const char* expect, const char* json, const char* paths) {
+    const char* p[8];
+    char buf[256], * q;
+    lept_value e, v;
+    size_t n = 0;
+    strcpy(buf, paths);
+    for (q = strtok(buf, " "); q != NULL; q = strtok(NULL, " "))
+        p[n++] = strcmp(q, "''") == 0 ? "" : q;
+    lept_init(&e);
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&e, expect != NULL ? expect : json));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_paths(&v, json, strlen(json), p, n));
+    EXPECT_TRUE(lept_is_equal(&e, &v));
+    lept_free(&e);
+    lept_free(&v);
+}
+
+#define TEST_PATHS_ERROR(error, json)\
+    do {\
+        lept_init(&v);\
+        v.type = LEPT_FALSE;\
+        EXPECT_EQ_INT(error, lept_parse_paths(&v, json, strlen(json), none, 1));\
+        EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));\
+    } while(0)
+
+static void test_parse_paths() {
+    static const char json[] = "{ \"user\" : { \"id\" : 7 , \"name\" : \"x\\\"}\" , \"tags\" : [ 1 , 2 ] } ,"
+        " \"events\" : [ { \"ts\" : 1 , \"x\" : [ 1 , { \"ts\" : 2 } ] } , { \"y\" : \"]\" } , { \"ts\" : 3 } ] ,"
+        " \"a/b\" : 1 , \"m~n\" : 2 , \"k\\u0065y\" : true }";
+    static const char* const none[1] = { "/x" };
+    lept_value v;
+    test_paths("{\"user\":{\"id\":7},\"events\":[{\"ts\":1},{},{\"ts\":3}]}", json, "/user/id /events/*/ts");
+    test_paths("{\"events\":[null,{\"y\":\"]\"},null]}", json, "/events/1");
+    test_paths("{\"user\":{\"id\":7},\"events\":[null,null,null]}", json, "/*/id");
+    test_paths("{\"user\":{\"id\":7,\"name\":\"x\\\"}\",\"tags\":[1,2]}}", json, "/user/id /user /user/id/x");
+    test_paths("{\"user\":{\"tags\":[null,null]}}", json, "/user/id/x /user/tags/-");
+    test_paths("{\"a/b\":1,\"m~n\":2,\"key\":true}", json, "/a~1b /m~0n /key");
+    test_paths("{\"events\":[{\"x\":[null,{\"ts\":2}]},null,null]}", json, "/events/0/x/01 /events/0/x/1/ts /events/00");
+    test_paths(NULL, json, "''");
+    test_paths(NULL, json, "/*");
+    test_paths("{}", json, "/none");
+    test_paths("[null,[3],null]", "[1,[3],2]", "/1");
+    test_paths("null", " 5 ", "/a");
+
+    /* what is skipped is not validated, only the selected values and the containers on the way are */
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_paths(&v, "{\"y\":[1,,tru],\"x\":1}", 20, none, 1));
+    EXPECT_EQ_DOUBLE(1.0, lept_get_number(lept_find_object_value(&v, "x", 1)));
+    lept_free(&v);
+    TEST_PATHS_ERROR(LEPT_PARSE_INVALID_VALUE, "{\"x\":tru}");
+    TEST_PATHS_ERROR(LEPT_PARSE_MISS_KEY, "{\"y\":1,}");
+    TEST_PATHS_ERROR(LEPT_PARSE_MISS_COLON, "{\"y\":1,\"x\" 1}");
+    TEST_PATHS_ERROR(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, "{\"y\":1 \"x\":1}");
+    TEST_PATHS_ERROR(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, "{\"y\":[1,2");
+    TEST_PATHS_ERROR(LEPT_PARSE_MISS_QUOTATION_MARK, "{\"y\":\"1");
+    TEST_PATHS_ERROR(LEPT_PARSE_EXPECT_VALUE, "{\"y\":");
+    TEST_PATHS_ERROR(LEPT_PARSE_ROOT_NOT_SINGULAR, "{\"x\":1} 2");
+    TEST_PATHS_ERROR(LEPT_PARSE_INVALID_UTF8, "{\"y\":\"\xC0\x80\"}");
+}
+
+#define TEST_SAX(error, events, json, stop)\
+    do {\
+        r.len = 0;\
+        r.trace[0] = '\0';\
+        r.stop_at = stop;\
+        EXPECT_EQ_INT(error, lept_parse_sax(json, sizeof(json) - 1, &h, &r));\
+        EXPECT_EQ_STRING(events, r.trace, r.len);\
+    } while(0)
+
+static void test_parse_sax() {
+    lept_handler h = {
+        sax_null, sax_boolean, sax_number, sax_integer, NULL, sax_string,
+        sax_start_object, sax_key, sax_end_object, sax_start_array, sax_end_array
+    };
+    sax_recorder r;
+    TEST_SAX(LEPT_PARSE_OK, "N ", " null ", -1);
+    TEST_SAX(LEPT_PARSE_OK, "[ T F i-7 d1.5 d1.84467e+19 ]5 ", "[ true, false, -7, 1.5, 18446744073709551615 ]", -1);
+    TEST_SAX(LEPT_PARSE_OK, "{ k:a [ ]0 k:b { k:c s:x\"y }1 k:A s:B }3 ",
+        "{ \"a\" : [ ] , \"b\" : { \"c\" : \"x\\\"y\" } , \"\\u0041\" : \"B\" }", -1);
+
+    /* a handler returning 0 stops the parse at once */
+    TEST_SAX(LEPT_PARSE_STOPPED, "[ i1 ", "[ 1, 2, 3 ]", 1);
+    TEST_SAX(LEPT_PARSE_STOPPED, "{ k:a ", "{ \"a\" : 1 }", 1);
+
+    /* errors are those of lept_parse(), after the events before them */
+    TEST_SAX(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, "[ i1 ", "[ 1 2 ]", -1);
+    TEST_SAX(LEPT_PARSE_MISS_COLON, "{ k:a ", "{ \"a\" 1 }", -1);
+    TEST_SAX(LEPT_PARSE_INVALID_STRING_ESCAPE, "[ ", "[ \"\\v\" ]", -1);
+    TEST_SAX(LEPT_PARSE_ROOT_NOT_SINGULAR, "N ", "null x", -1);
+    TEST_SAX(LEPT_PARSE_EXPECT_VALUE, "", "", -1);
+
+    /* NULL callbacks ignore their events */
+    h.integer = NULL;
+    h.start_array = NULL;
+    h.string = NULL;
+    TEST_SAX(LEPT_PARSE_OK, "d1 ]2 ", "[ 1, \"s\" ]", -1);
+}
+
+/* Feeding json in two chunks split anywhere, or byte by byte, gives what lept_parse_n() gives for the whole */
+static void test_push_splits(const char* json) {
+    lept_value expect, v;
+    lept_push p;
+    size_t len = strlen(json), i;
+    int ret, split;
+    lept_init(&expect);
+    ret = lept_parse_n(&expect, json, len);
+    for (split = 0; split <= (int)len + 1; split++) {
+        lept_push_init(&p, NULL, NULL);
+        if (split <= (int)len) {
+            if (split > 0)
+                lept_feed(&p, json, (size_t)split);
+            if ((size_t)split < len)
+                lept_feed(&p, json + split, len - (size_t)split);
+        }
+        else
+            for (i = 0; i < len; i++)
+                lept_feed(&p, json + i, 1);
+        EXPECT_EQ_INT(ret, lept_feed(&p, NULL, 0));
+        if (ret == LEPT_PARSE_OK) {
+            lept_init(&v);
+            lept_push_get_value(&p, &v);
+            EXPECT_TRUE(lept_is_equal(&expect, &v));
+            lept_free(&v);
+        }
+        lept_push_free(&p);
+    }
+    lept_free(&expect);
+}
+
+static void test_parse_push() {
+    static const char* const texts[] = {
+        "null", " true ", "false", "0", "-12.5e-3", "18446744073709551615", "1e309", "01", "-", "1.", "nul", "tx",
+        "\"\"", "\"a\\\"b\\\\c\\/\\b\\f\\n\\r\\t\"", "\"\\u00e9\\u20AC\\uD834\\uDD1E\"", "\"\\uD834x\"", "\"\\uD834\\x\"",
+        "\"\\uD834\\uE000\"", "\"\\u12G4\"", "\"\\v\"", "\"abc", "\"\x01\"",
+        "[]", "[ 1 , [ \"x\" , { } ] , null ]", "[1,]", "[1 2]", "[", "[1", "[1,",
+        "{}", "{ \"a\" : 1 , \"b\" : [ true , { \"c\" : \"d\" } ] }", "{1:1}", "{\"a\" 1}", "{\"a\":1 \"b\":2}", "{\"a\":}",
+        "{", "{\"a\"", "{\"a\":", "{\"a\":1", "{\"a\":1,", "[1] x", "1 2", "",
+        "\"\xC2\xA2\xE2\x82\xAC\xF0\x9D\x84\x9E\"", "[\"\xF0\x9D\x84\"]", "\"\xED\xA0\x80\"", "\"\xE2\x82\xAC\xAC\"", "\"\xE2\x82"
+    };
+    lept_handler h = {
+        sax_null, sax_boolean, sax_number, sax_integer, NULL, sax_string,
+        sax_start_object, sax_key, sax_end_object, sax_start_array, sax_end_array
+    };
+    sax_recorder r;
+    lept_push p;
+    lept_value v;
+    size_t i;
+    for (i = 0; i < sizeof(texts) / sizeof(texts[0]); i++)
+        test_push_splits(texts[i]);
+
+    /* the root is ready once its last byte is seen, a number needs the next byte or the end */
+    lept_push_init(&p, NULL, NULL);
+    EXPECT_EQ_INT(LEPT_PARSE_INCOMPLETE, lept_feed(&p, "[ 1", 3));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_feed(&p, "]", 1));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_feed(&p, " \n", 2));
+    lept_init(&v);
+    lept_push_get_value(&p, &v);
+    EXPECT_EQ_SIZE_T(1, lept_get_array_size(&v));
+    lept_free(&v);
+    lept_push_free(&p);
+    lept_push_init(&p, NULL, NULL);
+    EXPECT_EQ_INT(LEPT_PARSE_INCOMPLETE, lept_feed(&p, "12", 2));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_feed(&p, NULL, 0));
+    lept_init(&v);
+    lept_push_get_value(&p, &v);
+    EXPECT_TRUE(lept_get_integer(&v) == 12);
+    lept_push_free(&p);
+
+    /* errors are sticky */
+    lept_push_init(&p, NULL, NULL);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_feed(&p, "{}", 2));
+    EXPECT_EQ_INT(LEPT_PARSE_ROOT_NOT_SINGULAR, lept_feed(&p, " {", 2));
+    EXPECT_EQ_INT(LEPT_PARSE_ROOT_NOT_SINGULAR, lept_feed(&p, NULL, 0));
+    lept_push_free(&p);
+
+    /* events are delivered as the input arrives, strings whole */
+    r.len = 0;
+    r.stop_at = -1;
+    lept_push_init(&p, &h, &r);
+    EXPECT_EQ_INT(LEPT_PARSE_INCOMPLETE, lept_feed(&p, "{\"k", 3));
+    EXPECT_EQ_STRING("{ ", r.trace, r.len);
+    EXPECT_EQ_INT(LEPT_PARSE_INCOMPLETE, lept_feed(&p, "\\u0065y\":[\"a", 12));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_feed(&p, "b\",-3]}", 7));
+    EXPECT_EQ_STRING("{ k:key [ s:ab i-3 ]2 }1 ", r.trace, r.len);
+    lept_push_free(&p);
+}
+
+typedef struct {
+    size_t count, line[8];
+    int ret[8], type[8], in_order;
+    int64_t last;
+    size_t stop_at;
+}ndjson_recorder;
+
+static int ndjson_record(void* user, size_t line, int ret, lept_value* v) {
+    ndjson_recorder* r = (ndjson_recorder*)user;
+    if (r->count < 8) {
+        r->line[r->count] = line;
+        r->ret[r->count] = ret;
+        r->type[r->count] = lept_get_type(v);
+    }
+    else if (lept_get_integer(lept_get_array_element(v, 0)) != ++r->last)
+        r->in_order = 0;
+    return ++r->count != r->stop_at;
+}
+
+static void test_parse_ndjson() {
+    static const char json[] = "{\"a\":1}\n\n[1,2]\r\n  \nx\n\"s\"";
+    ndjson_recorder r;
+    char* big, * p;
+    size_t i, n = 100000;
+    unsigned threads;
+    for (threads = 0; threads <= 4; threads += 4) {
+        memset(&r, 0, sizeof(r));
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_ndjson(json, sizeof(json) - 1, threads, ndjson_record, &r));
+        EXPECT_EQ_SIZE_T(4, r.count);
+        EXPECT_EQ_SIZE_T(1, r.line[0]);
+        EXPECT_EQ_INT(LEPT_OBJECT, r.type[0]);
+        EXPECT_EQ_SIZE_T(3, r.line[1]);
+        EXPECT_EQ_INT(LEPT_ARRAY, r.type[1]);
+        EXPECT_EQ_SIZE_T(5, r.line[2]);
+        EXPECT_EQ_INT(LEPT_PARSE_INVALID_VALUE, r.ret[2]);
+        EXPECT_EQ_SIZE_T(6, r.line[3]);
+        EXPECT_EQ_INT(LEPT_STRING, r.type[3]);
+
+        memset(&r, 0, sizeof(r));
+        r.stop_at = 2;
+        EXPECT_EQ_INT(LEPT_PARSE_STOPPED, lept_parse_ndjson(json, sizeof(json) - 1, threads, ndjson_record, &r));
+        EXPECT_EQ_SIZE_T(2, r.count);
+    }
+
+    /* many batches come back in input order */
+    p = big = (char*)malloc(n * 16);
+    for (i = 0; i < n; i++)
+        p += sprintf(p, "[%d]\n", (int)i - 7);
+    for (threads = 1; threads <= 8; threads *= 2) {
+        memset(&r, 0, sizeof(r));
+        r.in_order = 1;
+        r.last = 0;
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_ndjson(big, (size_t)(p - big), threads, ndjson_record, &r));
+        EXPECT_EQ_SIZE_T(n, r.count);
+        EXPECT_TRUE(r.in_order);
+    }
+    free(big);
+
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_ndjson("", 0, 4, ndjson_record, &r));
+}
+
+static void test_parse_parallel() {
+    static const char* const small[] = { "[1, 2]", "{\"a\":[1,2]}", " 12 ", "[", "[1,,2]" };
+    lept_value expect, v;
+    char* json, * p;
+    size_t i, n = 20000, len;
+    unsigned threads;
+    int ret;
+
+    /* elements whose strings hold delimiters, escaped quotes and brackets */
+    p = json = (char*)malloc(n * 64);
+    p += sprintf(p, " [ ");
+    for (i = 0; i < n; i++)
+        p += sprintf(p, i % 3 == 0 ? "{\"k\":\"a,]\\\"[\",\"n\":[%d,{}]}, " : i % 3 == 1 ? "\"}\\\\\", " : "%d,", (int)i);
+    p += sprintf(p, "null ]\n");
+    len = (size_t)(p - json);
+    lept_init(&expect);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_n(&expect, json, len));
+    for (threads = 1; threads <= 8; threads *= 2) {
+        lept_init(&v);
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_parallel(&v, json, len, threads));
+        EXPECT_EQ_SIZE_T(n + 1, lept_get_array_size(&v));
+        EXPECT_TRUE(lept_is_equal(&expect, &v));
+        lept_free(&v);
+    }
+    lept_free(&expect);
+
+    /* errors are those of lept_parse_n(), wherever they are */
+    for (i = 1; i < 4; i++) {
+        char ch = json[len * i / 4];
+        json[len * i / 4] = 'x';
+        lept_init(&expect);
+        lept_init(&v);
+        ret = lept_parse_n(&expect, json, len);
+        EXPECT_EQ_INT(ret, lept_parse_parallel(&v, json, len, 4));
+        EXPECT_TRUE(lept_is_equal(&expect, &v));
+        lept_free(&expect);
+        lept_free(&v);
+        json[len * i / 4] = ch;
+    }
+    json[len - 1] = ',';
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_ROOT_NOT_SINGULAR, lept_parse_parallel(&v, json, len, 4));
+    free(json);
+
+    /* cut off after a comma, long enough to be split, and nothing read past the end */
+    len = 1 + 8 * n;
+    p = json = (char*)malloc(len);
+    for (*p++ = '['; p < json + len; p += 4)
+        memcpy(p, "123,", 4);
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_EXPECT_VALUE, lept_parse_parallel(&v, json, len, 4));
+    free(json);
+
+    for (i = 0; i < sizeof(small) / sizeof(small[0]); i++) {
+        lept_init(&expect);
+        lept_init(&v);
+        ret = lept_parse(&expect, small[i]);
+        EXPECT_EQ_INT(ret, lept_parse_parallel(&v, small[i], strlen(small[i]), 4));
+        EXPECT_TRUE(lept_is_equal(&expect, &v));
+        lept_free(&expect);
+        lept_free(&v);
+    }
+}
+
+static void test_parse_file() {
+    static const char path[] = "test_parse_file.json";
+    static const char json[] = " { \"a\" : [ \"xyz\" , 1 ] } ";
+    lept_file f;
+    lept_value v;
+    const char* s;
+    FILE* fp = fopen(path, "wb");
+    fwrite(json, 1, sizeof(json) - 1, fp);
+    fclose(fp);
+
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_file(&v, path, LEPT_PARSE_ZERO_COPY_FLAG));
+    EXPECT_EQ_STRING("xyz", lept_get_string(lept_get_array_element(lept_find_object_value(&v, "a", 1), 0)), 3);
+    lept_free(&v);
+
+    /* zero-copy strings point into the mapping */
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_file_map(&f, path));
+    EXPECT_EQ_SIZE_T(sizeof(json) - 1, f.len);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_ex(&v, f.json, f.len, LEPT_PARSE_ZERO_COPY_FLAG));
+    s = lept_get_string(lept_get_array_element(lept_find_object_value(&v, "a", 1), 0));
+    EXPECT_TRUE(s >= f.json && s < f.json + f.len);
+    lept_free(&v);
+    lept_file_unmap(&f);
+
+    fp = fopen(path, "wb");
+    fclose(fp);
+    EXPECT_EQ_INT(LEPT_PARSE_EXPECT_VALUE, lept_parse_file(&v, path, 0));
+    remove(path);
+    EXPECT_EQ_INT(LEPT_PARSE_FILE_ERROR, lept_parse_file(&v, path, 0));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+}
+
+static void test_parse_document() {
+    static const char json[] =
+        "[{\"id\":1,\"name\":\"x\",\"a\":0},{\"id\":2,\"name\":\"y\"},{\"n\\u0061me\":\"z\",\"id\":3,\"a\\u0000c\":0}]";
+    static const char bad[] = "[{\"a\":\"a string too long to be kept in place\"]";
+    static const unsigned flags[] = { 0, LEPT_PARSE_STRUCTURAL_FLAG, LEPT_PARSE_ZERO_COPY_FLAG };
+    lept_document d;
+    lept_value v, * a;
+    size_t i, len;
+    char* big = (char*)malloc(100 * 3000), * p = big;
+    *p++ = '[';
+    for (i = 0; i < 3000; i++)
+        p += sprintf(p, "{\"key%d\":\"a string too long to be kept in place, %d\",\"n\":[%d,[]]},", (int)i % 7, (int)i, (int)i);
+    p[-1] = ']';
+    len = (size_t)(p - big);
+
+    lept_document_init(&d);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_document_parse(&d, json, sizeof(json) - 1, 0));
+    test_shared_keys(&d.root);
+    for (i = 0; i < sizeof(flags) / sizeof(flags[0]); i++) {
+        lept_init(&v);
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_ex(&v, big, len, flags[i]));
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_document_parse(&d, big, len, flags[i]));
+        EXPECT_TRUE(lept_is_equal(&v, &d.root));
+        lept_free(&v);
+    }
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, lept_document_parse(&d, bad, sizeof(bad) - 1, 0));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&d.root));
+
+    /* changes give values storage of their own, which lept_free() releases */
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_document_parse(&d, big, len, LEPT_PARSE_STRUCTURAL_FLAG));
+    a = lept_find_object_value(lept_get_array_element(&d.root, 1), "n", 1);
+    lept_set_string(lept_pushback_array_element(a), "a string too long to be kept in place", 37);
+    lept_shrink_array(a);
+    EXPECT_EQ_SIZE_T(3, lept_get_array_size(a));
+    EXPECT_EQ_STRING("a string too long to be kept in place", lept_get_string(lept_get_array_element(a, 2)), 37);
+    lept_set_string(lept_get_array_element(a, 0), "abc", 3);
+    lept_free(a);
+    lept_document_free(&d);
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&d.root));
+    lept_document_free(&d);
+    free(big);
+}
+
+/* depth containers, arrays and objects in turn, around a 0 */
+static char* deep_json(size_t depth, size_t* len) {
+    char* json = (char*)malloc(7 * depth + 2), * p = json;
+    size_t i;
+    for (i = 0; i < depth; i++)
+        p += sprintf(p, i % 2 ? "{\"k\":" : "[");
+    *p++ = '0';
+    while (i-- > 0)
+        *p++ = i % 2 ? '}' : ']';
+    *p = '\0';
+    *len = (size_t)(p - json);
+    return json;
+}
+
+static void test_parse_too_deep() {
+    static const lept_handler h = { NULL };
+    size_t depth, len, i;
+    char* json, * s;
+    lept_value v, * e;
+    lept_tape t;
+    lept_push p;
+    for (depth = LEPT_PARSE_MAX_DEPTH; depth <= LEPT_PARSE_MAX_DEPTH + 1; depth++) {
+        int expect = depth > LEPT_PARSE_MAX_DEPTH ? LEPT_PARSE_TOO_DEEP : LEPT_PARSE_OK;
+        json = deep_json(depth, &len);
+        lept_init(&v);
+        EXPECT_EQ_INT(expect, lept_parse_n(&v, json, len));
+        if (expect == LEPT_PARSE_OK) {
+            s = lept_stringify(&v, NULL);
+            EXPECT_TRUE(strcmp(json, s) == 0);
+            free(s);
+        }
+        lept_free(&v);
+        EXPECT_EQ_INT(expect, lept_parse_ex(&v, json, len, LEPT_PARSE_STRUCTURAL_FLAG));
+        lept_free(&v);
+        EXPECT_EQ_INT(expect, lept_parse_parallel(&v, json, len, 2));
+        lept_free(&v);
+        EXPECT_EQ_INT(expect, lept_parse_sax(json, len, &h, NULL));
+        EXPECT_EQ_INT(expect, lept_validate(json, len));
+        EXPECT_EQ_INT(expect, lept_parse_tape(&t, json, len));
+        if (expect == LEPT_PARSE_OK)
+            lept_tape_free(&t);
+        lept_push_init(&p, NULL, NULL);
+        EXPECT_EQ_INT(expect == LEPT_PARSE_OK ? LEPT_PARSE_INCOMPLETE : expect, lept_feed(&p, json, len - 1));
+        EXPECT_EQ_INT(expect, lept_feed(&p, json + len - 1, 1));
+        lept_push_free(&p);
+        free(json);
+    }
+
+    /* values built deeper than the parser allows are stringified and freed without recursion */
+    lept_init(&v);
+    for (i = 0, e = &v; i < 100000; i++) {
+        lept_set_array(e, 1);
+        e = lept_pushback_array_element(e);
+    }
+    s = lept_stringify(&v, &len);
+    EXPECT_EQ_SIZE_T(200004, len);
+    EXPECT_TRUE(s[99999] == '[' && s[100000] == 'n' && s[100004] == ']');
+    free(s);
+    lept_free(&v);
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+}
+
+static void test_validate() {
+    static const char* const texts[] = {
+        "null", " [ 1 , { \"a\" : [ true , false ] , \"b\" : \"\\u00e9\\uD834\\uDD1E\\n\" } , -0.5e-3 ] ", "{}", "[[]]",
+        "18446744073709551616", "1.7976931348623157e308", "1.7976931348623158e308", "-17976931348623158e292",
+        "0.00017976931348623158e312", "1797693134862315807937289714053034150799341327100378269361737789804449682927647"
+        "509466490179775872070963302864166928879109465555478519404026306574886715058206819089020007083836762738548458177115"
+        "31764475730270069855571366959622842914819860834936475292719074168444365510704342711559699508093042880177904174497791",
+        "1797693134862315807937289714053034150799341327100378269361737789804449682927647"
+        "509466490179775872070963302864166928879109465555478519404026306574886715058206819089020007083836762738548458177115"
+        "31764475730270069855571366959622842914819860834936475292719074168444365510704342711559699508093042880177904174497792",
+        "0e999999", "1e-999999", "{\"a\":1 \"b\":2}", "[1,,2]", "{\"a\"}", "[\"\\uDC00\"]"
+    };
+    lept_value v;
+    size_t i;
+    /* the result is that of lept_parse_n(), around the overflow threshold too */
+    for (i = 0; i < sizeof(texts) / sizeof(texts[0]); i++) {
+        lept_init(&v);
+        EXPECT_EQ_INT(lept_parse(&v, texts[i]), lept_validate(texts[i], strlen(texts[i])));
+        lept_free(&v);
+    }
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_validate("[1] x", 3));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, lept_validate("[1] x", 2));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_VALUE, lept_validate("[\0]", 3));
+}
+
+/* Sequences at every offset of the SIMD blocks, and through every engine */
+static void test_parse_utf8() {
+    static const char* const seqs[] = {
+        "\xC2\xA2", "\xDF\xBF", "\xE0\xA0\x80", "\xED\x9F\xBF", "\xEE\x80\x80", "\xF0\x90\x80\x80", "\xF4\x8F\xBF\xBF",
+        "\xC2", "\xE2\x82", "\xF0\x9D\x84", "\xC0\x80", "\xE0\x9F\xBF", "\xED\xA0\x80", "\xF4\x90\x80\x80", "\xBF", "\xF8\x88\x80\x80\x80"
+    };
+    static const lept_handler h = { NULL };
+    char json[160];
+    size_t i, k, len, root;
+    lept_value v;
+    lept_tape t;
+    lept_cursor cur;
+    for (i = 0; i < sizeof(seqs) / sizeof(seqs[0]); i++) {
+        int expect = i < 7 ? LEPT_PARSE_OK : LEPT_PARSE_INVALID_UTF8;
+        for (k = 0; k < 70; k++) {
+            json[0] = '[';
+            json[1] = '"';
+            memset(json + 2, 'a', k);
+            len = 2 + k + (size_t)sprintf(json + 2 + k, "%s%s\"]", seqs[i], "bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb");
+            lept_init(&v);
+            EXPECT_EQ_INT(expect, lept_parse_n(&v, json, len));
+            lept_free(&v);
+            EXPECT_EQ_INT(expect, lept_parse_ex(&v, json, len, LEPT_PARSE_STRUCTURAL_FLAG));
+            lept_free(&v);
+            EXPECT_EQ_INT(expect, lept_validate(json, len));
+            EXPECT_EQ_INT(expect, lept_parse_sax(json, len, &h, NULL));
+            EXPECT_EQ_INT(expect, lept_parse_tape(&t, json, len));
+            if (expect == LEPT_PARSE_OK)
+                lept_tape_free(&t);
+            lept_cursor_init(&cur, json, len);
+            EXPECT_EQ_INT(expect, expect == LEPT_PARSE_OK ? lept_cursor_enter(&cur, &root) : cur.error);
+            /* cut by the end of the input */
+            EXPECT_EQ_INT(i < 7 ? LEPT_PARSE_MISS_QUOTATION_MARK : expect, lept_validate(json + 1, k + 1 + strlen(seqs[i])));
+            /* the check can be turned off, the bytes are then copied as they are */
+            EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_ex(&v, json, len, LEPT_PARSE_NO_UTF8_CHECK_FLAG));
+            EXPECT_TRUE(memcmp(seqs[i], lept_get_string(lept_get_array_element(&v, 0)) + k, strlen(seqs[i])) == 0);
+            lept_free(&v);
+        }
+    }
+}
+
 int main() {
 #ifdef _WINDOWS
     _CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
@@ -718,6 +1968,19 @@ int main() {
     test_move();
     test_swap();
     test_access();
+    test_intern_keys();
+    test_cursor();
+    test_skip_value();
+    test_parse_paths();
+    test_parse_sax();
+    test_parse_push();
+    test_parse_ndjson();
+    test_parse_parallel();
+    test_parse_file();
+    test_parse_document();
+    test_parse_too_deep();
+    test_validate();
+    test_parse_utf8();
     printf("%d/%d (%3.2f%%) passed\n", test_pass, test_count, test_pass * 100.0 / test_count);
     return main_ret;
 }